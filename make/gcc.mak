@@ -35,3 +35,9 @@ endif
 ifdef PEDANTIC-LITE
 CFLAGS += -std=c89 -pedantic -Wall -Wno-unused-function -Wno-long-long
 endif
+
+## posix threads
+CFLAGS += -pthread
+
+## math library
+LIBM = -lm
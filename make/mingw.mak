@@ -35,3 +35,6 @@ endif
 ifdef PEDANTIC-LITE
 CFLAGS += -std=c89 -pedantic -Wall -Wno-unused-function -Wno-long-long
 endif
+
+## math library
+LIBM = -lm
@@ -0,0 +1,122 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexaa.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexaa.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* rex */
+#include "rexaa.h"
+
+/* draw the test scene */
+static void draw_scene(surface_t *s)
+{
+	/* variables */
+	aa_line_t lines[16];
+	real_t points[10];
+	int i;
+
+	/* a fan of lines from the top left */
+	for (i = 0; i < 16; i++)
+	{
+		aa_line(s, REAL(4.5f), REAL(4.5f), REAL(250.0f), REAL(4.0f + i * 16.0f),
+			pack_argb8888(255, 255, 255, 255), 0);
+	}
+
+	/* a batch of steep lines, with alpha */
+	for (i = 0; i < 16; i++)
+	{
+		lines[i].x1 = REAL(8.0f + i * 15.0f);
+		lines[i].y1 = REAL(250.0f);
+		lines[i].x2 = REAL(8.0f + i * 15.0f + i * 2.0f);
+		lines[i].y2 = REAL(130.0f);
+		lines[i].color = pack_argb8888(255, i * 16, 64, 128 + i * 8);
+	}
+
+	aa_lines(s, lines, 16, BLEND_SRGB);
+
+	/* circles, one partly outside the surface */
+	aa_circle(s, REAL(128.0f), REAL(128.0f), REAL(60.0f), pack_argb8888(0, 255, 0, 255), 0);
+	aa_circle(s, REAL(250.0f), REAL(250.0f), REAL(30.0f), pack_argb8888(0, 128, 255, 255), 0);
+
+	/* a closed pentagon */
+	for (i = 0; i < 5; i++)
+	{
+		points[i * 2 + 0] = REAL(128.0f + 40.0f * (float32)cos(i * 1.2566371f));
+		points[i * 2 + 1] = REAL(128.0f + 40.0f * (float32)sin(i * 1.2566371f));
+	}
+
+	aa_polyline(s, points, 5, 1, pack_argb8888(255, 255, 0, 255), 0);
+}
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	surface_t *s32, *s16;
+
+	/* create surfaces */
+	s32 = surface_create(256, 256, 32, NULL);
+	s16 = surface_create(256, 256, 16, NULL);
+
+	/* print header */
+	printf("librex: rexaa.h test\n");
+	printf("\n");
+
+	/* argb8888 */
+	draw_scene(s32);
+	printf("argb8888: %08x %08x\n",
+		((uint32_t *)s32->pixels)[68 * 256 + 128],
+		((uint32_t *)s32->pixels)[12 * 256 + 100]);
+	surface_dump_buffer(s32, "aa_argb8888.data");
+
+	/* rgb565 */
+	draw_scene(s16);
+	printf("rgb565: %04x %04x\n",
+		((uint16_t *)s16->pixels)[68 * 256 + 128],
+		((uint16_t *)s16->pixels)[12 * 256 + 100]);
+	surface_dump_buffer(s16, "aa_rgb565.data");
+
+	/* destroy surfaces */
+	surface_destroy(s32);
+	surface_destroy(s16);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
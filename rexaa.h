@@ -0,0 +1,414 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexaa.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: anti-aliased lines, circles and polygon edges
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_AA_H__
+#define __LIBREX_AA_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexmath.h"
+#include "rexfloat.h"
+#include "rexfixed.h"
+#include "rexreal.h"
+#include "rexcolor.h"
+#include "rexsurface.h"
+#include "rexblend.h"
+
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+/* one line of a batch. color is argb8888, alpha included */
+typedef struct aa_line_t
+{
+	real_t x1;
+	real_t y1;
+	real_t x2;
+	real_t y2;
+	uint32_t color;
+} aa_line_t;
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* lines */
+void aa_line(surface_t *dst, real_t x1, real_t y1, real_t x2, real_t y2,
+	uint32_t color, int flags);
+void aa_lines(surface_t *dst, aa_line_t *lines, int n, int flags);
+void aa_polyline(surface_t *dst, real_t *points, int n, int closed,
+	uint32_t color, int flags);
+
+/* curves */
+void aa_circle(surface_t *dst, real_t x, real_t y, real_t r, uint32_t color,
+	int flags);
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/*
+ * internal helpers
+ */
+
+/* drawing context shared by a batch */
+typedef struct aa_ctx_t
+{
+	surface_t *dst;
+	uint32_t color;
+	int alpha;
+	int flags;
+} aa_ctx_t;
+
+/* round 16.16 to the nearest whole number, still 16.16 */
+#define AA_ROUND(a) (((a) + 0x8000) & ~0xFFFF)
+
+/* blend the context color into x, y with coverage from 0 to 256 */
+static void aa_plot(aa_ctx_t *c, int x, int y, int coverage)
+{
+	/* variables */
+	int a;
+
+	if (x < c->dst->clip.x1 || x >= c->dst->clip.x2) return;
+	if (y < c->dst->clip.y1 || y >= c->dst->clip.y2) return;
+
+	a = (c->alpha * coverage) >> 8;
+	if (a <= 0) return;
+
+	if (c->dst->bpp == 32)
+		blend_pixel_argb8888((uint32_t *)SURFACE_PTR(c->dst, x, y), c->color, a, c->flags);
+	else
+		blend_pixel_rgb565((uint16_t *)SURFACE_PTR(c->dst, x, y), c->color, a, c->flags);
+}
+
+/* plot the two pixels straddling the minor coordinate m, 16.16 */
+static void aa_plot_pair(aa_ctx_t *c, int major, fix32 m, int steep,
+	int coverage)
+{
+	/* variables */
+	int i, f;
+
+	i = m >> 16;
+	f = (m & 0xFFFF) >> 8;
+
+	if (steep)
+	{
+		aa_plot(c, i, major, ((256 - f) * coverage) >> 8);
+		aa_plot(c, i + 1, major, (f * coverage) >> 8);
+	}
+	else
+	{
+		aa_plot(c, major, i, ((256 - f) * coverage) >> 8);
+		aa_plot(c, major, i + 1, (f * coverage) >> 8);
+	}
+}
+
+/*
+ * xiaolin wu's line in 16.16 fixed point, with pixel centers at .5. every
+ * step along the major axis splits full coverage between the two pixels
+ * around the line, and the end pixels are weighted by how much of them the
+ * line spans
+ */
+static void aa_wu(aa_ctx_t *c, fix32 x0, fix32 y0, fix32 x1, fix32 y1)
+{
+	/* variables */
+	fix32 t, dx, dy, grad, xend, yend, intery;
+	int steep, gap, x, xpx1, xpx2, lo, hi;
+
+	/* walk along the major axis, left to right */
+	steep = ABS(y1 - y0) > ABS(x1 - x0);
+
+	if (steep)
+	{
+		t = x0; x0 = y0; y0 = t;
+		t = x1; x1 = y1; y1 = t;
+	}
+
+	if (x0 > x1)
+	{
+		t = x0; x0 = x1; x1 = t;
+		t = y0; y0 = y1; y1 = t;
+	}
+
+	/* pixel centers on whole numbers */
+	x0 -= 0x8000;
+	y0 -= 0x8000;
+	x1 -= 0x8000;
+	y1 -= 0x8000;
+
+	dx = x1 - x0;
+	dy = y1 - y0;
+	grad = dx > 0 ? (fix32)((float32)dy / (float32)dx * 65536.0f) : 0;
+
+	/* shorter than a pixel, one pair weighted by length */
+	if (AA_ROUND(x0) == AA_ROUND(x1))
+	{
+		aa_plot_pair(c, AA_ROUND(x0) >> 16, y0 + dy / 2, steep,
+			MIN(dx, 0x10000) >> 8);
+		return;
+	}
+
+	/* first end */
+	xend = AA_ROUND(x0);
+	yend = y0 + ((grad * ((xend - x0) >> 1)) >> 15);
+	gap = (0x10000 - ((x0 + 0x8000) & 0xFFFF)) >> 8;
+	xpx1 = xend >> 16;
+	aa_plot_pair(c, xpx1, yend, steep, gap);
+	intery = yend + grad;
+
+	/* second end */
+	xend = AA_ROUND(x1);
+	yend = y1 + ((grad * ((xend - x1) >> 1)) >> 15);
+	gap = ((x1 + 0x8000) & 0xFFFF) >> 8;
+	xpx2 = xend >> 16;
+	aa_plot_pair(c, xpx2, yend, steep, gap);
+
+	/* the span in between, limited to the clip rectangle */
+	lo = steep ? c->dst->clip.y1 : c->dst->clip.x1;
+	hi = steep ? c->dst->clip.y2 : c->dst->clip.x2;
+
+	x = xpx1 + 1;
+	if (x < lo)
+	{
+		intery += (fix32)((float32)grad * (float32)(lo - x));
+		x = lo;
+	}
+
+	for (; x < xpx2 && x < hi; x++)
+	{
+		aa_plot_pair(c, x, intery, steep, 256);
+		intery += grad;
+	}
+}
+
+/* set up a context for color */
+static void aa_begin(aa_ctx_t *c, surface_t *dst, uint32_t color, int flags)
+{
+	c->dst = dst;
+	c->color = color;
+	c->alpha = (color >> 24) & 0xFF;
+	c->flags = flags;
+}
+
+/*
+ * lines
+ */
+
+/*
+ * draw an anti-aliased line on a 16 or 32 bpp surface. color is argb8888
+ * and its alpha is respected. flags takes BLEND_SRGB
+ */
+void aa_line(surface_t *dst, real_t x1, real_t y1, real_t x2, real_t y2,
+	uint32_t color, int flags)
+{
+	/* variables */
+	aa_line_t line;
+
+	line.x1 = x1;
+	line.y1 = y1;
+	line.x2 = x2;
+	line.y2 = y2;
+	line.color = color;
+
+	aa_lines(dst, &line, 1, flags);
+}
+
+/* draw n anti-aliased lines, each with its own color */
+void aa_lines(surface_t *dst, aa_line_t *lines, int n, int flags)
+{
+	/* variables */
+	aa_ctx_t c;
+	int i;
+
+	/* sanity checks */
+	if (!dst || !dst->pixels || !lines) return;
+	if (dst->bpp != 16 && dst->bpp != 32) return;
+	if (surface_clip_empty(dst)) return;
+	if (!surface_detach(dst)) return;
+
+	for (i = 0; i < n; i++)
+	{
+		aa_begin(&c, dst, lines[i].color, flags);
+		if (!c.alpha) continue;
+
+		aa_wu(&c,
+			(fix32)(REAL_TO_FLOAT32(lines[i].x1) * 65536.0f),
+			(fix32)(REAL_TO_FLOAT32(lines[i].y1) * 65536.0f),
+			(fix32)(REAL_TO_FLOAT32(lines[i].x2) * 65536.0f),
+			(fix32)(REAL_TO_FLOAT32(lines[i].y2) * 65536.0f));
+	}
+}
+
+/*
+ * draw the edges through n points, given as x, y pairs. closed joins the
+ * last point back to the first
+ */
+void aa_polyline(surface_t *dst, real_t *points, int n, int closed,
+	uint32_t color, int flags)
+{
+	/* variables */
+	aa_ctx_t c;
+	int i, j;
+
+	/* sanity checks */
+	if (!dst || !dst->pixels || !points || n < 2) return;
+	if (dst->bpp != 16 && dst->bpp != 32) return;
+	if (surface_clip_empty(dst)) return;
+	if (!surface_detach(dst)) return;
+
+	aa_begin(&c, dst, color, flags);
+	if (!c.alpha) return;
+
+	for (i = 0; i < (closed ? n : n - 1); i++)
+	{
+		j = (i + 1) % n;
+
+		aa_wu(&c,
+			(fix32)(REAL_TO_FLOAT32(points[i * 2 + 0]) * 65536.0f),
+			(fix32)(REAL_TO_FLOAT32(points[i * 2 + 1]) * 65536.0f),
+			(fix32)(REAL_TO_FLOAT32(points[j * 2 + 0]) * 65536.0f),
+			(fix32)(REAL_TO_FLOAT32(points[j * 2 + 1]) * 65536.0f));
+	}
+}
+
+/*
+ * curves
+ */
+
+/*
+ * draw an anti-aliased circle outline of radius r around x, y. columns
+ * cover the top and bottom octants, rows cover the sides
+ */
+void aa_circle(surface_t *dst, real_t x, real_t y, real_t r, uint32_t color,
+	int flags)
+{
+	/* variables */
+	aa_ctx_t c;
+	float32 cx, cy, fr, d, h, lim;
+	int i, i1, i2;
+
+	/* sanity checks */
+	if (!dst || !dst->pixels) return;
+	if (dst->bpp != 16 && dst->bpp != 32) return;
+	if (surface_clip_empty(dst)) return;
+	if (!surface_detach(dst)) return;
+
+	aa_begin(&c, dst, color, flags);
+	if (!c.alpha) return;
+
+	cx = REAL_TO_FLOAT32(x);
+	cy = REAL_TO_FLOAT32(y);
+	fr = REAL_TO_FLOAT32(r);
+	if (fr <= 0.0f) return;
+
+	/* the diagonals split the octants */
+	lim = fr * 0.70710678f;
+
+	/* columns, top and bottom. pixel centers are at .5 */
+	i1 = (int)ceil(cx - lim - 0.5f);
+	i2 = (int)floor(cx + lim - 0.5f);
+
+	for (i = i1; i <= i2; i++)
+	{
+		d = (float32)i + 0.5f - cx;
+		h = (float32)sqrt(fr * fr - d * d);
+
+		aa_plot_pair(&c, i, (fix32)((cy - h - 0.5f) * 65536.0f), 0, 256);
+		aa_plot_pair(&c, i, (fix32)((cy + h - 0.5f) * 65536.0f), 0, 256);
+	}
+
+	/* rows, left and right, stopping short of the diagonals */
+	i1 = (int)floor(cy - lim - 0.5f) + 1;
+	i2 = (int)ceil(cy + lim - 0.5f) - 1;
+
+	for (i = i1; i <= i2; i++)
+	{
+		d = (float32)i + 0.5f - cy;
+		if (d * d >= lim * lim) continue;
+
+		h = (float32)sqrt(fr * fr - d * d);
+
+		aa_plot_pair(&c, i, (fix32)((cx - h - 0.5f) * 65536.0f), 1, 256);
+		aa_plot_pair(&c, i, (fix32)((cx + h - 0.5f) * 65536.0f), 1, 256);
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_AA_H__ */
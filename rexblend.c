@@ -0,0 +1,106 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexblend.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexblend.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* rex */
+#include "rexblend.h"
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	surface_t *src, *dst, *half;
+	color_t white, black;
+	int x, y;
+
+	/* create surfaces */
+	src = surface_create(16, 16, 32, NULL);
+	dst = surface_create(16, 16, 32, NULL);
+	half = surface_create(8, 8, 32, NULL);
+
+	/* create colors */
+	color_set_argb8888(&white, 255, 255, 255, 255);
+	color_set_argb8888(&black, 0, 0, 0, 255);
+
+	/* print header */
+	printf("librex: rexblend.h test\n");
+	printf("\n");
+
+	/* 50% white over black */
+	surface_clear(src, &white);
+	surface_clear(dst, &black);
+	surface_blend(src, dst, 0, 0, 128, 0);
+	printf("gamma blend: %08x\n", ((uint32_t *)dst->pixels)[0]);
+
+	surface_clear(dst, &black);
+	surface_blend(src, dst, 0, 0, 128, BLEND_SRGB);
+	printf("srgb blend: %08x\n", ((uint32_t *)dst->pixels)[0]);
+
+	/* downsample a one pixel checkerboard */
+	for (y = 0; y < 16; y++)
+		for (x = 0; x < 16; x++)
+			((uint32_t *)src->pixels)[y * 16 + x] = ((x ^ y) & 1) ?
+				white.val.u32 : black.val.u32;
+
+	surface_downsample(src, half, 0);
+	printf("gamma downsample: %08x\n", ((uint32_t *)half->pixels)[0]);
+
+	surface_downsample(src, half, BLEND_SRGB);
+	printf("srgb downsample: %08x\n", ((uint32_t *)half->pixels)[0]);
+
+	/* blend the checkerboard over a gradient for a visual check */
+	for (y = 0; y < 16; y++)
+		for (x = 0; x < 16; x++)
+			((uint32_t *)dst->pixels)[y * 16 + x] =
+				pack_argb8888(x * 16, y * 16, 128, 255);
+
+	surface_blend(src, dst, 3, 5, 200, BLEND_SRGB);
+	surface_dump_buffer(dst, "blend.data");
+
+	/* destroy */
+	surface_destroy(src);
+	surface_destroy(dst);
+	surface_destroy(half);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
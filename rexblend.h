@@ -0,0 +1,971 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexblend.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: alpha blending in gamma and linear space
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_BLEND_H__
+#define __LIBREX_BLEND_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexmath.h"
+#include "rexcolor.h"
+#include "rexsurface.h"
+
+#endif
+
+/* simd */
+#ifdef LIBREX_SSE2
+#include <emmintrin.h>
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+/* blend flags */
+#define BLEND_SRGB 0x01
+
+/* blend modes */
+enum blend_mode
+{
+	BLEND_MODE_OVER,
+	BLEND_MODE_COPY,
+	BLEND_MODE_ADD,
+	BLEND_MODE_MULTIPLY,
+	BLEND_MODE_SCREEN
+};
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* span kernels */
+void blend_span_argb8888(uint32_t *dst, uint32_t *src, int n, int opacity,
+	int flags);
+void blend_span_mode_argb8888(uint32_t *dst, uint32_t *src, int n,
+	int opacity, int mode, int flags);
+
+/* pixel kernels */
+void blend_pixel_argb8888(uint32_t *dst, uint32_t color, int alpha,
+	int flags);
+void blend_pixel_rgb565(uint16_t *dst, uint32_t color, int alpha, int flags);
+
+/* surface operations */
+void surface_blend(surface_t *src, surface_t *dst, int dx, int dy,
+	int opacity, int flags);
+void surface_downsample(surface_t *src, surface_t *dst, int flags);
+
+/* *************************************
+ *
+ * the data
+ *
+ * ********************************** */
+
+/* 8-bit srgb to 16-bit linear */
+static const uint16_t blend_srgb_to_linear[256] =
+{
+	    0,    20,    40,    60,    80,    99,   119,   139,
+	  159,   179,   199,   219,   241,   264,   288,   313,
+	  340,   367,   396,   427,   458,   491,   526,   562,
+	  599,   637,   677,   718,   761,   805,   851,   898,
+	  947,   997,  1048,  1101,  1156,  1212,  1270,  1330,
+	 1391,  1453,  1517,  1583,  1651,  1720,  1790,  1863,
+	 1937,  2013,  2090,  2170,  2250,  2333,  2418,  2504,
+	 2592,  2681,  2773,  2866,  2961,  3058,  3157,  3258,
+	 3360,  3464,  3570,  3678,  3788,  3900,  4014,  4129,
+	 4247,  4366,  4488,  4611,  4736,  4864,  4993,  5124,
+	 5257,  5392,  5530,  5669,  5810,  5953,  6099,  6246,
+	 6395,  6547,  6700,  6856,  7014,  7174,  7335,  7500,
+	 7666,  7834,  8004,  8177,  8352,  8528,  8708,  8889,
+	 9072,  9258,  9445,  9635,  9828, 10022, 10219, 10417,
+	10619, 10822, 11028, 11235, 11446, 11658, 11873, 12090,
+	12309, 12530, 12754, 12980, 13209, 13440, 13673, 13909,
+	14146, 14387, 14629, 14874, 15122, 15371, 15623, 15878,
+	16135, 16394, 16656, 16920, 17187, 17456, 17727, 18001,
+	18277, 18556, 18837, 19121, 19407, 19696, 19987, 20281,
+	20577, 20876, 21177, 21481, 21787, 22096, 22407, 22721,
+	23038, 23357, 23678, 24002, 24329, 24658, 24990, 25325,
+	25662, 26001, 26344, 26688, 27036, 27386, 27739, 28094,
+	28452, 28813, 29176, 29542, 29911, 30282, 30656, 31033,
+	31412, 31794, 32179, 32567, 32957, 33350, 33745, 34143,
+	34544, 34948, 35355, 35764, 36176, 36591, 37008, 37429,
+	37852, 38278, 38706, 39138, 39572, 40009, 40449, 40891,
+	41337, 41785, 42236, 42690, 43147, 43606, 44069, 44534,
+	45002, 45473, 45947, 46423, 46903, 47385, 47871, 48359,
+	48850, 49344, 49841, 50341, 50844, 51349, 51858, 52369,
+	52884, 53401, 53921, 54445, 54971, 55500, 56032, 56567,
+	57105, 57646, 58190, 58737, 59287, 59840, 60396, 60955,
+	61517, 62082, 62650, 63221, 63795, 64372, 64952, 65535
+};
+
+/*
+ * 12-bit linear to 8-bit srgb. each bucket maps to the srgb value whose
+ * linear intensity is nearest to the bucket center, i * 16 + 8
+ */
+static const uint8_t blend_linear_to_srgb[4096] =
+{
+	  0,   1,   2,   3,   4,   4,   5,   6,   7,   8,   8,   9,  10,  11,  12,  12,
+	 13,  14,  14,  15,  16,  16,  17,  17,  18,  18,  19,  19,  20,  20,  21,  21,
+	 22,  22,  23,  23,  24,  24,  24,  25,  25,  26,  26,  26,  27,  27,  28,  28,
+	 28,  29,  29,  29,  30,  30,  30,  31,  31,  31,  32,  32,  32,  33,  33,  33,
+	 34,  34,  34,  35,  35,  35,  36,  36,  36,  36,  37,  37,  37,  37,  38,  38,
+	 38,  39,  39,  39,  39,  40,  40,  40,  40,  41,  41,  41,  41,  42,  42,  42,
+	 42,  43,  43,  43,  43,  44,  44,  44,  44,  45,  45,  45,  45,  45,  46,  46,
+	 46,  46,  47,  47,  47,  47,  47,  48,  48,  48,  48,  49,  49,  49,  49,  49,
+	 50,  50,  50,  50,  50,  51,  51,  51,  51,  51,  52,  52,  52,  52,  52,  53,
+	 53,  53,  53,  53,  54,  54,  54,  54,  54,  54,  55,  55,  55,  55,  55,  56,
+	 56,  56,  56,  56,  56,  57,  57,  57,  57,  57,  58,  58,  58,  58,  58,  58,
+	 59,  59,  59,  59,  59,  59,  60,  60,  60,  60,  60,  60,  61,  61,  61,  61,
+	 61,  61,  62,  62,  62,  62,  62,  62,  63,  63,  63,  63,  63,  63,  63,  64,
+	 64,  64,  64,  64,  64,  65,  65,  65,  65,  65,  65,  65,  66,  66,  66,  66,
+	 66,  66,  67,  67,  67,  67,  67,  67,  67,  68,  68,  68,  68,  68,  68,  68,
+	 69,  69,  69,  69,  69,  69,  69,  70,  70,  70,  70,  70,  70,  70,  71,  71,
+	 71,  71,  71,  71,  71,  71,  72,  72,  72,  72,  72,  72,  72,  73,  73,  73,
+	 73,  73,  73,  73,  73,  74,  74,  74,  74,  74,  74,  74,  75,  75,  75,  75,
+	 75,  75,  75,  75,  76,  76,  76,  76,  76,  76,  76,  76,  77,  77,  77,  77,
+	 77,  77,  77,  77,  78,  78,  78,  78,  78,  78,  78,  78,  79,  79,  79,  79,
+	 79,  79,  79,  79,  80,  80,  80,  80,  80,  80,  80,  80,  80,  81,  81,  81,
+	 81,  81,  81,  81,  81,  82,  82,  82,  82,  82,  82,  82,  82,  82,  83,  83,
+	 83,  83,  83,  83,  83,  83,  83,  84,  84,  84,  84,  84,  84,  84,  84,  84,
+	 85,  85,  85,  85,  85,  85,  85,  85,  85,  86,  86,  86,  86,  86,  86,  86,
+	 86,  86,  87,  87,  87,  87,  87,  87,  87,  87,  87,  88,  88,  88,  88,  88,
+	 88,  88,  88,  88,  89,  89,  89,  89,  89,  89,  89,  89,  89,  89,  90,  90,
+	 90,  90,  90,  90,  90,  90,  90,  90,  91,  91,  91,  91,  91,  91,  91,  91,
+	 91,  92,  92,  92,  92,  92,  92,  92,  92,  92,  92,  93,  93,  93,  93,  93,
+	 93,  93,  93,  93,  93,  94,  94,  94,  94,  94,  94,  94,  94,  94,  94,  94,
+	 95,  95,  95,  95,  95,  95,  95,  95,  95,  95,  96,  96,  96,  96,  96,  96,
+	 96,  96,  96,  96,  97,  97,  97,  97,  97,  97,  97,  97,  97,  97,  97,  98,
+	 98,  98,  98,  98,  98,  98,  98,  98,  98,  98,  99,  99,  99,  99,  99,  99,
+	 99,  99,  99,  99, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 101,
+	101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 102, 102, 102, 102, 102,
+	102, 102, 102, 102, 102, 102, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103,
+	103, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 105, 105, 105,
+	105, 105, 105, 105, 105, 105, 105, 105, 106, 106, 106, 106, 106, 106, 106, 106,
+	106, 106, 106, 106, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107,
+	108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 109, 109, 109, 109,
+	109, 109, 109, 109, 109, 109, 109, 109, 110, 110, 110, 110, 110, 110, 110, 110,
+	110, 110, 110, 110, 110, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111,
+	111, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 113, 113,
+	113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 114, 114, 114, 114, 114,
+	114, 114, 114, 114, 114, 114, 114, 114, 115, 115, 115, 115, 115, 115, 115, 115,
+	115, 115, 115, 115, 115, 116, 116, 116, 116, 116, 116, 116, 116, 116, 116, 116,
+	116, 116, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117, 118,
+	118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 119, 119, 119,
+	119, 119, 119, 119, 119, 119, 119, 119, 119, 119, 120, 120, 120, 120, 120, 120,
+	120, 120, 120, 120, 120, 120, 120, 120, 121, 121, 121, 121, 121, 121, 121, 121,
+	121, 121, 121, 121, 121, 121, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122,
+	122, 122, 122, 122, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123,
+	123, 123, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124,
+	124, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 126,
+	126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 127, 127,
+	127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 128, 128, 128,
+	128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 129, 129, 129, 129,
+	129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 130, 130, 130, 130, 130,
+	130, 130, 130, 130, 130, 130, 130, 130, 130, 130, 131, 131, 131, 131, 131, 131,
+	131, 131, 131, 131, 131, 131, 131, 131, 131, 132, 132, 132, 132, 132, 132, 132,
+	132, 132, 132, 132, 132, 132, 132, 132, 132, 133, 133, 133, 133, 133, 133, 133,
+	133, 133, 133, 133, 133, 133, 133, 133, 133, 134, 134, 134, 134, 134, 134, 134,
+	134, 134, 134, 134, 134, 134, 134, 134, 135, 135, 135, 135, 135, 135, 135, 135,
+	135, 135, 135, 135, 135, 135, 135, 135, 136, 136, 136, 136, 136, 136, 136, 136,
+	136, 136, 136, 136, 136, 136, 136, 136, 137, 137, 137, 137, 137, 137, 137, 137,
+	137, 137, 137, 137, 137, 137, 137, 137, 137, 138, 138, 138, 138, 138, 138, 138,
+	138, 138, 138, 138, 138, 138, 138, 138, 138, 139, 139, 139, 139, 139, 139, 139,
+	139, 139, 139, 139, 139, 139, 139, 139, 139, 139, 140, 140, 140, 140, 140, 140,
+	140, 140, 140, 140, 140, 140, 140, 140, 140, 140, 140, 141, 141, 141, 141, 141,
+	141, 141, 141, 141, 141, 141, 141, 141, 141, 141, 141, 142, 142, 142, 142, 142,
+	142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 143, 143, 143, 143,
+	143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 144, 144,
+	144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 145,
+	145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 145,
+	146, 146, 146, 146, 146, 146, 146, 146, 146, 146, 146, 146, 146, 146, 146, 146,
+	146, 146, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147,
+	147, 147, 147, 147, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148,
+	148, 148, 148, 148, 148, 148, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149,
+	149, 149, 149, 149, 149, 149, 149, 149, 150, 150, 150, 150, 150, 150, 150, 150,
+	150, 150, 150, 150, 150, 150, 150, 150, 150, 150, 151, 151, 151, 151, 151, 151,
+	151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 152, 152, 152,
+	152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 153,
+	153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153,
+	153, 153, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
+	154, 154, 154, 154, 154, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 156, 156, 156, 156, 156, 156, 156, 156,
+	156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 158,
+	158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158,
+	158, 158, 159, 159, 159, 159, 159, 159, 159, 159, 159, 159, 159, 159, 159, 159,
+	159, 159, 159, 159, 159, 159, 160, 160, 160, 160, 160, 160, 160, 160, 160, 160,
+	160, 160, 160, 160, 160, 160, 160, 160, 160, 160, 161, 161, 161, 161, 161, 161,
+	161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 162, 162,
+	162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162,
+	162, 162, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163,
+	163, 163, 163, 163, 163, 163, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164,
+	164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 165, 165, 165, 165, 165,
+	165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 166,
+	166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166,
+	166, 166, 166, 166, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167,
+	167, 167, 167, 167, 167, 167, 167, 167, 167, 168, 168, 168, 168, 168, 168, 168,
+	168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 169, 169,
+	169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169,
+	169, 169, 169, 169, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+	170, 170, 170, 170, 170, 170, 170, 170, 170, 171, 171, 171, 171, 171, 171, 171,
+	171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 172,
+	172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172,
+	172, 172, 172, 172, 172, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+	173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 174, 174, 174, 174, 174,
+	174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
+	174, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175,
+	175, 175, 175, 175, 175, 175, 175, 176, 176, 176, 176, 176, 176, 176, 176, 176,
+	176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 177, 177, 177,
+	177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177,
+	177, 177, 177, 177, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178,
+	178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 179, 179, 179, 179, 179,
+	179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179,
+	179, 179, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180,
+	180, 180, 180, 180, 180, 180, 180, 180, 180, 181, 181, 181, 181, 181, 181, 181,
+	181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181,
+	182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182,
+	182, 182, 182, 182, 182, 182, 182, 182, 183, 183, 183, 183, 183, 183, 183, 183,
+	183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 184,
+	184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184,
+	184, 184, 184, 184, 184, 184, 184, 185, 185, 185, 185, 185, 185, 185, 185, 185,
+	185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 186,
+	186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186,
+	186, 186, 186, 186, 186, 186, 186, 187, 187, 187, 187, 187, 187, 187, 187, 187,
+	187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187,
+	188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188,
+	188, 188, 188, 188, 188, 188, 188, 188, 189, 189, 189, 189, 189, 189, 189, 189,
+	189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189,
+	189, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190,
+	190, 190, 190, 190, 190, 190, 190, 190, 190, 191, 191, 191, 191, 191, 191, 191,
+	191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191,
+	191, 191, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192,
+	192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 193, 193, 193, 193,
+	193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193,
+	193, 193, 193, 193, 193, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194,
+	194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 195, 195,
+	195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195,
+	195, 195, 195, 195, 195, 195, 195, 195, 196, 196, 196, 196, 196, 196, 196, 196,
+	196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196,
+	196, 196, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197,
+	197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 198, 198, 198, 198,
+	198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198,
+	198, 198, 198, 198, 198, 198, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199,
+	199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199,
+	200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200,
+	200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 201, 201, 201, 201, 201,
+	201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201,
+	201, 201, 201, 201, 201, 201, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202,
+	202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202,
+	202, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203,
+	203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 204, 204, 204, 204,
+	204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
+	204, 204, 204, 204, 204, 204, 204, 205, 205, 205, 205, 205, 205, 205, 205, 205,
+	205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205,
+	205, 205, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206,
+	206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 207, 207,
+	207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207,
+	207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 208, 208, 208, 208, 208, 208,
+	208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208,
+	208, 208, 208, 208, 208, 208, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209,
+	209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209,
+	209, 209, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+	210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 211, 211,
+	211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211,
+	211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 212, 212, 212, 212, 212, 212,
+	212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212,
+	212, 212, 212, 212, 212, 212, 212, 213, 213, 213, 213, 213, 213, 213, 213, 213,
+	213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213,
+	213, 213, 213, 213, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214,
+	214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214,
+	214, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215,
+	215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 216, 216,
+	216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216,
+	216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 217, 217, 217, 217, 217,
+	217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217,
+	217, 217, 217, 217, 217, 217, 217, 217, 217, 218, 218, 218, 218, 218, 218, 218,
+	218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218,
+	218, 218, 218, 218, 218, 218, 218, 219, 219, 219, 219, 219, 219, 219, 219, 219,
+	219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219,
+	219, 219, 219, 219, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220,
+	220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220,
+	220, 220, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221,
+	221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221,
+	221, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222,
+	222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 223,
+	223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223,
+	223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 224, 224,
+	224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224,
+	224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 225, 225, 225,
+	225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225,
+	225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 226, 226, 226, 226, 226,
+	226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226,
+	226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 227, 227, 227, 227, 227,
+	227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227,
+	227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 228, 228, 228, 228, 228, 228,
+	228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228,
+	228, 228, 228, 228, 228, 228, 228, 228, 228, 229, 229, 229, 229, 229, 229, 229,
+	229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229,
+	229, 229, 229, 229, 229, 229, 229, 229, 229, 230, 230, 230, 230, 230, 230, 230,
+	230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230,
+	230, 230, 230, 230, 230, 230, 230, 230, 230, 231, 231, 231, 231, 231, 231, 231,
+	231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231,
+	231, 231, 231, 231, 231, 231, 231, 231, 231, 232, 232, 232, 232, 232, 232, 232,
+	232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232,
+	232, 232, 232, 232, 232, 232, 232, 232, 232, 233, 233, 233, 233, 233, 233, 233,
+	233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233,
+	233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 234, 234, 234, 234, 234, 234,
+	234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234,
+	234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 235, 235, 235, 235, 235, 235,
+	235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235,
+	235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 236, 236, 236, 236, 236,
+	236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236,
+	236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 237, 237, 237, 237,
+	237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237,
+	237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 238, 238, 238,
+	238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238,
+	238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 239,
+	239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239,
+	239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239,
+	240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+	240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+	240, 240, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241,
+	241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241,
+	241, 241, 241, 241, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242,
+	242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242,
+	242, 242, 242, 242, 242, 242, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243,
+	243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243,
+	243, 243, 243, 243, 243, 243, 243, 243, 244, 244, 244, 244, 244, 244, 244, 244,
+	244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244,
+	244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 245, 245, 245, 245, 245,
+	245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245,
+	245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 246, 246, 246,
+	246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246,
+	246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246,
+	247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247,
+	247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247,
+	247, 247, 247, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248,
+	248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248,
+	248, 248, 248, 248, 248, 248, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249,
+	249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249,
+	249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 250, 250, 250, 250, 250, 250,
+	250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250,
+	250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 251, 251, 251,
+	251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+	251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+	251, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252,
+	252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252,
+	252, 252, 252, 252, 252, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253,
+	253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253,
+	253, 253, 253, 253, 253, 253, 253, 253, 253, 254, 254, 254, 254, 254, 254, 254,
+	254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254,
+	254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+};
+
+/* runs of a table generated from an entry macro, see COLOR_TABLE256 */
+#define BLEND_TABLE256(M, i) \
+	COLOR_TABLE16(M, (i) + 0), COLOR_TABLE16(M, (i) + 16), \
+	COLOR_TABLE16(M, (i) + 32), COLOR_TABLE16(M, (i) + 48), \
+	COLOR_TABLE16(M, (i) + 64), COLOR_TABLE16(M, (i) + 80), \
+	COLOR_TABLE16(M, (i) + 96), COLOR_TABLE16(M, (i) + 112), \
+	COLOR_TABLE16(M, (i) + 128), COLOR_TABLE16(M, (i) + 144), \
+	COLOR_TABLE16(M, (i) + 160), COLOR_TABLE16(M, (i) + 176), \
+	COLOR_TABLE16(M, (i) + 192), COLOR_TABLE16(M, (i) + 208), \
+	COLOR_TABLE16(M, (i) + 224), COLOR_TABLE16(M, (i) + 240)
+#define BLEND_TABLE4096(M) \
+	BLEND_TABLE256(M, 0), BLEND_TABLE256(M, 256), BLEND_TABLE256(M, 512), \
+	BLEND_TABLE256(M, 768), BLEND_TABLE256(M, 1024), BLEND_TABLE256(M, 1280), \
+	BLEND_TABLE256(M, 1536), BLEND_TABLE256(M, 1792), BLEND_TABLE256(M, 2048), \
+	BLEND_TABLE256(M, 2304), BLEND_TABLE256(M, 2560), BLEND_TABLE256(M, 2816), \
+	BLEND_TABLE256(M, 3072), BLEND_TABLE256(M, 3328), BLEND_TABLE256(M, 3584), \
+	BLEND_TABLE256(M, 3840)
+
+/*
+ * the gamma space identity pair, 8-bit values widened to 16 bits and
+ * 12-bit linear narrowed back to 8 bits
+ */
+#define BLEND_GAMMA_WIDEN(i) ((i) * 257)
+#define BLEND_GAMMA_NARROW(i) ((i) >> 4)
+
+static const uint16_t blend_gamma_to_linear[256] =
+{
+	BLEND_TABLE256(BLEND_GAMMA_WIDEN, 0)
+};
+
+static const uint8_t blend_linear_to_gamma[4096] =
+{
+	BLEND_TABLE4096(BLEND_GAMMA_NARROW)
+};
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/*
+ * internal helpers
+ */
+
+/* x / 255 for x in 0 to 65025, rounded */
+#define BLEND_DIV255(x) ((((x) + 128) + (((x) + 128) >> 8)) >> 8)
+
+/*
+ * blend one channel in 16-bit linear space. both products are truncated
+ * separately so the scalar and simd paths match exactly
+ */
+#define BLEND_MIX(s, d, a16) \
+	((((uint32_t)(s) * (a16)) >> 16) + (((uint32_t)(d) * (65535 - (a16))) >> 16))
+
+/*
+ * span kernels
+ */
+
+/*
+ * blend n argb8888 pixels of src over dst, using src alpha scaled by
+ * opacity (0 to 255). with BLEND_SRGB the color channels are converted to
+ * linear light, blended and converted back
+ */
+void blend_span_argb8888(uint32_t *dst, uint32_t *src, int n, int opacity,
+	int flags)
+{
+	/* variables */
+	const uint16_t *fwd;
+	const uint8_t *inv;
+	uint32_t s, d, a, a16, r, g, b, al;
+	int x;
+
+	/* sanity checks */
+	if (!dst || !src || n < 1 || opacity <= 0) return;
+	if (opacity > 255) opacity = 255;
+
+	/* pick the transfer tables, the kernel is the same either way */
+	fwd = (flags & BLEND_SRGB) ? blend_srgb_to_linear : blend_gamma_to_linear;
+	inv = (flags & BLEND_SRGB) ? blend_linear_to_srgb : blend_linear_to_gamma;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	/*
+	 * gamma space is arithmetic all the way: widening is x * 257 and
+	 * narrowing is >> 8, so two pixels per register never leave it. srgb
+	 * needs a table read per channel both ways, which sse2 can't gather,
+	 * so the reads stay scalar and the alpha and mix run in registers
+	 */
+	if (!(flags & BLEND_SRGB))
+	{
+		/* variables */
+		__m128i z, ones, amask, op, r128, p, q, vs, vd, va, vo[2];
+		int i;
+
+		z = _mm_setzero_si128();
+		ones = _mm_set1_epi16((short)0xFFFF);
+		amask = _mm_set_epi16((short)0xFFFF, 0, 0, 0, (short)0xFFFF, 0, 0, 0);
+		op = _mm_set1_epi16((short)opacity);
+		r128 = _mm_set1_epi16(128);
+
+		for (; x + 4 <= n; x += 4)
+		{
+			p = _mm_loadu_si128((__m128i *)(src + x));
+			q = _mm_loadu_si128((__m128i *)(dst + x));
+
+			for (i = 0; i < 2; i++)
+			{
+				vs = i ? _mm_unpackhi_epi8(p, z) : _mm_unpacklo_epi8(p, z);
+				vd = i ? _mm_unpackhi_epi8(q, z) : _mm_unpacklo_epi8(q, z);
+
+				/* a = src alpha * opacity / 255, as BLEND_DIV255 */
+				va = _mm_add_epi16(_mm_mullo_epi16(vs, op), r128);
+				va = _mm_srli_epi16(_mm_add_epi16(va, _mm_srli_epi16(va, 8)), 8);
+				va = _mm_shufflehi_epi16(_mm_shufflelo_epi16(va, 0xFF), 0xFF);
+				va = _mm_or_si128(va, _mm_slli_epi16(va, 8));
+
+				/* widen to 16 bits, with src alpha mixed as 65535 */
+				vs = _mm_or_si128(_mm_or_si128(vs, _mm_slli_epi16(vs, 8)), amask);
+				vd = _mm_or_si128(vd, _mm_slli_epi16(vd, 8));
+
+				/* BLEND_MIX, both products truncated separately */
+				vo[i] = _mm_srli_epi16(_mm_add_epi16(_mm_mulhi_epu16(vs, va),
+					_mm_mulhi_epu16(vd, _mm_xor_si128(va, ones))), 8);
+			}
+
+			_mm_storeu_si128((__m128i *)(dst + x), _mm_packus_epi16(vo[0], vo[1]));
+		}
+	}
+	else
+	{
+		/* variables */
+		__m128i z, ones, op, r128, p, vs, vd, va;
+		uint32_t s1, d1;
+
+		z = _mm_setzero_si128();
+		ones = _mm_set1_epi16((short)0xFFFF);
+		op = _mm_set1_epi16((short)opacity);
+		r128 = _mm_set1_epi16(128);
+
+		for (; x + 2 <= n; x += 2)
+		{
+			s = src[x];
+			s1 = src[x + 1];
+			d = dst[x];
+			d1 = dst[x + 1];
+
+			/* the table reads, alpha rides along unconverted */
+			vs = _mm_set_epi16((short)0xFFFF, (short)fwd[(s1 >> 16) & 0xFF],
+				(short)fwd[(s1 >> 8) & 0xFF], (short)fwd[s1 & 0xFF],
+				(short)0xFFFF, (short)fwd[(s >> 16) & 0xFF],
+				(short)fwd[(s >> 8) & 0xFF], (short)fwd[s & 0xFF]);
+			vd = _mm_set_epi16((short)((d1 >> 24) * 257), (short)fwd[(d1 >> 16) & 0xFF],
+				(short)fwd[(d1 >> 8) & 0xFF], (short)fwd[d1 & 0xFF],
+				(short)((d >> 24) * 257), (short)fwd[(d >> 16) & 0xFF],
+				(short)fwd[(d >> 8) & 0xFF], (short)fwd[d & 0xFF]);
+
+			/* a = src alpha * opacity / 255, as BLEND_DIV255 */
+			p = _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)s), z);
+			p = _mm_unpacklo_epi64(p, _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)s1), z));
+			va = _mm_add_epi16(_mm_mullo_epi16(p, op), r128);
+			va = _mm_srli_epi16(_mm_add_epi16(va, _mm_srli_epi16(va, 8)), 8);
+			va = _mm_shufflehi_epi16(_mm_shufflelo_epi16(va, 0xFF), 0xFF);
+			va = _mm_or_si128(va, _mm_slli_epi16(va, 8));
+
+			/* BLEND_MIX, then 12-bit table indices */
+			p = _mm_srli_epi16(_mm_add_epi16(_mm_mulhi_epu16(vs, va),
+				_mm_mulhi_epu16(vd, _mm_xor_si128(va, ones))), 4);
+
+			dst[x] = ((uint32_t)(_mm_extract_epi16(p, 3) >> 4) << 24) |
+				((uint32_t)inv[_mm_extract_epi16(p, 2)] << 16) |
+				((uint32_t)inv[_mm_extract_epi16(p, 1)] << 8) |
+				(uint32_t)inv[_mm_extract_epi16(p, 0)];
+			dst[x + 1] = ((uint32_t)(_mm_extract_epi16(p, 7) >> 4) << 24) |
+				((uint32_t)inv[_mm_extract_epi16(p, 6)] << 16) |
+				((uint32_t)inv[_mm_extract_epi16(p, 5)] << 8) |
+				(uint32_t)inv[_mm_extract_epi16(p, 4)];
+		}
+	}
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < n; x++)
+	{
+		s = src[x];
+		d = dst[x];
+		a = BLEND_DIV255(((s >> 24) & 0xFF) * (uint32_t)opacity);
+		a16 = a * 257;
+
+		r = BLEND_MIX(fwd[(s >> 16) & 0xFF], fwd[(d >> 16) & 0xFF], a16);
+		g = BLEND_MIX(fwd[(s >> 8) & 0xFF], fwd[(d >> 8) & 0xFF], a16);
+		b = BLEND_MIX(fwd[s & 0xFF], fwd[d & 0xFF], a16);
+		al = BLEND_MIX(65535, ((d >> 24) & 0xFF) * 257, a16);
+
+		dst[x] = ((al >> 8) << 24) | ((uint32_t)inv[r >> 4] << 16) |
+			((uint32_t)inv[g >> 4] << 8) | (uint32_t)inv[b >> 4];
+	}
+}
+
+/*
+ * blend n argb8888 pixels of src into dst with a blend mode. over is
+ * blend_span_argb8888. copy mixes all four channels towards src by opacity
+ * alone, so at 255 it is a plain copy. add, multiply and screen combine src
+ * with dst first, then mix the result over dst by src alpha and opacity
+ * like over does
+ */
+void blend_span_mode_argb8888(uint32_t *dst, uint32_t *src, int n,
+	int opacity, int mode, int flags)
+{
+	/* variables */
+	const uint16_t *fwd;
+	const uint8_t *inv;
+	uint32_t s, d, a, a16, c[3], sl, dl, t, al;
+	int i, x;
+
+	/* sanity checks */
+	if (!dst || !src || n < 1 || opacity <= 0) return;
+	if (opacity > 255) opacity = 255;
+
+	switch (mode)
+	{
+		case BLEND_MODE_OVER:
+			blend_span_argb8888(dst, src, n, opacity, flags);
+			return;
+
+		case BLEND_MODE_COPY:
+			if (opacity == 255)
+			{
+				memcpy(dst, src, n * sizeof(uint32_t));
+				return;
+			}
+			break;
+
+		case BLEND_MODE_ADD:
+		case BLEND_MODE_MULTIPLY:
+		case BLEND_MODE_SCREEN:
+			break;
+
+		default:
+			return;
+	}
+
+	fwd = (flags & BLEND_SRGB) ? blend_srgb_to_linear : blend_gamma_to_linear;
+	inv = (flags & BLEND_SRGB) ? blend_linear_to_srgb : blend_linear_to_gamma;
+
+	for (x = 0; x < n; x++)
+	{
+		s = src[x];
+		d = dst[x];
+
+		if (mode == BLEND_MODE_COPY)
+			a = (uint32_t)opacity;
+		else
+			a = BLEND_DIV255(((s >> 24) & 0xFF) * (uint32_t)opacity);
+
+		a16 = a * 257;
+
+		/* channels b, g, r */
+		for (i = 0; i < 3; i++)
+		{
+			sl = fwd[(s >> (i * 8)) & 0xFF];
+			dl = fwd[(d >> (i * 8)) & 0xFF];
+
+			switch (mode)
+			{
+				case BLEND_MODE_ADD:
+					t = MIN(sl + dl, 65535);
+					break;
+
+				case BLEND_MODE_MULTIPLY:
+					t = (sl * dl) >> 16;
+					break;
+
+				case BLEND_MODE_SCREEN:
+					t = sl + dl - ((sl * dl) >> 16);
+					break;
+
+				default:
+					t = sl;
+					break;
+			}
+
+			c[i] = BLEND_MIX(t, dl, a16);
+		}
+
+		/* copy moves alpha towards the src alpha, the rest towards opaque */
+		t = mode == BLEND_MODE_COPY ? ((s >> 24) & 0xFF) * 257 : 65535;
+		al = BLEND_MIX(t, ((d >> 24) & 0xFF) * 257, a16);
+
+		dst[x] = ((al >> 8) << 24) | ((uint32_t)inv[c[2] >> 4] << 16) |
+			((uint32_t)inv[c[1] >> 4] << 8) | (uint32_t)inv[c[0] >> 4];
+	}
+}
+
+/*
+ * pixel kernels
+ */
+
+/*
+ * blend an argb8888 color over one argb8888 pixel at alpha (0 to 255),
+ * which replaces the alpha of the color. used for coverage based drawing
+ */
+void blend_pixel_argb8888(uint32_t *dst, uint32_t color, int alpha,
+	int flags)
+{
+	/* variables */
+	const uint16_t *fwd;
+	const uint8_t *inv;
+	uint32_t d, a16, r, g, b, al;
+
+	/* sanity checks */
+	if (!dst || alpha <= 0) return;
+	if (alpha > 255) alpha = 255;
+
+	fwd = (flags & BLEND_SRGB) ? blend_srgb_to_linear : blend_gamma_to_linear;
+	inv = (flags & BLEND_SRGB) ? blend_linear_to_srgb : blend_linear_to_gamma;
+
+	d = *dst;
+	a16 = (uint32_t)alpha * 257;
+
+	r = BLEND_MIX(fwd[(color >> 16) & 0xFF], fwd[(d >> 16) & 0xFF], a16);
+	g = BLEND_MIX(fwd[(color >> 8) & 0xFF], fwd[(d >> 8) & 0xFF], a16);
+	b = BLEND_MIX(fwd[color & 0xFF], fwd[d & 0xFF], a16);
+	al = BLEND_MIX(65535, ((d >> 24) & 0xFF) * 257, a16);
+
+	*dst = ((al >> 8) << 24) | ((uint32_t)inv[r >> 4] << 16) |
+		((uint32_t)inv[g >> 4] << 8) | (uint32_t)inv[b >> 4];
+}
+
+/* same as blend_pixel_argb8888, over an rgb565 pixel */
+void blend_pixel_rgb565(uint16_t *dst, uint32_t color, int alpha, int flags)
+{
+	/* variables */
+	const uint16_t *fwd;
+	const uint8_t *inv;
+	uint32_t d, a16, r, g, b, dr, dg, db;
+
+	/* sanity checks */
+	if (!dst || alpha <= 0) return;
+	if (alpha > 255) alpha = 255;
+
+	fwd = (flags & BLEND_SRGB) ? blend_srgb_to_linear : blend_gamma_to_linear;
+	inv = (flags & BLEND_SRGB) ? blend_linear_to_srgb : blend_linear_to_gamma;
+
+	/* expand dst to 8 bits per channel */
+	d = *dst;
+	dr = color_expand5[(d >> 11) & 0x1F];
+	dg = color_expand6[(d >> 5) & 0x3F];
+	db = color_expand5[d & 0x1F];
+
+	a16 = (uint32_t)alpha * 257;
+
+	r = inv[BLEND_MIX(fwd[(color >> 16) & 0xFF], fwd[dr], a16) >> 4];
+	g = inv[BLEND_MIX(fwd[(color >> 8) & 0xFF], fwd[dg], a16) >> 4];
+	b = inv[BLEND_MIX(fwd[color & 0xFF], fwd[db], a16) >> 4];
+
+	*dst = (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+/*
+ * surface operations
+ */
+
+/* blend a 32 bpp src over a 32 bpp dst at dx, dy, within the clip rectangle */
+void surface_blend(surface_t *src, surface_t *dst, int dx, int dy,
+	int opacity, int flags)
+{
+	/* variables */
+	int y, sx, sy, w, h;
+
+	/* sanity checks */
+	if (!src || !src->pixels || !dst || !dst->pixels) return;
+	if (src->bpp != 32 || dst->bpp != 32) return;
+
+	/* clip */
+	sx = MAX(dst->clip.x1 - dx, 0);
+	sy = MAX(dst->clip.y1 - dy, 0);
+	w = MIN(src->w, dst->clip.x2 - dx) - sx;
+	h = MIN(src->h, dst->clip.y2 - dy) - sy;
+
+	/* fully clipped */
+	if (w < 1 || h < 1) return;
+	if (!surface_detach(dst)) return;
+
+	for (y = 0; y < h; y++)
+	{
+		blend_span_argb8888(
+			(uint32_t *)SURFACE_PTR(dst, dx + sx, dy + sy + y),
+			(uint32_t *)SURFACE_PTR(src, sx, sy + y),
+			w, opacity, flags);
+	}
+}
+
+/*
+ * halve a 32 bpp surface into dst with a 2x2 box filter. with BLEND_SRGB
+ * the average is taken in linear light, so detail doesn't darken
+ */
+void surface_downsample(surface_t *src, surface_t *dst, int flags)
+{
+	/* variables */
+	const uint16_t *fwd;
+	const uint8_t *inv;
+	uint32_t *s0, *s1, *d, p[4];
+	uint32_t r, g, b, a;
+	int x, y, x0, x1, i;
+
+	/* sanity checks */
+	if (!src || !src->pixels || !dst || !dst->pixels) return;
+	if (src->bpp != 32 || dst->bpp != 32) return;
+	if (dst->w != MAX(src->w / 2, 1) || dst->h != MAX(src->h / 2, 1)) return;
+	if (!surface_detach(dst)) return;
+
+	fwd = (flags & BLEND_SRGB) ? blend_srgb_to_linear : blend_gamma_to_linear;
+	inv = (flags & BLEND_SRGB) ? blend_linear_to_srgb : blend_linear_to_gamma;
+
+	for (y = 0; y < dst->h; y++)
+	{
+		s0 = (uint32_t *)SURFACE_PTR(src, 0, y * 2);
+		s1 = (uint32_t *)SURFACE_PTR(src, 0, MIN(y * 2 + 1, src->h - 1));
+		d = (uint32_t *)SURFACE_PTR(dst, 0, y);
+
+		/* start */
+		x = 0;
+
+#ifdef LIBREX_SSE2
+		/*
+		 * gamma space: with S the sum of four bytes, the table round trip
+		 * ((S * 257 + 2) >> 2) >> 8 is (S + ((S + 2) >> 8)) >> 2, which fits
+		 * in 16-bit lanes. four output pixels per pass
+		 */
+		if (!(flags & BLEND_SRGB))
+		{
+			/* variables */
+			__m128i z, two, amask, p, q, lo, hi, v[2];
+			int i;
+
+			z = _mm_setzero_si128();
+			two = _mm_set1_epi16(2);
+			amask = _mm_set_epi16((short)0xFFFF, 0, 0, 0, (short)0xFFFF, 0, 0, 0);
+
+			for (; x + 4 <= dst->w; x += 4)
+			{
+				for (i = 0; i < 2; i++)
+				{
+					p = _mm_loadu_si128((__m128i *)(s0 + x * 2 + i * 4));
+					q = _mm_loadu_si128((__m128i *)(s1 + x * 2 + i * 4));
+
+					/* vertical sums, then horizontal pairs */
+					lo = _mm_add_epi16(_mm_unpacklo_epi8(p, z), _mm_unpacklo_epi8(q, z));
+					hi = _mm_add_epi16(_mm_unpackhi_epi8(p, z), _mm_unpackhi_epi8(q, z));
+					p = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+
+					/* colors through the identity tables, alpha averaged */
+					q = _mm_add_epi16(p, two);
+					lo = _mm_srli_epi16(_mm_add_epi16(p, _mm_srli_epi16(q, 8)), 2);
+					hi = _mm_srli_epi16(q, 2);
+					v[i] = _mm_or_si128(_mm_andnot_si128(amask, lo), _mm_and_si128(amask, hi));
+				}
+
+				_mm_storeu_si128((__m128i *)(d + x), _mm_packus_epi16(v[0], v[1]));
+			}
+		}
+		else
+		{
+			/* variables */
+			__m128i ones, bias, p, q;
+			uint32_t a0, a1, a2, a3;
+
+			/*
+			 * srgb needs the tables, sse2 can't gather, so the reads stay
+			 * scalar. each channel's pair sits in adjacent lanes, biased by
+			 * 32768 so pmaddwd can add the unsigned pairs into 32 bits
+			 */
+			ones = _mm_set1_epi16(1);
+			bias = _mm_set1_epi16((short)0x8000);
+
+			for (; x < dst->w && x * 2 + 1 < src->w; x++)
+			{
+				a0 = s0[x * 2];
+				a1 = s0[x * 2 + 1];
+				a2 = s1[x * 2];
+				a3 = s1[x * 2 + 1];
+
+				p = _mm_set_epi16((short)(a1 >> 24), (short)(a0 >> 24),
+					(short)fwd[(a1 >> 16) & 0xFF], (short)fwd[(a0 >> 16) & 0xFF],
+					(short)fwd[(a1 >> 8) & 0xFF], (short)fwd[(a0 >> 8) & 0xFF],
+					(short)fwd[a1 & 0xFF], (short)fwd[a0 & 0xFF]);
+				q = _mm_set_epi16((short)(a3 >> 24), (short)(a2 >> 24),
+					(short)fwd[(a3 >> 16) & 0xFF], (short)fwd[(a2 >> 16) & 0xFF],
+					(short)fwd[(a3 >> 8) & 0xFF], (short)fwd[(a2 >> 8) & 0xFF],
+					(short)fwd[a3 & 0xFF], (short)fwd[a2 & 0xFF]);
+
+				/* the four sums, plus the bias back and the rounding 2 */
+				p = _mm_add_epi32(_mm_madd_epi16(_mm_xor_si128(p, bias), ones),
+					_mm_madd_epi16(_mm_xor_si128(q, bias), ones));
+				p = _mm_srli_epi32(_mm_add_epi32(p, _mm_set1_epi32(131074)), 2);
+
+				d[x] = ((uint32_t)_mm_extract_epi16(p, 6) << 24) |
+					((uint32_t)inv[_mm_extract_epi16(p, 4) >> 4] << 16) |
+					((uint32_t)inv[_mm_extract_epi16(p, 2) >> 4] << 8) |
+					(uint32_t)inv[_mm_extract_epi16(p, 0) >> 4];
+			}
+		}
+#endif
+
+		/* scalar path and leftovers */
+		for (; x < dst->w; x++)
+		{
+			x0 = x * 2;
+			x1 = MIN(x0 + 1, src->w - 1);
+
+			p[0] = s0[x0];
+			p[1] = s0[x1];
+			p[2] = s1[x0];
+			p[3] = s1[x1];
+
+			r = g = b = 2;
+			a = 2;
+			for (i = 0; i < 4; i++)
+			{
+				r += fwd[(p[i] >> 16) & 0xFF];
+				g += fwd[(p[i] >> 8) & 0xFF];
+				b += fwd[p[i] & 0xFF];
+				a += (p[i] >> 24) & 0xFF;
+			}
+
+			d[x] = ((a >> 2) << 24) | ((uint32_t)inv[(r >> 2) >> 4] << 16) |
+				((uint32_t)inv[(g >> 2) >> 4] << 8) | (uint32_t)inv[(b >> 2) >> 4];
+		}
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_BLEND_H__ */
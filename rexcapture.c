@@ -0,0 +1,96 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexcapture.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexcapture.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* rex */
+#include "rexcapture.h"
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	surface_t *frame;
+	capture_t *capture;
+	int x, y, i;
+
+	/* create surface and stream */
+	frame = surface_create(160, 120, 32, NULL);
+	capture = capture_open("rexcapture.y4m", frame->w, frame->h, 30, 4);
+
+	if (!capture)
+	{
+		printf("failed to open rexcapture.y4m\n");
+		return EXIT_FAILURE;
+	}
+
+	/* print header */
+	printf("librex: rexcapture.h test\n");
+	printf("\n");
+
+	/* capture a scrolling gradient */
+	for (i = 0; i < 60; i++)
+	{
+		for (y = 0; y < frame->h; y++)
+		{
+			for (x = 0; x < frame->w; x++)
+			{
+				((uint32_t *)frame->pixels)[y * frame->w + x] =
+					pack_argb8888((x + i * 4) & 0xFF, y * 2, 255 - x, 255);
+			}
+		}
+
+		capture_frame(capture, frame);
+	}
+
+	printf("frames captured: %lu\n", (unsigned long)capture->frames_captured);
+	printf("frames dropped: %lu\n", (unsigned long)capture->frames_dropped);
+	printf("max queue depth: %lu\n", (unsigned long)capture->max_depth);
+
+	/* close stream, writes any queued frames */
+	capture_close(capture);
+
+	/* destroy surface */
+	surface_destroy(frame);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,476 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexcapture.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: y4m frame capture
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_CAPTURE_H__
+#define __LIBREX_CAPTURE_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexmath.h"
+#include "rexsurface.h"
+#include "rexyuv.h"
+
+#endif
+
+/*
+ * background writer thread. posix (anything defining __unix__ except
+ * djgpp) and win32 only, can be disabled with LIBREX_NO_THREADS, in which
+ * case frames are written as they arrive
+ */
+#if !defined(LIBREX_NO_THREADS) && defined(__unix__) && !defined(__DJGPP__)
+#define CAPTURE_THREADS 1
+#include <pthread.h>
+#include <semaphore.h>
+typedef sem_t capture_sem_t;
+typedef pthread_t capture_thread_t;
+#elif !defined(LIBREX_NO_THREADS) && defined(_WIN32)
+#define CAPTURE_THREADS 1
+#include <windows.h>
+typedef HANDLE capture_sem_t;
+typedef HANDLE capture_thread_t;
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+/* y4m capture stream of 4:2:0 frames */
+typedef struct capture_t
+{
+	FILE *file;
+	int w;
+	int h;
+	size_t frame_size;
+
+	/* ring of converted frames, written by the producer at head */
+	int queue_size;
+	uint8_t *queue;
+	volatile uint32_t head;
+	volatile uint32_t tail;
+
+	/* counters */
+	volatile uint32_t frames_captured;
+	volatile uint32_t frames_dropped;
+	volatile uint32_t frames_written;
+	volatile uint32_t max_depth;
+	volatile int write_error;
+
+#ifdef CAPTURE_THREADS
+	capture_sem_t free_slots;
+	capture_sem_t used_slots;
+	capture_thread_t thread;
+#endif
+} capture_t;
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* capture stream creation and destruction */
+capture_t *capture_open(const char *filename, int w, int h, int fps,
+	int queue_size);
+void capture_close(capture_t *c);
+
+/* frame submission */
+int capture_frame(capture_t *c, surface_t *s);
+
+/* counters */
+int capture_queue_depth(capture_t *c);
+
+/* color transform */
+void capture_argb8888_to_yuv420(surface_t *s, uint8_t *y, uint8_t *u,
+	uint8_t *v);
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/*
+ * internal helpers
+ */
+
+#ifdef CAPTURE_THREADS
+
+#ifdef _WIN32
+
+static int capture_sem_init(capture_sem_t *s, int n)
+{
+	*s = CreateSemaphore(NULL, n, 0x7FFFFFFF, NULL);
+	return *s != NULL;
+}
+
+static void capture_sem_destroy(capture_sem_t *s)
+{
+	CloseHandle(*s);
+}
+
+static void capture_sem_wait(capture_sem_t *s)
+{
+	WaitForSingleObject(*s, INFINITE);
+}
+
+static int capture_sem_trywait(capture_sem_t *s)
+{
+	return WaitForSingleObject(*s, 0) == WAIT_OBJECT_0;
+}
+
+static void capture_sem_post(capture_sem_t *s)
+{
+	ReleaseSemaphore(*s, 1, NULL);
+}
+
+#else
+
+static int capture_sem_init(capture_sem_t *s, int n)
+{
+	return sem_init(s, 0, n) == 0;
+}
+
+static void capture_sem_destroy(capture_sem_t *s)
+{
+	sem_destroy(s);
+}
+
+static void capture_sem_wait(capture_sem_t *s)
+{
+	while (sem_wait(s) != 0)
+		continue;
+}
+
+static int capture_sem_trywait(capture_sem_t *s)
+{
+	return sem_trywait(s) == 0;
+}
+
+static void capture_sem_post(capture_sem_t *s)
+{
+	sem_post(s);
+}
+
+#endif
+
+#endif
+
+/* write one converted frame to the file */
+static void capture_write(capture_t *c, uint8_t *frame)
+{
+	if (fputs("FRAME\n", c->file) < 0 ||
+		fwrite(frame, 1, c->frame_size, c->file) != c->frame_size)
+	{
+		c->write_error = 1;
+		return;
+	}
+
+	c->frames_written++;
+}
+
+#ifdef CAPTURE_THREADS
+
+/*
+ * writer thread. every used slot token is a frame, except the last one
+ * posted by capture_close, which arrives when head and tail meet
+ */
+#ifdef _WIN32
+static DWORD WINAPI capture_writer(LPVOID arg)
+#else
+static void *capture_writer(void *arg)
+#endif
+{
+	/* variables */
+	capture_t *c = (capture_t *)arg;
+
+	while (1)
+	{
+		capture_sem_wait(&c->used_slots);
+
+		/* stop token */
+		if (c->tail == c->head)
+			break;
+
+		capture_write(c, c->queue + (c->tail % c->queue_size) * c->frame_size);
+		c->tail++;
+
+		capture_sem_post(&c->free_slots);
+	}
+
+	return 0;
+}
+
+#endif
+
+/*
+ * capture stream creation and destruction
+ */
+
+/*
+ * open a y4m stream for w by h frames at fps. queue_size frames can be
+ * waiting for the writer before further frames are dropped
+ */
+capture_t *capture_open(const char *filename, int w, int h, int fps,
+	int queue_size)
+{
+	/* variables */
+	capture_t *ret;
+
+	/* sanity checks */
+	if (!filename || w < 1 || h < 1 || fps < 1 || queue_size < 1) return NULL;
+
+	/* alloc */
+	ret = (capture_t *)LIBREX_CALLOC(1, sizeof(capture_t));
+	if (!ret) return NULL;
+
+	/* assign values */
+	ret->w = w;
+	ret->h = h;
+	ret->queue_size = queue_size;
+	ret->frame_size = (size_t)w * h + 2 * (size_t)((w + 1) / 2) * ((h + 1) / 2);
+
+	/* frame ring */
+	ret->queue = (uint8_t *)LIBREX_MALLOC(ret->frame_size * queue_size);
+	if (!ret->queue)
+	{
+		LIBREX_FREE(ret);
+		return NULL;
+	}
+
+	/* open file and write the stream header */
+	ret->file = fopen(filename, "wb");
+	if (!ret->file)
+	{
+		LIBREX_FREE(ret->queue);
+		LIBREX_FREE(ret);
+		return NULL;
+	}
+
+	/*
+	 * C420jpeg only names the chroma siting. the frames are full range
+	 * bt.601, which readers otherwise assume is limited range
+	 */
+	fprintf(ret->file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n",
+		w, h, fps);
+
+#ifdef CAPTURE_THREADS
+	/* start the writer */
+	if (!capture_sem_init(&ret->free_slots, queue_size))
+	{
+		fclose(ret->file);
+		LIBREX_FREE(ret->queue);
+		LIBREX_FREE(ret);
+		return NULL;
+	}
+
+	if (!capture_sem_init(&ret->used_slots, 0))
+	{
+		capture_sem_destroy(&ret->free_slots);
+		fclose(ret->file);
+		LIBREX_FREE(ret->queue);
+		LIBREX_FREE(ret);
+		return NULL;
+	}
+
+#ifdef _WIN32
+	ret->thread = CreateThread(NULL, 0, capture_writer, ret, 0, NULL);
+	if (!ret->thread)
+#else
+	if (pthread_create(&ret->thread, NULL, capture_writer, ret) != 0)
+#endif
+	{
+		capture_sem_destroy(&ret->free_slots);
+		capture_sem_destroy(&ret->used_slots);
+		fclose(ret->file);
+		LIBREX_FREE(ret->queue);
+		LIBREX_FREE(ret);
+		return NULL;
+	}
+#endif
+
+	/* return ptr */
+	return ret;
+}
+
+/* write out any queued frames, close the stream and free all memory */
+void capture_close(capture_t *c)
+{
+	if (c)
+	{
+#ifdef CAPTURE_THREADS
+		/* stop token, then wait for the queue to drain */
+		capture_sem_post(&c->used_slots);
+
+#ifdef _WIN32
+		WaitForSingleObject(c->thread, INFINITE);
+		CloseHandle(c->thread);
+#else
+		pthread_join(c->thread, NULL);
+#endif
+
+		capture_sem_destroy(&c->free_slots);
+		capture_sem_destroy(&c->used_slots);
+#endif
+
+		if (c->file)
+			fclose(c->file);
+
+		if (c->queue)
+			LIBREX_FREE(c->queue);
+
+		LIBREX_FREE(c);
+	}
+}
+
+/*
+ * frame submission
+ */
+
+/*
+ * convert a 32 bpp argb8888 surface to yuv and queue it. never blocks:
+ * returns 0 and counts a dropped frame if the queue is full
+ */
+int capture_frame(capture_t *c, surface_t *s)
+{
+	/* variables */
+	uint8_t *frame;
+	uint32_t depth;
+
+	/* sanity checks */
+	if (!c || !s || !s->pixels) return 0;
+	if (s->bpp != 32 || s->w != c->w || s->h != c->h) return 0;
+
+	c->frames_captured++;
+
+#ifdef CAPTURE_THREADS
+	/* claim a free slot */
+	if (!capture_sem_trywait(&c->free_slots))
+	{
+		c->frames_dropped++;
+		return 0;
+	}
+
+	frame = c->queue + (c->head % c->queue_size) * c->frame_size;
+#else
+	frame = c->queue;
+#endif
+
+	/* convert */
+	capture_argb8888_to_yuv420(s, frame, frame + c->w * c->h,
+		frame + c->w * c->h + ((c->w + 1) / 2) * ((c->h + 1) / 2));
+
+#ifdef CAPTURE_THREADS
+	/* hand it to the writer */
+	c->head++;
+	depth = c->head - c->tail;
+	if (depth > c->max_depth) c->max_depth = depth;
+	capture_sem_post(&c->used_slots);
+#else
+	depth = 1;
+	c->max_depth = depth;
+	capture_write(c, frame);
+#endif
+
+	return 1;
+}
+
+/*
+ * counters
+ */
+
+/* number of frames waiting for the writer */
+int capture_queue_depth(capture_t *c)
+{
+	/* sanity checks */
+	if (!c) return 0;
+
+	return (int)(c->head - c->tail);
+}
+
+/*
+ * color transform
+ */
+
+/*
+ * convert an argb8888 surface to full range bt.601 planes. chroma is taken
+ * from the average of each 2x2 block
+ */
+void capture_argb8888_to_yuv420(surface_t *s, uint8_t *y, uint8_t *u,
+	uint8_t *v)
+{
+	yuv_from_argb8888(s, y, u, v, YUV_420);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_CAPTURE_H__ */
@@ -49,6 +49,11 @@ int main(int argc, char **argv)
 {
 	/* variables */
 	color_t c;
+	uint8_t r[37], g[37], b[37], a[37];
+	uint8_t r2[37], g2[37], b2[37], a2[37];
+	uint32_t p32[37];
+	uint16_t p16[37];
+	int i, j, errors;
 
 	/* print header */
 	printf("librex: rexcolor.h test\n");
@@ -112,6 +117,86 @@ int main(int argc, char **argv)
 	printf("\tblue: %0.4f\n", color_get_bluef(&c));
 	printf("\talpha: %0.4f\n", color_get_alphaf(&c));
 
+	printf("\n");
+	printf("\n");
+
+	/* bulk packing, 37 pixels covers both the simd and scalar paths */
+	for (i = 0; i < 37; i++)
+	{
+		r[i] = (uint8_t)(i * 7);
+		g[i] = (uint8_t)(i * 13 + 100);
+		b[i] = (uint8_t)(255 - i * 5);
+		a[i] = (uint8_t)(i * 3 + 128);
+	}
+
+	errors = 0;
+
+	pack_rgb565_array(p16, r, g, b, 37);
+	unpack_rgb565_array(p16, r2, g2, b2, 37);
+	for (i = 0; i < 37; i++)
+	{
+		if (p16[i] != pack_rgb565(r[i], g[i], b[i])) errors++;
+		if (r2[i] != unpack_rgb565_red(p16[i])) errors++;
+		if (g2[i] != unpack_rgb565_green(p16[i])) errors++;
+		if (b2[i] != unpack_rgb565_blue(p16[i])) errors++;
+	}
+
+	pack_rgba8888_array(p32, r, g, b, a, 37);
+	unpack_rgba8888_array(p32, r2, g2, b2, a2, 37);
+	for (i = 0; i < 37; i++)
+	{
+		if (p32[i] != pack_rgba8888(r[i], g[i], b[i], a[i])) errors++;
+		if (r2[i] != r[i] || g2[i] != g[i] || b2[i] != b[i] || a2[i] != a[i]) errors++;
+	}
+
+	pack_argb8888_array(p32, r, g, b, a, 37);
+	unpack_argb8888_array(p32, r2, g2, b2, a2, 37);
+	for (i = 0; i < 37; i++)
+	{
+		if (p32[i] != pack_argb8888(r[i], g[i], b[i], a[i])) errors++;
+		if (r2[i] != r[i] || g2[i] != g[i] || b2[i] != b[i] || a2[i] != a[i]) errors++;
+	}
+
+	printf("type: bulk arrays\n");
+	printf("input: 37 pixels\n");
+	printf("\n");
+	printf("results:\n");
+	printf("\trgb565[20]: %04x\n", p16[20]);
+	printf("\targb8888[20]: %08x\n", p32[20]);
+	printf("\terrors: %d\n", errors);
+
+	/* rgb565 expansion, every value against the per channel unpackers */
+	errors = 0;
+
+	for (i = 0; i < 65536; i += 16)
+	{
+		for (j = 0; j < 16; j++) p16[j] = (uint16_t)(i + j);
+		expand_rgb565_array(p16, p32, 16);
+
+		for (j = 0; j < 16; j++)
+		{
+			if (p32[j] != pack_argb8888(unpack_rgb565_red(p16[j]),
+				unpack_rgb565_green(p16[j]), unpack_rgb565_blue(p16[j]), 255))
+				errors++;
+		}
+	}
+
+	p16[0] = 0xFFFF;
+	p16[1] = 0x0000;
+	p16[2] = 0x8410;
+	expand_rgb565_array(p16, p32, 3);
+
+	printf("\n");
+	printf("\n");
+	printf("type: rgb565 expansion\n");
+	printf("input: 65536 values\n");
+	printf("\n");
+	printf("results:\n");
+	printf("\twhite: %08x\n", p32[0]);
+	printf("\tblack: %08x\n", p32[1]);
+	printf("\tmid gray: %08x\n", p32[2]);
+	printf("\terrors: %d\n", errors);
+
 	/* exit gracefully */
 	return EXIT_SUCCESS;
 }
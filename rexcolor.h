@@ -63,6 +63,12 @@ extern "C" {
 #else
 #include <stdint.h>
 #endif
+#include "rexstd.h"
+
+/* simd */
+#ifdef LIBREX_SSE2
+#include <emmintrin.h>
+#endif
 
 /* *************************************
  *
@@ -138,6 +144,23 @@ uint8_t unpack_argb8888_green(uint32_t c);
 uint8_t unpack_argb8888_blue(uint32_t c);
 uint8_t unpack_argb8888_alpha(uint32_t c);
 
+/* bulk color packing */
+void pack_rgb565_array(uint16_t *dst, uint8_t *r, uint8_t *g, uint8_t *b,
+	int n);
+void pack_rgba8888_array(uint32_t *dst, uint8_t *r, uint8_t *g, uint8_t *b,
+	uint8_t *a, int n);
+void pack_argb8888_array(uint32_t *dst, uint8_t *r, uint8_t *g, uint8_t *b,
+	uint8_t *a, int n);
+
+/* bulk color unpacking */
+void unpack_rgb565_array(uint16_t *src, uint8_t *r, uint8_t *g, uint8_t *b,
+	int n);
+void unpack_rgba8888_array(uint32_t *src, uint8_t *r, uint8_t *g, uint8_t *b,
+	uint8_t *a, int n);
+void unpack_argb8888_array(uint32_t *src, uint8_t *r, uint8_t *g, uint8_t *b,
+	uint8_t *a, int n);
+void expand_rgb565_array(uint16_t *src, uint32_t *dst, int n);
+
 /* *************************************
  *
  * the functions
@@ -335,15 +358,67 @@ uint16_t pack_rgb565(uint8_t r, uint8_t g, uint8_t b)
 /* pack rgba quadruplet to rgba8888 format */
 uint32_t pack_rgba8888(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
 {
-	return (uint32_t)((r << 24) | (g << 16) | (b << 8) | a);
+	return ((uint32_t)r << 24) | ((uint32_t)g << 16) | ((uint32_t)b << 8) | a;
 }
 
 /* pack rgba quadruplet to argb8888 format */
 uint32_t pack_argb8888(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
 {
-	return (uint32_t)((a << 24) | (r << 16) | (g << 8) | b);
+	return ((uint32_t)a << 24) | ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
 }
 
+/*
+ * rgb565 expansion tables
+ */
+
+/*
+ * 5 and 6 bit channels widened to 8 bits by replicating their high bits
+ * into the low ones, so 0 stays 0 and full intensity becomes 255
+ */
+#define COLOR_EXPAND5(v) ((((v) & 0x1F) << 3) | (((v) & 0x1F) >> 2))
+#define COLOR_EXPAND6(v) ((((v) & 0x3F) << 2) | (((v) & 0x3F) >> 4))
+
+/* generate the 16 and 256 entry runs of a table from an entry macro */
+#define COLOR_TABLE16(M, i) \
+	M((i) + 0), M((i) + 1), M((i) + 2), M((i) + 3), \
+	M((i) + 4), M((i) + 5), M((i) + 6), M((i) + 7), \
+	M((i) + 8), M((i) + 9), M((i) + 10), M((i) + 11), \
+	M((i) + 12), M((i) + 13), M((i) + 14), M((i) + 15)
+#define COLOR_TABLE256(M) \
+	COLOR_TABLE16(M, 0), COLOR_TABLE16(M, 16), COLOR_TABLE16(M, 32), \
+	COLOR_TABLE16(M, 48), COLOR_TABLE16(M, 64), COLOR_TABLE16(M, 80), \
+	COLOR_TABLE16(M, 96), COLOR_TABLE16(M, 112), COLOR_TABLE16(M, 128), \
+	COLOR_TABLE16(M, 144), COLOR_TABLE16(M, 160), COLOR_TABLE16(M, 176), \
+	COLOR_TABLE16(M, 192), COLOR_TABLE16(M, 208), COLOR_TABLE16(M, 224), \
+	COLOR_TABLE16(M, 240)
+
+/* single channel tables */
+static const uint8_t color_expand5[32] =
+{
+	COLOR_TABLE16(COLOR_EXPAND5, 0), COLOR_TABLE16(COLOR_EXPAND5, 16)
+};
+
+static const uint8_t color_expand6[64] =
+{
+	COLOR_TABLE16(COLOR_EXPAND6, 0), COLOR_TABLE16(COLOR_EXPAND6, 16),
+	COLOR_TABLE16(COLOR_EXPAND6, 32), COLOR_TABLE16(COLOR_EXPAND6, 48)
+};
+
+/*
+ * whole pixel tables, one per byte of an rgb565 value. the low byte holds
+ * blue and the low 3 bits of green, the high byte red and the high 3 bits
+ * of green. the replicated green bits only come from the high 3, so the
+ * two argb8888 halves never overlap and a pixel is hi[c >> 8] | lo[c & 0xFF]
+ */
+#define COLOR_565_LO(i) \
+	((((uint32_t)(i) >> 5) << 10) | (uint32_t)COLOR_EXPAND5(i))
+#define COLOR_565_HI(i) \
+	(0xFF000000UL | ((uint32_t)COLOR_EXPAND5((i) >> 3) << 16) | \
+	(((((uint32_t)(i) & 7) << 5) | (((uint32_t)(i) & 7) >> 1)) << 8))
+
+static const uint32_t color_rgb565_lo[256] = {COLOR_TABLE256(COLOR_565_LO)};
+static const uint32_t color_rgb565_hi[256] = {COLOR_TABLE256(COLOR_565_HI)};
+
 /*
  * color unpacking: rgb565
  */
@@ -351,19 +426,19 @@ uint32_t pack_argb8888(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
 /* retrieve red from rgb565 int */
 uint8_t unpack_rgb565_red(uint16_t c)
 {
-	return (uint8_t)(((c & 0xF800) >> 11) << 3);
+	return color_expand5[c >> 11];
 }
 
 /* retrieve green from rgb565 int */
 uint8_t unpack_rgb565_green(uint16_t c)
 {
-	return (uint8_t)(((c & 0x7E0) >> 5) << 2);
+	return color_expand6[(c >> 5) & 0x3F];
 }
 
 /* retrieve blue from rgb565 int */
 uint8_t unpack_rgb565_blue(uint16_t c)
 {
-	return (uint8_t)((c & 0x1F) << 3);
+	return color_expand5[c & 0x1F];
 }
 
 /*
@@ -379,7 +454,7 @@ uint8_t unpack_rgba8888_red(uint32_t c)
 /* retrieve green from rgba8888 int */
 uint8_t unpack_rgba8888_green(uint32_t c)
 {
-	return (uint8_t)((c >> 8) & 0xFF);
+	return (uint8_t)((c >> 16) & 0xFF);
 }
 
 /* retrieve blue from rgba8888 int */
@@ -422,6 +497,336 @@ uint8_t unpack_argb8888_alpha(uint32_t c)
 	return (uint8_t)((c >> 24) & 0xFF);
 }
 
+/*
+ * bulk color packing
+ */
+
+/*
+ * pack n pixels from separate r, g and b arrays to rgb565. every function in
+ * this section gives the same output as the single pixel versions, with or
+ * without simd
+ */
+void pack_rgb565_array(uint16_t *dst, uint8_t *r, uint8_t *g, uint8_t *b,
+	int n)
+{
+	/* variables */
+	int x;
+
+	/* sanity checks */
+	if (!dst || !r || !g || !b) return;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	{
+		__m128i zero, mr, mg, vr, vg, vb, lo, hi;
+
+		zero = _mm_setzero_si128();
+		mr = _mm_set1_epi16(0xF8);
+		mg = _mm_set1_epi16(0xFC);
+
+		for (; x + 16 <= n; x += 16)
+		{
+			vr = _mm_loadu_si128((__m128i *)(r + x));
+			vg = _mm_loadu_si128((__m128i *)(g + x));
+			vb = _mm_loadu_si128((__m128i *)(b + x));
+
+			lo = _mm_or_si128(_mm_or_si128(
+				_mm_slli_epi16(_mm_and_si128(_mm_unpacklo_epi8(vr, zero), mr), 8),
+				_mm_slli_epi16(_mm_and_si128(_mm_unpacklo_epi8(vg, zero), mg), 3)),
+				_mm_srli_epi16(_mm_unpacklo_epi8(vb, zero), 3));
+
+			hi = _mm_or_si128(_mm_or_si128(
+				_mm_slli_epi16(_mm_and_si128(_mm_unpackhi_epi8(vr, zero), mr), 8),
+				_mm_slli_epi16(_mm_and_si128(_mm_unpackhi_epi8(vg, zero), mg), 3)),
+				_mm_srli_epi16(_mm_unpackhi_epi8(vb, zero), 3));
+
+			_mm_storeu_si128((__m128i *)(dst + x), lo);
+			_mm_storeu_si128((__m128i *)(dst + x + 8), hi);
+		}
+	}
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < n; x++)
+		dst[x] = pack_rgb565(r[x], g[x], b[x]);
+}
+
+#ifdef LIBREX_SSE2
+/*
+ * interleave 16 pixels of four byte arrays into 32-bit pixels, c0 in the
+ * lowest byte and c3 in the highest
+ */
+static void color_interleave4(uint32_t *dst, uint8_t *c0, uint8_t *c1,
+	uint8_t *c2, uint8_t *c3)
+{
+	/* variables */
+	__m128i v0, v1, v2, v3, lo, hi;
+
+	v0 = _mm_loadu_si128((__m128i *)c0);
+	v1 = _mm_loadu_si128((__m128i *)c1);
+	v2 = _mm_loadu_si128((__m128i *)c2);
+	v3 = _mm_loadu_si128((__m128i *)c3);
+
+	/* byte pairs */
+	lo = _mm_unpacklo_epi8(v0, v1);
+	hi = _mm_unpacklo_epi8(v2, v3);
+	_mm_storeu_si128((__m128i *)(dst + 0), _mm_unpacklo_epi16(lo, hi));
+	_mm_storeu_si128((__m128i *)(dst + 4), _mm_unpackhi_epi16(lo, hi));
+
+	lo = _mm_unpackhi_epi8(v0, v1);
+	hi = _mm_unpackhi_epi8(v2, v3);
+	_mm_storeu_si128((__m128i *)(dst + 8), _mm_unpacklo_epi16(lo, hi));
+	_mm_storeu_si128((__m128i *)(dst + 12), _mm_unpackhi_epi16(lo, hi));
+}
+#endif
+
+/* pack n pixels to rgba8888. a may be NULL for opaque pixels */
+void pack_rgba8888_array(uint32_t *dst, uint8_t *r, uint8_t *g, uint8_t *b,
+	uint8_t *a, int n)
+{
+	/* variables */
+	int x;
+
+	/* sanity checks */
+	if (!dst || !r || !g || !b) return;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	if (a)
+	{
+		for (; x + 16 <= n; x += 16)
+			color_interleave4(dst + x, a + x, b + x, g + x, r + x);
+	}
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < n; x++)
+		dst[x] = pack_rgba8888(r[x], g[x], b[x], a ? a[x] : 255);
+}
+
+/* pack n pixels to argb8888. a may be NULL for opaque pixels */
+void pack_argb8888_array(uint32_t *dst, uint8_t *r, uint8_t *g, uint8_t *b,
+	uint8_t *a, int n)
+{
+	/* variables */
+	int x;
+
+	/* sanity checks */
+	if (!dst || !r || !g || !b) return;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	if (a)
+	{
+		for (; x + 16 <= n; x += 16)
+			color_interleave4(dst + x, b + x, g + x, r + x, a + x);
+	}
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < n; x++)
+		dst[x] = pack_argb8888(r[x], g[x], b[x], a ? a[x] : 255);
+}
+
+/*
+ * bulk color unpacking
+ */
+
+/* unpack n rgb565 pixels to separate r, g and b arrays */
+void unpack_rgb565_array(uint16_t *src, uint8_t *r, uint8_t *g, uint8_t *b,
+	int n)
+{
+	/* variables */
+	int x;
+
+	/* sanity checks */
+	if (!src || !r || !g || !b) return;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	{
+		__m128i lo, hi, m5, m6, v[2];
+		int k;
+
+		m5 = _mm_set1_epi16(0x1F);
+		m6 = _mm_set1_epi16(0x3F);
+
+		for (; x + 16 <= n; x += 16)
+		{
+			lo = _mm_loadu_si128((__m128i *)(src + x));
+			hi = _mm_loadu_si128((__m128i *)(src + x + 8));
+
+			/* each channel is widened with its high bits replicated */
+			for (k = 0; k < 2; k++)
+			{
+				v[k] = _mm_srli_epi16(k ? hi : lo, 11);
+				v[k] = _mm_or_si128(_mm_slli_epi16(v[k], 3), _mm_srli_epi16(v[k], 2));
+			}
+			_mm_storeu_si128((__m128i *)(r + x), _mm_packus_epi16(v[0], v[1]));
+
+			for (k = 0; k < 2; k++)
+			{
+				v[k] = _mm_and_si128(_mm_srli_epi16(k ? hi : lo, 5), m6);
+				v[k] = _mm_or_si128(_mm_slli_epi16(v[k], 2), _mm_srli_epi16(v[k], 4));
+			}
+			_mm_storeu_si128((__m128i *)(g + x), _mm_packus_epi16(v[0], v[1]));
+
+			for (k = 0; k < 2; k++)
+			{
+				v[k] = _mm_and_si128(k ? hi : lo, m5);
+				v[k] = _mm_or_si128(_mm_slli_epi16(v[k], 3), _mm_srli_epi16(v[k], 2));
+			}
+			_mm_storeu_si128((__m128i *)(b + x), _mm_packus_epi16(v[0], v[1]));
+		}
+	}
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < n; x++)
+	{
+		r[x] = unpack_rgb565_red(src[x]);
+		g[x] = unpack_rgb565_green(src[x]);
+		b[x] = unpack_rgb565_blue(src[x]);
+	}
+}
+
+#ifdef LIBREX_SSE2
+/* the byte at shift of 16 32-bit pixels, packed down to 16 bytes */
+static __m128i color_extract(__m128i *p, int shift)
+{
+	/* variables */
+	__m128i mask, v[4];
+	int i;
+
+	mask = _mm_set1_epi32(0xFF);
+
+	for (i = 0; i < 4; i++)
+		v[i] = _mm_and_si128(_mm_srl_epi32(p[i], _mm_cvtsi32_si128(shift)), mask);
+
+	return _mm_packus_epi16(_mm_packs_epi32(v[0], v[1]),
+		_mm_packs_epi32(v[2], v[3]));
+}
+
+/*
+ * split 16 32-bit pixels into four byte arrays, c0 from the lowest byte and
+ * c3 from the highest. any of them may be NULL
+ */
+static void color_deinterleave4(uint32_t *src, uint8_t *c0, uint8_t *c1,
+	uint8_t *c2, uint8_t *c3)
+{
+	/* variables */
+	__m128i p[4];
+
+	p[0] = _mm_loadu_si128((__m128i *)(src + 0));
+	p[1] = _mm_loadu_si128((__m128i *)(src + 4));
+	p[2] = _mm_loadu_si128((__m128i *)(src + 8));
+	p[3] = _mm_loadu_si128((__m128i *)(src + 12));
+
+	if (c0) _mm_storeu_si128((__m128i *)c0, color_extract(p, 0));
+	if (c1) _mm_storeu_si128((__m128i *)c1, color_extract(p, 8));
+	if (c2) _mm_storeu_si128((__m128i *)c2, color_extract(p, 16));
+	if (c3) _mm_storeu_si128((__m128i *)c3, color_extract(p, 24));
+}
+#endif
+
+/* unpack n rgba8888 pixels to separate arrays. a may be NULL */
+void unpack_rgba8888_array(uint32_t *src, uint8_t *r, uint8_t *g, uint8_t *b,
+	uint8_t *a, int n)
+{
+	/* variables */
+	int x;
+
+	/* sanity checks */
+	if (!src || !r || !g || !b) return;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	for (; x + 16 <= n; x += 16)
+		color_deinterleave4(src + x, a ? a + x : NULL, b + x, g + x, r + x);
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < n; x++)
+	{
+		r[x] = unpack_rgba8888_red(src[x]);
+		g[x] = unpack_rgba8888_green(src[x]);
+		b[x] = unpack_rgba8888_blue(src[x]);
+		if (a) a[x] = unpack_rgba8888_alpha(src[x]);
+	}
+}
+
+/* unpack n argb8888 pixels to separate arrays. a may be NULL */
+void unpack_argb8888_array(uint32_t *src, uint8_t *r, uint8_t *g, uint8_t *b,
+	uint8_t *a, int n)
+{
+	/* variables */
+	int x;
+
+	/* sanity checks */
+	if (!src || !r || !g || !b) return;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	for (; x + 16 <= n; x += 16)
+		color_deinterleave4(src + x, b + x, g + x, r + x, a ? a + x : NULL);
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < n; x++)
+	{
+		r[x] = unpack_argb8888_red(src[x]);
+		g[x] = unpack_argb8888_green(src[x]);
+		b[x] = unpack_argb8888_blue(src[x]);
+		if (a) a[x] = unpack_argb8888_alpha(src[x]);
+	}
+}
+
+/*
+ * expand n rgb565 pixels to opaque argb8888 through the per byte tables.
+ * two loads and an or per pixel, with no per channel work
+ */
+void expand_rgb565_array(uint16_t *src, uint32_t *dst, int n)
+{
+	/* variables */
+	int x;
+	uint32_t c;
+
+	/* sanity checks */
+	if (!src || !dst) return;
+
+	/* unrolled by 4 */
+	for (x = 0; x + 4 <= n; x += 4)
+	{
+		c = src[x];
+		dst[x] = color_rgb565_hi[c >> 8] | color_rgb565_lo[c & 0xFF];
+		c = src[x + 1];
+		dst[x + 1] = color_rgb565_hi[c >> 8] | color_rgb565_lo[c & 0xFF];
+		c = src[x + 2];
+		dst[x + 2] = color_rgb565_hi[c >> 8] | color_rgb565_lo[c & 0xFF];
+		c = src[x + 3];
+		dst[x + 3] = color_rgb565_hi[c >> 8] | color_rgb565_lo[c & 0xFF];
+	}
+
+	/* leftovers */
+	for (; x < n; x++)
+	{
+		c = src[x];
+		dst[x] = color_rgb565_hi[c >> 8] | color_rgb565_lo[c & 0xFF];
+	}
+}
+
 #ifdef __cplusplus
 }
 #endif
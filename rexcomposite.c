@@ -0,0 +1,141 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexcomposite.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexcomposite.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* rex */
+#include "rexcomposite.h"
+
+/* fill a surface with a pattern */
+void fill(surface_t *s, int seed, int alpha)
+{
+	/* variables */
+	int x, y;
+
+	for (y = 0; y < s->h; y++)
+	{
+		for (x = 0; x < s->w; x++)
+		{
+			((uint32_t *)s->pixels)[y * s->w + x] = pack_argb8888(
+				(x * seed) & 0xFF, (y * seed) & 0xFF, seed * 40, alpha);
+		}
+	}
+}
+
+/* blend a whole layer, for comparison */
+void draw_layer(surface_t *dst, composite_layer_t *l)
+{
+	/* variables */
+	int y;
+
+	for (y = 0; y < MIN(l->surface->h, dst->h - l->y); y++)
+	{
+		blend_span_mode_argb8888(
+			(uint32_t *)SURFACE_PTR(dst, l->x, l->y + y),
+			(uint32_t *)SURFACE_PTR(l->surface, 0, y),
+			MIN(l->surface->w, dst->w - l->x), l->opacity, l->mode,
+			l->flags & BLEND_SRGB);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	surface_t *dst, *ref, *world, *hud, *glow, *popup;
+	compositor_t *c;
+	int i;
+
+	/* create surfaces */
+	dst = surface_create(320, 200, 32, NULL);
+	ref = surface_create(320, 200, 32, NULL);
+	world = surface_create(320, 200, 32, NULL);
+	hud = surface_create(320, 24, 32, NULL);
+	glow = surface_create(160, 100, 32, NULL);
+	popup = surface_create(200, 120, 32, NULL);
+
+	fill(world, 1, 255);
+	fill(hud, 2, 160);
+	fill(glow, 3, 255);
+	fill(popup, 4, 255);
+
+	/* layers, bottom to top */
+	c = compositor_create();
+	compositor_add(c, world, 0, 0, 255, BLEND_MODE_COPY, 0);
+	compositor_add(c, glow, 80, 50, 128, BLEND_MODE_ADD, 0);
+	compositor_add(c, world, 0, 0, 255, BLEND_MODE_MULTIPLY, BLEND_SRGB);
+	compositor_add(c, popup, 60, 40, 255, BLEND_MODE_OVER, COMPOSITE_OPAQUE);
+	compositor_add(c, hud, 0, 176, 255, BLEND_MODE_OVER, 0);
+	compositor_add(c, popup, 100, 100, 200, BLEND_MODE_SCREEN, 0);
+	compositor_add(c, popup, 150, 20, 255, BLEND_MODE_OVER, COMPOSITE_OPAQUE);
+
+	/* print header */
+	printf("librex: rexcomposite.h test\n");
+	printf("\n");
+
+	/* composite */
+	compositor_draw(c, dst);
+
+	/* reference, every layer drawn in full */
+	for (i = 0; i < c->num_layers; i++)
+		draw_layer(ref, &c->layers[i]);
+
+	printf("pieces: %d\n", c->num_pieces);
+	printf("pixels drawn: %lu\n", (unsigned long)c->pixels_drawn);
+	printf("pixels culled: %lu\n", (unsigned long)c->pixels_culled);
+	printf("matches full draw: %s\n", memcmp(dst->pixels, ref->pixels,
+		dst->bytes_per_row * dst->h) ? "no" : "yes");
+
+	surface_dump_buffer(dst, "rexcomposite.data");
+
+	/* destroy */
+	compositor_destroy(c);
+	surface_destroy(dst);
+	surface_destroy(ref);
+	surface_destroy(world);
+	surface_destroy(hud);
+	surface_destroy(glow);
+	surface_destroy(popup);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,444 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexcomposite.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: layered compositor
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_COMPOSITE_H__
+#define __LIBREX_COMPOSITE_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexmath.h"
+#include "rexsurface.h"
+#include "rexblend.h"
+
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+#define COMPOSITOR_MAX_LAYERS 64
+
+/*
+ * layer flags, alongside the blend flags. COMPOSITE_OPAQUE promises that
+ * every pixel of the surface has full alpha, so an over layer at full
+ * opacity hides what's below it
+ */
+#define COMPOSITE_OPAQUE 0x100
+#define COMPOSITE_HIDDEN 0x200
+
+/* a layer. 32 bpp argb8888 surface placed at x, y */
+typedef struct composite_layer_t
+{
+	surface_t *surface;
+	int x;
+	int y;
+	int opacity;
+	int mode;
+	int flags;
+} composite_layer_t;
+
+/* visible piece of a layer */
+typedef struct composite_piece_t
+{
+	surface_rect_t r;
+	int layer;
+} composite_piece_t;
+
+/* layers in bottom to top order */
+typedef struct compositor_t
+{
+	int num_layers;
+	composite_layer_t layers[COMPOSITOR_MAX_LAYERS];
+
+	/* scratch lists */
+	composite_piece_t *pieces;
+	int num_pieces, max_pieces;
+	surface_rect_t *covered;
+	int num_covered, max_covered;
+
+	/* counters for the last draw */
+	uint32_t pixels_drawn;
+	uint32_t pixels_culled;
+} compositor_t;
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* compositor creation and destruction */
+compositor_t *compositor_create(void);
+void compositor_destroy(compositor_t *c);
+
+/* layers */
+void compositor_clear(compositor_t *c);
+int compositor_add(compositor_t *c, surface_t *s, int x, int y, int opacity,
+	int mode, int flags);
+
+/* drawing */
+void compositor_draw(compositor_t *c, surface_t *dst);
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/*
+ * internal helpers
+ */
+
+/* layer hides everything below it */
+#define COMPOSITE_IS_OPAQUE(l) ((l)->opacity >= 255 && \
+	((l)->mode == BLEND_MODE_COPY || \
+	((l)->mode == BLEND_MODE_OVER && ((l)->flags & COMPOSITE_OPAQUE))))
+
+/* append a piece, growing the list. returns 0 when out of memory */
+static int compositor_push_piece(compositor_t *c, surface_rect_t *r,
+	int layer)
+{
+	/* variables */
+	composite_piece_t *pieces;
+	int max;
+
+	if (c->num_pieces == c->max_pieces)
+	{
+		max = c->max_pieces ? c->max_pieces * 2 : 64;
+		pieces = (composite_piece_t *)LIBREX_REALLOC(c->pieces,
+			max * sizeof(composite_piece_t));
+		if (!pieces) return 0;
+
+		c->pieces = pieces;
+		c->max_pieces = max;
+	}
+
+	c->pieces[c->num_pieces].r = *r;
+	c->pieces[c->num_pieces].layer = layer;
+	c->num_pieces++;
+
+	return 1;
+}
+
+/* append a covered rectangle, growing the list. returns 0 when out of memory */
+static int compositor_push_covered(compositor_t *c, surface_rect_t *r)
+{
+	/* variables */
+	surface_rect_t *covered;
+	int max;
+
+	if (c->num_covered == c->max_covered)
+	{
+		max = c->max_covered ? c->max_covered * 2 : 16;
+		covered = (surface_rect_t *)LIBREX_REALLOC(c->covered,
+			max * sizeof(surface_rect_t));
+		if (!covered) return 0;
+
+		c->covered = covered;
+		c->max_covered = max;
+	}
+
+	c->covered[c->num_covered++] = *r;
+
+	return 1;
+}
+
+/*
+ * replace pieces first to num_pieces - 1 with what's left of them outside
+ * of rectangle k. each piece splits into at most four
+ */
+static int compositor_subtract(compositor_t *c, int first, surface_rect_t *k)
+{
+	/* variables */
+	surface_rect_t p, q;
+	int i, end, layer, out;
+
+	end = c->num_pieces;
+	out = first;
+
+	for (i = first; i < end; i++)
+	{
+		p = c->pieces[i].r;
+		layer = c->pieces[i].layer;
+
+		/* untouched, keep in place */
+		if (k->x1 >= p.x2 || k->x2 <= p.x1 || k->y1 >= p.y2 || k->y2 <= p.y1)
+		{
+			c->pieces[out++] = c->pieces[i];
+			continue;
+		}
+
+		/* above */
+		if (k->y1 > p.y1)
+		{
+			q = p;
+			q.y2 = k->y1;
+			if (!compositor_push_piece(c, &q, layer)) return 0;
+		}
+
+		/* below */
+		if (k->y2 < p.y2)
+		{
+			q = p;
+			q.y1 = k->y2;
+			if (!compositor_push_piece(c, &q, layer)) return 0;
+		}
+
+		/* left and right, over the overlapping rows */
+		q.y1 = MAX(p.y1, k->y1);
+		q.y2 = MIN(p.y2, k->y2);
+
+		if (k->x1 > p.x1)
+		{
+			q.x1 = p.x1;
+			q.x2 = k->x1;
+			if (!compositor_push_piece(c, &q, layer)) return 0;
+		}
+
+		if (k->x2 < p.x2)
+		{
+			q.x1 = k->x2;
+			q.x2 = p.x2;
+			if (!compositor_push_piece(c, &q, layer)) return 0;
+		}
+	}
+
+	/* close the gap between the kept pieces and the new ones */
+	memmove(c->pieces + out, c->pieces + end,
+		(c->num_pieces - end) * sizeof(composite_piece_t));
+	c->num_pieces = out + (c->num_pieces - end);
+
+	return 1;
+}
+
+/*
+ * compositor creation and destruction
+ */
+
+/* create an empty compositor */
+compositor_t *compositor_create(void)
+{
+	return (compositor_t *)LIBREX_CALLOC(1, sizeof(compositor_t));
+}
+
+/* destroy compositor and free all associated memory. layer surfaces are not freed */
+void compositor_destroy(compositor_t *c)
+{
+	if (c)
+	{
+		if (c->pieces)
+			LIBREX_FREE(c->pieces);
+
+		if (c->covered)
+			LIBREX_FREE(c->covered);
+
+		LIBREX_FREE(c);
+	}
+}
+
+/*
+ * layers
+ */
+
+/* remove all layers */
+void compositor_clear(compositor_t *c)
+{
+	/* sanity checks */
+	if (!c) return;
+
+	c->num_layers = 0;
+}
+
+/*
+ * add a layer on top of the others. opacity is 0 to 255, mode is one of
+ * the blend modes and flags combines the blend flags with COMPOSITE_*.
+ * returns the layer index, or -1 on failure
+ */
+int compositor_add(compositor_t *c, surface_t *s, int x, int y, int opacity,
+	int mode, int flags)
+{
+	/* variables */
+	composite_layer_t *l;
+
+	/* sanity checks */
+	if (!c || !s || !s->pixels || s->bpp != 32) return -1;
+	if (c->num_layers >= COMPOSITOR_MAX_LAYERS) return -1;
+
+	l = &c->layers[c->num_layers];
+	l->surface = s;
+	l->x = x;
+	l->y = y;
+	l->opacity = CLAMP(opacity, 0, 255);
+	l->mode = mode;
+	l->flags = flags;
+
+	return c->num_layers++;
+}
+
+/*
+ * drawing
+ */
+
+/*
+ * composite all layers into dst, within its clip rectangle. layers are
+ * walked top down to find what each one leaves visible once the opaque
+ * layers above it are taken away, then only those pieces are blended,
+ * bottom up
+ */
+void compositor_draw(compositor_t *c, surface_t *dst)
+{
+	/* variables */
+	composite_layer_t *l;
+	composite_piece_t *p;
+	surface_rect_t r;
+	int i, j, first, y, w, occluded;
+	uint32_t total;
+
+	/* sanity checks */
+	if (!c || !dst || !dst->pixels || dst->bpp != 32) return;
+	if (!surface_detach(dst)) return;
+
+	c->num_pieces = 0;
+	c->num_covered = 0;
+	c->pixels_drawn = 0;
+	c->pixels_culled = 0;
+	total = 0;
+	occluded = 0;
+
+	/* visibility, top down */
+	for (i = c->num_layers - 1; i >= 0; i--)
+	{
+		l = &c->layers[i];
+
+		if (l->flags & COMPOSITE_HIDDEN || l->opacity <= 0)
+			continue;
+
+		/* layer rectangle within the clip rectangle */
+		r.x1 = MAX(l->x, dst->clip.x1);
+		r.y1 = MAX(l->y, dst->clip.y1);
+		r.x2 = MIN(l->x + l->surface->w, dst->clip.x2);
+		r.y2 = MIN(l->y + l->surface->h, dst->clip.y2);
+
+		if (r.x1 >= r.x2 || r.y1 >= r.y2)
+			continue;
+
+		total += (uint32_t)(r.x2 - r.x1) * (r.y2 - r.y1);
+
+		if (occluded)
+			continue;
+
+		/* cut away everything covered from above */
+		first = c->num_pieces;
+		if (!compositor_push_piece(c, &r, i)) return;
+
+		for (j = 0; j < c->num_covered && c->num_pieces > first; j++)
+		{
+			if (!compositor_subtract(c, first, &c->covered[j])) return;
+		}
+
+		if (COMPOSITE_IS_OPAQUE(l))
+		{
+			if (!compositor_push_covered(c, &r)) return;
+
+			/* nothing below can show through */
+			if (r.x1 == dst->clip.x1 && r.y1 == dst->clip.y1 &&
+				r.x2 == dst->clip.x2 && r.y2 == dst->clip.y2)
+			{
+				occluded = 1;
+			}
+		}
+	}
+
+	/* blend, bottom up */
+	for (i = c->num_pieces - 1; i >= 0; i--)
+	{
+		p = &c->pieces[i];
+		l = &c->layers[p->layer];
+		w = p->r.x2 - p->r.x1;
+
+		for (y = p->r.y1; y < p->r.y2; y++)
+		{
+			blend_span_mode_argb8888(
+				(uint32_t *)SURFACE_PTR(dst, p->r.x1, y),
+				(uint32_t *)SURFACE_PTR(l->surface, p->r.x1 - l->x, y - l->y),
+				w, l->opacity, l->mode, l->flags & BLEND_SRGB);
+		}
+
+		c->pixels_drawn += (uint32_t)w * (p->r.y2 - p->r.y1);
+	}
+
+	c->pixels_culled = total - c->pixels_drawn;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_COMPOSITE_H__ */
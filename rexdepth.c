@@ -0,0 +1,102 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexdepth.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexdepth.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* rex */
+#include "rexdepth.h"
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	surface_t *s;
+	depth_t *d;
+	color_t red, blue, black;
+	int y, hidden;
+
+	/* create surface and depth buffer */
+	s = surface_create(64, 64, 32, NULL);
+	d = depth_create(64, 64, 16, 1);
+
+	/* create colors */
+	color_set_argb8888(&red, 255, 0, 0, 255);
+	color_set_argb8888(&blue, 0, 0, 255, 255);
+	color_set_argb8888(&black, 0, 0, 0, 255);
+
+	/* clear */
+	surface_clear(s, &black);
+	depth_clear(d, DEPTH_FAR);
+
+	/* print header */
+	printf("librex: rexdepth.h test\n");
+	printf("\n");
+
+	/* a flat red wall at half depth, then a blue slope through it */
+	for (y = 0; y < 64; y++)
+	{
+		depth_span(s, d, 0, 64, y, 0x80000000UL, 0, &red);
+		depth_span(s, d, -8, 72, y, 0x40000000UL, 0x01000000L, &blue);
+	}
+
+	printf("pixel 0: %08x\n", ((uint32_t *)s->pixels)[0]);
+	printf("pixel 32: %08x\n", ((uint32_t *)s->pixels)[32]);
+	printf("pixel 63: %08x\n", ((uint32_t *)s->pixels)[63]);
+
+	/* spans behind the red wall are rejected by the tiles */
+	depth_refresh_tiles(d);
+	hidden = 0;
+	for (y = 0; y < 64; y++)
+		hidden += !depth_span_visible(d, 40, 64, y, 0x90000000UL);
+
+	printf("hidden spans: %d\n", hidden);
+
+	/* save buffers */
+	surface_dump_buffer(s, "color.data");
+	surface_dump_buffer(d->surface, "depth.data");
+
+	/* destroy */
+	depth_destroy(d);
+	surface_destroy(s);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,527 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexdepth.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: depth buffers and depth tested spans
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_DEPTH_H__
+#define __LIBREX_DEPTH_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexmath.h"
+#include "rexcolor.h"
+#include "rexmem.h"
+#include "rexsurface.h"
+
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+/* hierarchical tiles are 8x8 pixels */
+#define DEPTH_TILE_SHIFT 3
+#define DEPTH_TILE_SIZE (1 << DEPTH_TILE_SHIFT)
+
+/* farthest possible depth */
+#define DEPTH_FAR 0xFFFFFFFFUL
+
+/*
+ * depth buffer. depth values are unsigned 32-bit, nearer is smaller.
+ * 16 bpp buffers keep the top 16 bits of each value. tile_min and
+ * tile_max are conservative bounds per tile, NULL if not hierarchical
+ */
+typedef struct depth_t
+{
+	surface_t *surface;
+	int tiles_w;
+	int tiles_h;
+	uint32_t *tile_min;
+	uint32_t *tile_max;
+} depth_t;
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* depth buffer creation and destruction */
+depth_t *depth_create(int w, int h, int bpp, int hierarchical);
+void depth_destroy(depth_t *d);
+
+/* depth buffer modification */
+void depth_clear(depth_t *d, uint32_t z);
+void depth_refresh_tiles(depth_t *d);
+
+/* depth tested drawing */
+int depth_span_visible(depth_t *d, int x1, int x2, int y, uint32_t zmin);
+void depth_span(surface_t *s, depth_t *d, int x1, int x2, int y,
+	uint32_t z, int32_t dz, color_t *c);
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/*
+ * depth buffer creation and destruction
+ */
+
+/* create depth buffer of w by h pixels, bpp is 16 or 32 */
+depth_t *depth_create(int w, int h, int bpp, int hierarchical)
+{
+	/* variables */
+	depth_t *ret;
+	int n;
+
+	/* sanity checks */
+	if (w < 1 || h < 1) return NULL;
+	if (bpp != 16 && bpp != 32) return NULL;
+
+	/* alloc */
+	ret = (depth_t *)LIBREX_CALLOC(1, sizeof(depth_t));
+	if (!ret) return NULL;
+
+	/* depth storage */
+	ret->surface = surface_create(w, h, bpp, NULL);
+	if (!ret->surface)
+	{
+		depth_destroy(ret);
+		return NULL;
+	}
+
+	/* tile bounds */
+	if (hierarchical)
+	{
+		ret->tiles_w = (w + DEPTH_TILE_SIZE - 1) >> DEPTH_TILE_SHIFT;
+		ret->tiles_h = (h + DEPTH_TILE_SIZE - 1) >> DEPTH_TILE_SHIFT;
+		n = ret->tiles_w * ret->tiles_h;
+
+		ret->tile_min = (uint32_t *)LIBREX_CALLOC(n, sizeof(uint32_t));
+		ret->tile_max = (uint32_t *)LIBREX_CALLOC(n, sizeof(uint32_t));
+
+		if (!ret->tile_min || !ret->tile_max)
+		{
+			depth_destroy(ret);
+			return NULL;
+		}
+	}
+
+	/* start out at the far plane */
+	depth_clear(ret, DEPTH_FAR);
+
+	/* return ptr */
+	return ret;
+}
+
+/* destroy depth buffer and free all associated memory */
+void depth_destroy(depth_t *d)
+{
+	if (d)
+	{
+		if (d->surface)
+			surface_destroy(d->surface);
+
+		if (d->tile_min)
+			LIBREX_FREE(d->tile_min);
+
+		if (d->tile_max)
+			LIBREX_FREE(d->tile_max);
+
+		LIBREX_FREE(d);
+	}
+}
+
+/*
+ * depth buffer modification
+ */
+
+/* clear the depth buffer to z */
+void depth_clear(depth_t *d, uint32_t z)
+{
+	/* variables */
+	surface_t *s;
+	size_t n;
+
+	/* sanity checks */
+	if (!d || !d->surface) return;
+
+	s = d->surface;
+	n = (size_t)s->bytes_per_row * s->h;
+
+	/* shared depth is about to be overwritten, don't copy it */
+	if (!surface_unshare(s, 0)) return;
+
+	/* all bytes equal (near and far planes), plain memset */
+	if (s->bpp == 32 && (z == 0 || z == DEPTH_FAR))
+		memset(s->pixels, (int)(z & 0xFF), n);
+	else if (s->bpp == 16 && ((z >> 16) == 0 || (z >> 16) == 0xFFFF))
+		memset(s->pixels, (int)((z >> 16) & 0xFF), n);
+	else if (s->bpp == 32)
+		memset32(s->pixels, z, n / 4);
+	else
+		memset16(s->pixels, (uint16_t)(z >> 16), n / 2);
+
+	/* every tile is flat. 16 bpp bounds cover the truncated bits */
+	if (d->tile_min)
+	{
+		if (s->bpp == 16)
+		{
+			memset32(d->tile_min, z & 0xFFFF0000UL, d->tiles_w * d->tiles_h);
+			memset32(d->tile_max, z | 0xFFFF, d->tiles_w * d->tiles_h);
+		}
+		else
+		{
+			memset32(d->tile_min, z, d->tiles_w * d->tiles_h);
+			memset32(d->tile_max, z, d->tiles_w * d->tiles_h);
+		}
+	}
+}
+
+/* recompute exact tile bounds from the depth buffer */
+void depth_refresh_tiles(depth_t *d)
+{
+	/* variables */
+	surface_t *s;
+	int x, y, t;
+	uint32_t z;
+
+	/* sanity checks */
+	if (!d || !d->surface || !d->tile_min) return;
+
+	s = d->surface;
+
+	/* reset */
+	memset32(d->tile_min, DEPTH_FAR, d->tiles_w * d->tiles_h);
+	memset32(d->tile_max, 0, d->tiles_w * d->tiles_h);
+
+	/* gather */
+	for (y = 0; y < s->h; y++)
+	{
+		for (x = 0; x < s->w; x++)
+		{
+			if (s->bpp == 32)
+				z = ((uint32_t *)((uint8_t *)s->pixels + y * s->bytes_per_row))[x];
+			else
+				z = (uint32_t)((uint16_t *)((uint8_t *)s->pixels + y * s->bytes_per_row))[x] << 16;
+
+			t = (y >> DEPTH_TILE_SHIFT) * d->tiles_w + (x >> DEPTH_TILE_SHIFT);
+
+			if (z < d->tile_min[t]) d->tile_min[t] = z;
+			if (z > d->tile_max[t]) d->tile_max[t] = z;
+		}
+	}
+
+	/* 16 bpp values were truncated, widen the max to cover them */
+	if (s->bpp == 16)
+	{
+		for (t = 0; t < d->tiles_w * d->tiles_h; t++)
+			d->tile_max[t] |= 0xFFFF;
+	}
+}
+
+/*
+ * depth tested drawing
+ */
+
+/*
+ * returns 0 if a span from x1 to x2 (exclusive) on row y, whose nearest
+ * depth is zmin, is hidden behind everything in the tiles it touches.
+ * always returns 1 for non-hierarchical buffers
+ */
+int depth_span_visible(depth_t *d, int x1, int x2, int y, uint32_t zmin)
+{
+	/* variables */
+	uint32_t *tmax;
+	int t1, t2;
+
+	/* sanity checks */
+	if (!d || !d->tile_max) return 1;
+	if (y < 0 || y >= d->surface->h) return 0;
+
+	x1 = MAX(x1, 0);
+	x2 = MIN(x2, d->surface->w);
+	if (x1 >= x2) return 0;
+
+	/* walk the tiles covered by the span */
+	tmax = d->tile_max + (y >> DEPTH_TILE_SHIFT) * d->tiles_w;
+	t2 = (x2 - 1) >> DEPTH_TILE_SHIFT;
+
+	for (t1 = x1 >> DEPTH_TILE_SHIFT; t1 <= t2; t1++)
+	{
+		if (zmin < tmax[t1])
+			return 1;
+	}
+
+	return 0;
+}
+
+/*
+ * draw a span from x1 to x2 (exclusive) on row y with depth starting at z
+ * and stepping by dz per pixel. pixels nearer than the depth buffer are
+ * written to both s and d
+ */
+void depth_span(surface_t *s, depth_t *d, int x1, int x2, int y,
+	uint32_t z, int32_t dz, color_t *c)
+{
+	/* variables */
+	int x, n, t, t1, t2;
+	int64_t zlast;
+	uint32_t zmin, zmax, *tmin, cv;
+	uint8_t *crow, *drow;
+	uint32_t *dp32;
+	uint16_t *dp16, zz;
+	int pass;
+
+	/* sanity checks */
+	if (!s || !s->pixels || !d || !d->surface || !c) return;
+	if (s->w != d->surface->w || s->h != d->surface->h) return;
+	if (c->tag == INDEX8 && s->bpp != 8) return;
+	if (c->tag == RGB565 && s->bpp != 16) return;
+	if (c->tag == RGBA8888 && s->bpp != 32) return;
+	if (c->tag == ARGB8888 && s->bpp != 32) return;
+	if (y < s->clip.y1 || y >= s->clip.y2) return;
+
+	/* clip left, advancing depth */
+	if (x1 < s->clip.x1)
+	{
+		z += (uint32_t)dz * (uint32_t)(s->clip.x1 - x1);
+		x1 = s->clip.x1;
+	}
+
+	/* clip right */
+	x2 = MIN(x2, s->clip.x2);
+	if (x1 >= x2) return;
+
+	n = x2 - x1;
+
+	/* depth range of the span */
+	zlast = (int64_t)z + (int64_t)dz * (n - 1);
+	zlast = CLAMP(zlast, 0, (int64_t)DEPTH_FAR);
+	zmin = dz < 0 ? (uint32_t)zlast : z;
+	zmax = dz < 0 ? z : (uint32_t)zlast;
+
+	/* hierarchical rejection and trivial accept */
+	pass = 0;
+	if (d->tile_max)
+	{
+		if (!depth_span_visible(d, x1, x2, y, zmin))
+			return;
+
+		tmin = d->tile_min + (y >> DEPTH_TILE_SHIFT) * d->tiles_w;
+		t1 = x1 >> DEPTH_TILE_SHIFT;
+		t2 = (x2 - 1) >> DEPTH_TILE_SHIFT;
+
+		/* 16 bpp buffers only store the top bits */
+		if (d->surface->bpp == 16)
+			zmin &= 0xFFFF0000UL;
+
+		/* nearer than anything in the tiles means every pixel passes */
+		pass = 1;
+		for (t = t1; t <= t2; t++)
+		{
+			if (zmax >= tmin[t])
+				pass = 0;
+
+			if (zmin < tmin[t])
+				tmin[t] = zmin;
+		}
+	}
+
+	/* only spans that survived clipping and rejection unshare the buffers */
+	if (!surface_detach(s) || !surface_detach(d->surface)) return;
+
+	/* row pointers */
+	crow = (uint8_t *)s->pixels + y * s->bytes_per_row + x1 * (s->bpp / 8);
+	drow = (uint8_t *)d->surface->pixels + y * d->surface->bytes_per_row +
+		x1 * (d->surface->bpp / 8);
+
+	/* color value */
+	cv = s->bpp == 8 ? c->val.u8 : s->bpp == 16 ? c->val.u16 : c->val.u32;
+
+	/* trivially accepted, fill color and store depth without testing */
+	if (pass)
+	{
+		switch (s->bpp)
+		{
+			case 8: memset8(crow, (uint8_t)cv, n); break;
+			case 16: memset16(crow, (uint16_t)cv, n); break;
+			case 32: memset32(crow, cv, n); break;
+			default: break;
+		}
+
+		if (d->surface->bpp == 32)
+		{
+			for (x = 0; x < n; x++, z += (uint32_t)dz)
+				((uint32_t *)drow)[x] = z;
+		}
+		else
+		{
+			for (x = 0; x < n; x++, z += (uint32_t)dz)
+				((uint16_t *)drow)[x] = (uint16_t)(z >> 16);
+		}
+
+		return;
+	}
+
+	/* tested fill. one loop per depth and color size keeps them tight */
+	if (d->surface->bpp == 32)
+	{
+		dp32 = (uint32_t *)drow;
+
+		switch (s->bpp)
+		{
+			case 8:
+				for (x = 0; x < n; x++, z += (uint32_t)dz)
+				{
+					if (z < dp32[x])
+					{
+						dp32[x] = z;
+						crow[x] = (uint8_t)cv;
+					}
+				}
+				break;
+
+			case 16:
+				for (x = 0; x < n; x++, z += (uint32_t)dz)
+				{
+					if (z < dp32[x])
+					{
+						dp32[x] = z;
+						((uint16_t *)crow)[x] = (uint16_t)cv;
+					}
+				}
+				break;
+
+			case 32:
+				for (x = 0; x < n; x++, z += (uint32_t)dz)
+				{
+					if (z < dp32[x])
+					{
+						dp32[x] = z;
+						((uint32_t *)crow)[x] = cv;
+					}
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
+	else
+	{
+		dp16 = (uint16_t *)drow;
+
+		switch (s->bpp)
+		{
+			case 8:
+				for (x = 0; x < n; x++, z += (uint32_t)dz)
+				{
+					if ((zz = (uint16_t)(z >> 16)) < dp16[x])
+					{
+						dp16[x] = zz;
+						crow[x] = (uint8_t)cv;
+					}
+				}
+				break;
+
+			case 16:
+				for (x = 0; x < n; x++, z += (uint32_t)dz)
+				{
+					if ((zz = (uint16_t)(z >> 16)) < dp16[x])
+					{
+						dp16[x] = zz;
+						((uint16_t *)crow)[x] = (uint16_t)cv;
+					}
+				}
+				break;
+
+			case 32:
+				for (x = 0; x < n; x++, z += (uint32_t)dz)
+				{
+					if ((zz = (uint16_t)(z >> 16)) < dp16[x])
+					{
+						dp16[x] = zz;
+						((uint32_t *)crow)[x] = cv;
+					}
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_DEPTH_H__ */
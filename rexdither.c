@@ -0,0 +1,113 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexdither.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexdither.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* rex */
+#include "rexdither.h"
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	surface_t *src, *dst16, *dst8, *pal;
+	int x, y;
+
+	/* create surfaces */
+	src = surface_create(256, 64, 32, NULL);
+	dst16 = surface_create(256, 64, 16, NULL);
+	dst8 = surface_create(256, 64, 8, NULL);
+	pal = surface_create(16, 1, 32, NULL);
+
+	/* fill source with a horizontal gradient */
+	for (y = 0; y < src->h; y++)
+	{
+		for (x = 0; x < src->w; x++)
+		{
+			((uint32_t *)src->pixels)[y * src->w + x] =
+				pack_argb8888(x, x / 2, 255 - x, 255);
+		}
+	}
+
+	/* 16 shade grayscale palette */
+	for (x = 0; x < pal->w; x++)
+	{
+		((uint32_t *)pal->pixels)[x] =
+			pack_argb8888(x * 17, x * 17, x * 17, 255);
+	}
+
+	surface_set_palette(dst8, &pal);
+
+	/* print header */
+	printf("librex: rexdither.h test\n");
+	printf("\n");
+
+	/* rgb565 */
+	surface_dither_rgb565(src, dst16, DITHER_NONE);
+	printf("rgb565 none: %04x\n", ((uint16_t *)dst16->pixels)[129]);
+	surface_dump_buffer(dst16, "rgb565_none.data");
+
+	surface_dither_rgb565(src, dst16, DITHER_ORDERED);
+	printf("rgb565 ordered: %04x\n", ((uint16_t *)dst16->pixels)[129]);
+	surface_dump_buffer(dst16, "rgb565_ordered.data");
+
+	surface_dither_rgb565(src, dst16, DITHER_DIFFUSION);
+	printf("rgb565 diffusion: %04x\n", ((uint16_t *)dst16->pixels)[129]);
+	surface_dump_buffer(dst16, "rgb565_diffusion.data");
+
+	/* index8 */
+	surface_dither_index8(src, dst8, DITHER_ORDERED);
+	printf("index8 ordered: %u\n", ((uint8_t *)dst8->pixels)[129]);
+	surface_dump_buffer(dst8, "index8_ordered.data");
+
+	surface_dither_index8(src, dst8, DITHER_DIFFUSION);
+	printf("index8 diffusion: %u\n", ((uint8_t *)dst8->pixels)[129]);
+	surface_dump_buffer(dst8, "index8_diffusion.data");
+
+	/* destroy surfaces */
+	surface_destroy(src);
+	surface_destroy(dst16);
+	surface_destroy(dst8);
+	surface_destroy(pal);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
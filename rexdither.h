@@ -0,0 +1,460 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexdither.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: dithered surface down-conversion
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_DITHER_H__
+#define __LIBREX_DITHER_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexmath.h"
+#include "rexcolor.h"
+#include "rexsurface.h"
+
+#endif
+
+/* simd */
+#ifdef LIBREX_SSE2
+#include <emmintrin.h>
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+/*
+ * dithering modes. 32 bpp source surfaces are treated as ARGB8888 and
+ * alpha is discarded
+ */
+enum dither_mode
+{
+	DITHER_NONE,
+	DITHER_ORDERED,
+	DITHER_DIFFUSION
+};
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* down-conversion */
+void surface_dither_rgb565(surface_t *src, surface_t *dst, int mode);
+void surface_dither_index8(surface_t *src, surface_t *dst, int mode);
+
+/* palette helpers */
+int dither_load_palette(surface_t *pal, uint8_t *rgb);
+uint8_t dither_nearest_index(uint8_t *rgb, int n, int r, int g, int b);
+
+/* *************************************
+ *
+ * the data
+ *
+ * ********************************** */
+
+/* 4x4 bayer threshold matrix, 0 to 15 */
+static const uint8_t dither_bayer4[4][4] =
+{
+	{ 0,  8,  2, 10},
+	{12,  4, 14,  6},
+	{ 3, 11,  1,  9},
+	{15,  7, 13,  5}
+};
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/*
+ * internal helpers
+ */
+
+/* saturate a channel sum in the range 0 to 511 to 255, without branching */
+#define DITHER_SAT8(a) (((a) | (0 - ((a) >> 8))) & 0xFF)
+
+/* ordered dither one row of argb8888 pixels to rgb565 */
+static void dither_row_rgb565(uint32_t *src, uint16_t *dst, int w,
+	const uint32_t *bias)
+{
+	/* variables */
+	int x;
+	uint32_t p, d, r, g, b;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	{
+		/* variables */
+		__m128i v, o, bv;
+
+		/* x always starts on a multiple of 4, so one bias vector per row */
+		bv = _mm_set_epi32(bias[3], bias[2], bias[1], bias[0]);
+
+		for (; x + 4 <= w; x += 4)
+		{
+			/* saturating add of the threshold */
+			v = _mm_adds_epu8(_mm_loadu_si128((__m128i *)(src + x)), bv);
+
+			/* pack to rgb565 in each 32-bit lane */
+			o = _mm_and_si128(_mm_srli_epi32(v, 8), _mm_set1_epi32(0xF800));
+			o = _mm_or_si128(o, _mm_and_si128(_mm_srli_epi32(v, 5),
+				_mm_set1_epi32(0x07E0)));
+			o = _mm_or_si128(o, _mm_and_si128(_mm_srli_epi32(v, 3),
+				_mm_set1_epi32(0x001F)));
+
+			/* sign extend so the signed pack keeps the exact bits */
+			o = _mm_srai_epi32(_mm_slli_epi32(o, 16), 16);
+			_mm_storel_epi64((__m128i *)(dst + x), _mm_packs_epi32(o, o));
+		}
+	}
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < w; x++)
+	{
+		p = src[x];
+		d = bias[x & 3];
+
+		r = ((p >> 16) & 0xFF) + ((d >> 16) & 0xFF);
+		g = ((p >> 8) & 0xFF) + ((d >> 8) & 0xFF);
+		b = (p & 0xFF) + (d & 0xFF);
+
+		r = DITHER_SAT8(r);
+		g = DITHER_SAT8(g);
+		b = DITHER_SAT8(b);
+
+		dst[x] = (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+	}
+}
+
+/* error diffusion to rgb565 or a palette. rgb is NULL for rgb565 */
+static void dither_diffuse(surface_t *src, surface_t *dst, uint8_t *rgb, int n)
+{
+	/* variables */
+	int x, y, i;
+	int r, g, b, qr, qg, qb;
+	int *err, *cur, *next, *tmp;
+	uint32_t *srow, p;
+	uint8_t q;
+
+	/* two rows of rgb error with a guard pixel on either side */
+	err = (int *)LIBREX_CALLOC((src->w + 2) * 6, sizeof(int));
+	if (!err) return;
+
+	cur = err;
+	next = err + (src->w + 2) * 3;
+
+	for (y = 0; y < src->h; y++)
+	{
+		srow = (uint32_t *)((uint8_t *)src->pixels + y * src->bytes_per_row);
+
+		for (x = 0; x < src->w; x++)
+		{
+			/* accumulated error is stored in sixteenths */
+			p = srow[x];
+			i = (x + 1) * 3;
+
+			r = CLAMP((int)((p >> 16) & 0xFF) + cur[i + 0] / 16, 0, 255);
+			g = CLAMP((int)((p >> 8) & 0xFF) + cur[i + 1] / 16, 0, 255);
+			b = CLAMP((int)(p & 0xFF) + cur[i + 2] / 16, 0, 255);
+
+			/* quantize */
+			if (rgb)
+			{
+				q = dither_nearest_index(rgb, n, r, g, b);
+				((uint8_t *)dst->pixels)[y * dst->bytes_per_row + x] = q;
+
+				qr = rgb[q * 3 + 0];
+				qg = rgb[q * 3 + 1];
+				qb = rgb[q * 3 + 2];
+			}
+			else
+			{
+				qr = r >> 3;
+				qg = g >> 2;
+				qb = b >> 3;
+
+				((uint16_t *)((uint8_t *)dst->pixels + y * dst->bytes_per_row))[x] =
+					(uint16_t)((qr << 11) | (qg << 5) | qb);
+
+				qr = color_expand5[qr];
+				qg = color_expand6[qg];
+				qb = color_expand5[qb];
+			}
+
+			/* quantization error */
+			r -= qr;
+			g -= qg;
+			b -= qb;
+
+			/* floyd-steinberg weights: 7 right, 3 below left, 5 below, 1 below right */
+			cur[i + 3] += r * 7;
+			cur[i + 4] += g * 7;
+			cur[i + 5] += b * 7;
+
+			next[i - 3] += r * 3;
+			next[i - 2] += g * 3;
+			next[i - 1] += b * 3;
+
+			next[i + 0] += r * 5;
+			next[i + 1] += g * 5;
+			next[i + 2] += b * 5;
+
+			next[i + 3] += r;
+			next[i + 4] += g;
+			next[i + 5] += b;
+		}
+
+		/* swap rows and clear the new next row */
+		tmp = cur;
+		cur = next;
+		next = tmp;
+		memset(next, 0, (src->w + 2) * 3 * sizeof(int));
+	}
+
+	LIBREX_FREE(err);
+}
+
+/*
+ * down-conversion
+ */
+
+/* convert a 32 bpp surface to a 16 bpp rgb565 surface */
+void surface_dither_rgb565(surface_t *src, surface_t *dst, int mode)
+{
+	/* variables */
+	int x, y, t;
+	uint32_t bias[4][4];
+
+	/* sanity checks */
+	if (!src || !src->pixels || !dst || !dst->pixels) return;
+	if (src->bpp != 32 || dst->bpp != 16) return;
+	if (src->w != dst->w || src->h != dst->h) return;
+	if (!surface_detach(dst)) return;
+
+	/* error diffusion */
+	if (mode == DITHER_DIFFUSION)
+	{
+		dither_diffuse(src, dst, NULL, 0);
+		return;
+	}
+
+	/*
+	 * per-pixel thresholds packed as argb8888. red and blue lose 3 bits,
+	 * green loses 2, so the threshold is scaled to the dropped range.
+	 * DITHER_NONE uses a zero bias and runs the same kernel
+	 */
+	for (y = 0; y < 4; y++)
+	{
+		for (x = 0; x < 4; x++)
+		{
+			t = mode == DITHER_ORDERED ? dither_bayer4[y][x] : 0;
+			bias[y][x] = ((uint32_t)(t >> 1) << 16) |
+				((uint32_t)(t >> 2) << 8) | (uint32_t)(t >> 1);
+		}
+	}
+
+	/* convert rows */
+	for (y = 0; y < src->h; y++)
+	{
+		dither_row_rgb565(
+			(uint32_t *)((uint8_t *)src->pixels + y * src->bytes_per_row),
+			(uint16_t *)((uint8_t *)dst->pixels + y * dst->bytes_per_row),
+			src->w, bias[y & 3]);
+	}
+}
+
+/* convert a 32 bpp surface to an 8 bpp surface using the palette of dst */
+void surface_dither_index8(surface_t *src, surface_t *dst, int mode)
+{
+	/* variables */
+	int x, y, n, t;
+	uint8_t rgb[768];
+	uint32_t *srow, p;
+	uint8_t *drow;
+
+	/* sanity checks */
+	if (!src || !src->pixels || !dst || !dst->pixels) return;
+	if (src->bpp != 32 || dst->bpp != 8) return;
+	if (src->w != dst->w || src->h != dst->h) return;
+	if (!dst->palette || !*dst->palette) return;
+	if (!surface_detach(dst)) return;
+
+	/* load palette */
+	n = dither_load_palette(*dst->palette, rgb);
+	if (n < 1) return;
+
+	/* error diffusion */
+	if (mode == DITHER_DIFFUSION)
+	{
+		dither_diffuse(src, dst, rgb, n);
+		return;
+	}
+
+	/* ordered or no dithering, thresholds centered on zero */
+	for (y = 0; y < src->h; y++)
+	{
+		srow = (uint32_t *)((uint8_t *)src->pixels + y * src->bytes_per_row);
+		drow = (uint8_t *)dst->pixels + y * dst->bytes_per_row;
+
+		for (x = 0; x < src->w; x++)
+		{
+			p = srow[x];
+			t = mode == DITHER_ORDERED ? dither_bayer4[y & 3][x & 3] * 2 - 15 : 0;
+
+			drow[x] = dither_nearest_index(rgb, n,
+				CLAMP((int)((p >> 16) & 0xFF) + t, 0, 255),
+				CLAMP((int)((p >> 8) & 0xFF) + t, 0, 255),
+				CLAMP((int)(p & 0xFF) + t, 0, 255));
+		}
+	}
+}
+
+/*
+ * palette helpers
+ */
+
+/*
+ * unpack up to 256 palette entries to rgb triplets. 32 bpp palettes are
+ * argb8888, 16 bpp palettes are rgb565. returns the number of entries
+ */
+int dither_load_palette(surface_t *pal, uint8_t *rgb)
+{
+	/* variables */
+	int i, n;
+	uint16_t c16;
+	uint32_t c32;
+
+	/* sanity checks */
+	if (!pal || !pal->pixels || !rgb) return 0;
+
+	/* number of entries */
+	n = MIN(pal->w * pal->h, 256);
+
+	for (i = 0; i < n; i++)
+	{
+		if (pal->bpp == 32)
+		{
+			c32 = ((uint32_t *)pal->pixels)[i];
+			rgb[i * 3 + 0] = unpack_argb8888_red(c32);
+			rgb[i * 3 + 1] = unpack_argb8888_green(c32);
+			rgb[i * 3 + 2] = unpack_argb8888_blue(c32);
+		}
+		else if (pal->bpp == 16)
+		{
+			c16 = ((uint16_t *)pal->pixels)[i];
+			rgb[i * 3 + 0] = unpack_rgb565_red(c16);
+			rgb[i * 3 + 1] = unpack_rgb565_green(c16);
+			rgb[i * 3 + 2] = unpack_rgb565_blue(c16);
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	return n;
+}
+
+/* find the palette entry closest to the given color */
+uint8_t dither_nearest_index(uint8_t *rgb, int n, int r, int g, int b)
+{
+	/* variables */
+	int i, dr, dg, db, dist, best, best_dist;
+
+	best = 0;
+	best_dist = 0x7FFFFFFF;
+
+	for (i = 0; i < n; i++)
+	{
+		dr = r - rgb[i * 3 + 0];
+		dg = g - rgb[i * 3 + 1];
+		db = b - rgb[i * 3 + 2];
+		dist = dr * dr + dg * dg + db * db;
+
+		if (dist < best_dist)
+		{
+			best_dist = dist;
+			best = i;
+			if (!dist) break;
+		}
+	}
+
+	return (uint8_t)best;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_DITHER_H__ */
@@ -0,0 +1,163 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexfcolor.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexfcolor.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* rex */
+#include "rexfcolor.h"
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	static const char *modes[5] = {"over", "copy", "add", "multiply", "screen"};
+	surface_t *src, *dst;
+	fsurface_t *f32, *f16;
+	fcolor_t c;
+	uint32_t p[37], q[37];
+	float32 fp[37 * 4], d[4], s[4];
+	float16 h;
+	int i, m, errors;
+
+	/* print header */
+	printf("librex: rexfcolor.h test\n");
+	printf("\n");
+
+	/* half floats */
+	printf("half: 1.0 %04x, 65504 %04x, 70000 %04x, 1e-7 %04x, -0.5 %04x\n",
+		float16_from_float32(1.0f), float16_from_float32(65504.0f),
+		float16_from_float32(70000.0f), float16_from_float32(1e-7f),
+		float16_from_float32(-0.5f));
+
+	/* every finite half survives a round trip through float32 */
+	errors = 0;
+	for (i = 0; i < 65536; i++)
+	{
+		h = (float16)i;
+		if ((h & 0x7C00) == 0x7C00) continue;
+		if (float16_from_float32(float32_from_float16(h)) != h) errors++;
+	}
+	printf("half round trip errors: %d\n", errors);
+
+	/* 8-bit round trip, 37 pixels covers both the simd and scalar paths */
+	errors = 0;
+	for (m = 0; m < 256; m += 37)
+	{
+		for (i = 0; i < 37; i++)
+			p[i] = pack_argb8888((m + i) & 0xFF, (m + i * 3) & 0xFF,
+				(m + i * 7) & 0xFF, (m + i * 11) & 0xFF);
+
+		fcolor_from_argb8888_array(p, fp, 37);
+		fcolor_to_argb8888_array(fp, q, 37);
+
+		for (i = 0; i < 37; i++)
+		{
+			if (p[i] != q[i]) errors++;
+			if (fp[i * 4] != (float32)((p[i] >> 16) & 0xFF) / 255.0f) errors++;
+		}
+	}
+	printf("8-bit round trip errors: %d\n", errors);
+
+	/* clamping */
+	fp[0] = 1.5f; fp[1] = -0.25f; fp[2] = 0.5f; fp[3] = 1.0f;
+	fcolor_to_argb8888_array(fp, q, 1);
+	printf("clamped: %08x\n", (unsigned)q[0]);
+
+	printf("\n");
+
+	/* blend modes, half transparent orange onto opaque blue-gray */
+	for (m = FCOLOR_BLEND_OVER; m <= FCOLOR_BLEND_SCREEN; m++)
+	{
+		s[0] = 1.0f; s[1] = 0.5f; s[2] = 0.0f; s[3] = 0.5f;
+		d[0] = 0.25f; d[1] = 0.5f; d[2] = 0.75f; d[3] = 1.0f;
+		fcolor_blend_array(d, s, 1, m, 1.0f);
+		printf("%-8s %.4f %.4f %.4f %.4f\n", modes[m], d[0], d[1], d[2], d[3]);
+	}
+
+	printf("\n");
+
+	/* surfaces: a gradient added over itself, then exposed back down */
+	src = surface_create(67, 40, 32, NULL);
+	dst = surface_create(67, 40, 32, NULL);
+	f32 = fsurface_create(67, 40, FSURFACE_RGBA32F);
+	f16 = fsurface_create(67, 40, FSURFACE_RGBA16F);
+
+	for (i = 0; i < src->w * src->h; i++)
+	{
+		((uint32_t *)src->pixels)[i] = pack_argb8888((i % 67) * 255 / 66,
+			(i / 67) * 255 / 39, 128, 255);
+	}
+
+	fsurface_from_surface(f32, src);
+	fsurface_from_surface(f16, src);
+	fsurface_blend(f32, f16, 0, 0, FCOLOR_BLEND_ADD, 1.0f);
+
+	printf("hdr: %.4f\n", ((float32 *)f32->pixels)[66 * 4]);
+
+	c.r = c.g = c.b = 0.5f;
+	c.a = 1.0f;
+	fcolor_scale_array((float32 *)f32->pixels, f32->w * f32->h, &c);
+	fsurface_to_surface(f32, dst);
+
+	errors = 0;
+	for (i = 0; i < src->w * src->h; i++)
+		if (((uint32_t *)src->pixels)[i] != ((uint32_t *)dst->pixels)[i]) errors++;
+	printf("exposure round trip errors: %d\n", errors);
+
+	/* half surface cleared, then over a quarter of the float surface */
+	c.r = 2.0f; c.g = 0.0f; c.b = 0.0f; c.a = 0.5f;
+	fsurface_clear(f16, &c);
+	fsurface_blend(f32, f16, 40, 20, FCOLOR_BLEND_OVER, 1.0f);
+	fsurface_to_surface(f32, dst);
+	printf("over: %08x %08x\n", (unsigned)((uint32_t *)dst->pixels)[0],
+		(unsigned)((uint32_t *)dst->pixels)[39 * 67 + 66]);
+
+	surface_dump_buffer(dst, "fcolor.data");
+
+	/* destroy surfaces */
+	fsurface_destroy(f32);
+	fsurface_destroy(f16);
+	surface_destroy(src);
+	surface_destroy(dst);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,792 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexfcolor.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: float color buffers and conversion
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_FCOLOR_H__
+#define __LIBREX_FCOLOR_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexmath.h"
+#include "rexfloat.h"
+#include "rexcolor.h"
+#include "rexsurface.h"
+
+#endif
+
+/* simd */
+#ifdef LIBREX_SSE2
+#include <emmintrin.h>
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+/* a normalized color, 0 to 1 for the 8-bit range but free to go above */
+typedef struct fcolor_t
+{
+	float32 r, g, b, a;
+} fcolor_t;
+
+/*
+ * float surface formats. both hold r, g, b and a in that order in memory,
+ * with straight alpha
+ */
+enum fsurface_format
+{
+	FSURFACE_RGBA32F,		/* four float32 per pixel */
+	FSURFACE_RGBA16F		/* four half floats per pixel */
+};
+
+/* float blend modes, the same set as the 8-bit ones in rexblend.h */
+enum fcolor_blend_mode
+{
+	FCOLOR_BLEND_OVER,
+	FCOLOR_BLEND_COPY,
+	FCOLOR_BLEND_ADD,
+	FCOLOR_BLEND_MULTIPLY,
+	FCOLOR_BLEND_SCREEN
+};
+
+/* float surface */
+typedef struct fsurface_t
+{
+	int w;
+	int h;
+	int format;
+	int bytes_per_row;
+	void *pixels;
+} fsurface_t;
+
+/* pixels converted per pass when a half float row goes through float32 */
+#define FCOLOR_CHUNK 64
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* half floats */
+float16 float16_from_float32(float32 f);
+float32 float32_from_float16(float16 h);
+void fcolor_to_half_array(float32 *src, float16 *dst, int n);
+void fcolor_from_half_array(float16 *src, float32 *dst, int n);
+
+/* 8-bit conversion */
+void fcolor_from_argb8888_array(uint32_t *src, float32 *dst, int n);
+void fcolor_to_argb8888_array(float32 *src, uint32_t *dst, int n);
+
+/* blend kernels */
+void fcolor_blend_array(float32 *dst, float32 *src, int n, int mode,
+	float32 opacity);
+void fcolor_scale_array(float32 *dst, int n, fcolor_t *k);
+
+/* float surface creation and destruction */
+fsurface_t *fsurface_create(int w, int h, int format);
+void fsurface_destroy(fsurface_t *s);
+
+/* float surface operations */
+void fsurface_clear(fsurface_t *s, fcolor_t *c);
+void fsurface_from_surface(fsurface_t *dst, surface_t *src);
+void fsurface_to_surface(fsurface_t *src, surface_t *dst);
+void fsurface_blend(fsurface_t *dst, fsurface_t *src, int dx, int dy,
+	int mode, float32 opacity);
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/*
+ * half floats
+ */
+
+/* float32 bits */
+typedef union fcolor_bits_t
+{
+	float32 f;
+	uint32_t u;
+} fcolor_bits_t;
+
+/*
+ * convert a float32 to a half float, rounding to nearest even. values too
+ * large become infinity and nans stay nans
+ */
+float16 float16_from_float32(float32 f)
+{
+	/* variables */
+	fcolor_bits_t v;
+	uint32_t sign, mant, rem, half, h;
+	int e, shift;
+
+	v.f = f;
+	sign = (v.u >> 16) & 0x8000;
+	mant = v.u & 0x7FFFFF;
+	e = (int)((v.u >> 23) & 0xFF);
+
+	/* infinity and nan */
+	if (e == 0xFF)
+		return (float16)(sign | 0x7C00 | (mant ? 0x200 | (mant >> 13) : 0));
+
+	e = e - 127 + 15;
+
+	/* overflow */
+	if (e >= 31)
+		return (float16)(sign | 0x7C00);
+
+	/* subnormal or zero */
+	if (e <= 0)
+	{
+		if (e < -10) return (float16)sign;
+
+		mant |= 0x800000;
+		shift = 14 - e;
+		h = mant >> shift;
+		rem = mant & ((1UL << shift) - 1);
+		half = 1UL << (shift - 1);
+
+		if (rem > half || (rem == half && (h & 1))) h++;
+
+		return (float16)(sign | h);
+	}
+
+	/* normal, a carry out of the mantissa correctly bumps the exponent */
+	h = ((uint32_t)e << 10) | (mant >> 13);
+	rem = mant & 0x1FFF;
+
+	if (rem > 0x1000 || (rem == 0x1000 && (h & 1))) h++;
+
+	return (float16)(sign | h);
+}
+
+/* convert a half float to a float32, exactly */
+float32 float32_from_float16(float16 h)
+{
+	/* variables */
+	fcolor_bits_t v;
+	uint32_t sign, mant;
+	int e;
+
+	sign = ((uint32_t)h & 0x8000) << 16;
+	mant = h & 0x3FF;
+	e = (h >> 10) & 0x1F;
+
+	if (e == 0)
+	{
+		if (mant == 0)
+		{
+			v.u = sign;
+		}
+		else
+		{
+			/* normalize a subnormal */
+			e = 1;
+			while (!(mant & 0x400))
+			{
+				mant <<= 1;
+				e--;
+			}
+
+			v.u = sign | ((uint32_t)(e + 127 - 15) << 23) | ((mant & 0x3FF) << 13);
+		}
+	}
+	else if (e == 31)
+	{
+		v.u = sign | 0x7F800000 | (mant << 13);
+	}
+	else
+	{
+		v.u = sign | ((uint32_t)(e + 127 - 15) << 23) | (mant << 13);
+	}
+
+	return v.f;
+}
+
+/* convert n float32 values to half floats */
+void fcolor_to_half_array(float32 *src, float16 *dst, int n)
+{
+	/* variables */
+	int i;
+
+	/* sanity checks */
+	if (!src || !dst) return;
+
+	for (i = 0; i < n; i++)
+		dst[i] = float16_from_float32(src[i]);
+}
+
+/* convert n half floats to float32 values */
+void fcolor_from_half_array(float16 *src, float32 *dst, int n)
+{
+	/* variables */
+	int i;
+
+	/* sanity checks */
+	if (!src || !dst) return;
+
+	for (i = 0; i < n; i++)
+		dst[i] = float32_from_float16(src[i]);
+}
+
+/*
+ * 8-bit conversion
+ */
+
+/*
+ * expand n argb8888 pixels to r, g, b, a float32 quads. each channel is
+ * divided by 255 on both paths, so 255 is exactly 1
+ */
+void fcolor_from_argb8888_array(uint32_t *src, float32 *dst, int n)
+{
+	/* variables */
+	int x;
+	uint32_t p;
+
+	/* sanity checks */
+	if (!src || !dst) return;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	{
+		/* variables */
+		__m128i z, p4, lo, hi;
+		__m128 scale;
+
+		z = _mm_setzero_si128();
+		scale = _mm_set1_ps(255.0f);
+
+		for (; x + 4 <= n; x += 4)
+		{
+			p4 = _mm_loadu_si128((__m128i *)(src + x));
+			lo = _mm_unpacklo_epi8(p4, z);
+			hi = _mm_unpackhi_epi8(p4, z);
+
+			/* one pixel per register, b, g, r, a swizzled to r, g, b, a */
+			_mm_storeu_ps(dst + x * 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_shuffle_epi32(
+				_mm_unpacklo_epi16(lo, z), _MM_SHUFFLE(3, 0, 1, 2))), scale));
+			_mm_storeu_ps(dst + x * 4 + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_shuffle_epi32(
+				_mm_unpackhi_epi16(lo, z), _MM_SHUFFLE(3, 0, 1, 2))), scale));
+			_mm_storeu_ps(dst + x * 4 + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_shuffle_epi32(
+				_mm_unpacklo_epi16(hi, z), _MM_SHUFFLE(3, 0, 1, 2))), scale));
+			_mm_storeu_ps(dst + x * 4 + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_shuffle_epi32(
+				_mm_unpackhi_epi16(hi, z), _MM_SHUFFLE(3, 0, 1, 2))), scale));
+		}
+	}
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < n; x++)
+	{
+		p = src[x];
+		dst[x * 4 + 0] = (float32)((p >> 16) & 0xFF) / 255.0f;
+		dst[x * 4 + 1] = (float32)((p >> 8) & 0xFF) / 255.0f;
+		dst[x * 4 + 2] = (float32)(p & 0xFF) / 255.0f;
+		dst[x * 4 + 3] = (float32)((p >> 24) & 0xFF) / 255.0f;
+	}
+}
+
+/*
+ * a channel clamped to 0..1 and rounded to 8 bits. the compares are
+ * ordered like minps and maxps, so nan goes to 255 on both paths
+ */
+#define FCOLOR_TO_BYTE(v) \
+	((uint32_t)(((v) < 1.0f ? ((v) > 0.0f ? (v) : 0.0f) : 1.0f) * 255.0f + 0.5f))
+
+/* pack n r, g, b, a float32 quads down to argb8888, clamped and rounded */
+void fcolor_to_argb8888_array(float32 *src, uint32_t *dst, int n)
+{
+	/* variables */
+	int x;
+	float32 *s;
+
+	/* sanity checks */
+	if (!src || !dst) return;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	{
+		/* variables */
+		__m128 zero, one, scale, half;
+		__m128i v[4];
+		int k;
+
+		zero = _mm_setzero_ps();
+		one = _mm_set1_ps(1.0f);
+		scale = _mm_set1_ps(255.0f);
+		half = _mm_set1_ps(0.5f);
+
+		for (; x + 4 <= n; x += 4)
+		{
+			for (k = 0; k < 4; k++)
+			{
+				v[k] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_max_ps(
+					_mm_min_ps(_mm_loadu_ps(src + (x + k) * 4), one), zero),
+					scale), half));
+				v[k] = _mm_shuffle_epi32(v[k], _MM_SHUFFLE(3, 0, 1, 2));
+			}
+
+			_mm_storeu_si128((__m128i *)(dst + x), _mm_packus_epi16(
+				_mm_packs_epi32(v[0], v[1]), _mm_packs_epi32(v[2], v[3])));
+		}
+	}
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < n; x++)
+	{
+		s = src + x * 4;
+		dst[x] = (FCOLOR_TO_BYTE(s[3]) << 24) | (FCOLOR_TO_BYTE(s[0]) << 16) |
+			(FCOLOR_TO_BYTE(s[1]) << 8) | FCOLOR_TO_BYTE(s[2]);
+	}
+}
+
+/*
+ * blend kernels
+ */
+
+/*
+ * blend n src pixels onto dst. the src alpha times opacity moves each
+ * channel of dst towards a target: src for over and copy, dst plus src for
+ * add, their product for multiply and their screen for screen. the alpha
+ * target is 1, giving the usual a + da * (1 - a). copy uses opacity alone
+ * and takes src alpha as is. colors are not clamped, so add can go above 1
+ */
+void fcolor_blend_array(float32 *dst, float32 *src, int n, int mode,
+	float32 opacity)
+{
+	/* variables */
+	int x, c;
+	float32 a, t, *s, *d;
+
+	/* sanity checks */
+	if (!dst || !src) return;
+	if (mode < FCOLOR_BLEND_OVER || mode > FCOLOR_BLEND_SCREEN) return;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	{
+		/* variables */
+		__m128 vs, vd, va, vt, op, rgb, alpha;
+
+		op = _mm_set1_ps(opacity);
+		rgb = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+		alpha = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+		for (; x < n; x++)
+		{
+			vs = _mm_loadu_ps(src + x * 4);
+			vd = _mm_loadu_ps(dst + x * 4);
+
+			switch (mode)
+			{
+				case FCOLOR_BLEND_COPY:
+					va = op;
+					vt = vs;
+					break;
+				case FCOLOR_BLEND_ADD:
+					vt = _mm_add_ps(vd, vs);
+					break;
+				case FCOLOR_BLEND_MULTIPLY:
+					vt = _mm_mul_ps(vd, vs);
+					break;
+				case FCOLOR_BLEND_SCREEN:
+					vt = _mm_sub_ps(_mm_add_ps(vs, vd), _mm_mul_ps(vs, vd));
+					break;
+				default:
+					vt = vs;
+					break;
+			}
+
+			if (mode != FCOLOR_BLEND_COPY)
+			{
+				va = _mm_mul_ps(_mm_shuffle_ps(vs, vs, 0xFF), op);
+				vt = _mm_or_ps(_mm_and_ps(vt, rgb), alpha);
+			}
+
+			_mm_storeu_ps(dst + x * 4, _mm_add_ps(vd,
+				_mm_mul_ps(_mm_sub_ps(vt, vd), va)));
+		}
+	}
+#endif
+
+	/* scalar path, the same operations in the same order */
+	for (; x < n; x++)
+	{
+		s = src + x * 4;
+		d = dst + x * 4;
+
+		a = mode == FCOLOR_BLEND_COPY ? opacity : s[3] * opacity;
+
+		for (c = 0; c < 3; c++)
+		{
+			switch (mode)
+			{
+				case FCOLOR_BLEND_ADD: t = d[c] + s[c]; break;
+				case FCOLOR_BLEND_MULTIPLY: t = d[c] * s[c]; break;
+				case FCOLOR_BLEND_SCREEN: t = (s[c] + d[c]) - s[c] * d[c]; break;
+				default: t = s[c]; break;
+			}
+
+			d[c] = d[c] + (t - d[c]) * a;
+		}
+
+		t = mode == FCOLOR_BLEND_COPY ? s[3] : 1.0f;
+		d[3] = d[3] + (t - d[3]) * a;
+	}
+}
+
+/* multiply each channel of n pixels by k, for exposure and tinting */
+void fcolor_scale_array(float32 *dst, int n, fcolor_t *k)
+{
+	/* variables */
+	int x;
+
+	/* sanity checks */
+	if (!dst || !k) return;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	{
+		/* variables */
+		__m128 vk;
+
+		vk = _mm_set_ps(k->a, k->b, k->g, k->r);
+
+		for (; x < n; x++)
+			_mm_storeu_ps(dst + x * 4, _mm_mul_ps(_mm_loadu_ps(dst + x * 4), vk));
+	}
+#endif
+
+	/* scalar path */
+	for (; x < n; x++)
+	{
+		dst[x * 4 + 0] *= k->r;
+		dst[x * 4 + 1] *= k->g;
+		dst[x * 4 + 2] *= k->b;
+		dst[x * 4 + 3] *= k->a;
+	}
+}
+
+/*
+ * float surface creation and destruction
+ */
+
+/* create a float surface with every channel zero */
+fsurface_t *fsurface_create(int w, int h, int format)
+{
+	/* variables */
+	fsurface_t *ret;
+	int size;
+
+	/* sanity checks */
+	if (w < 1 || h < 1) return NULL;
+	if (format != FSURFACE_RGBA32F && format != FSURFACE_RGBA16F) return NULL;
+
+	/* alloc */
+	ret = LIBREX_CALLOC(1, sizeof(fsurface_t));
+	if (!ret) return NULL;
+
+	size = format == FSURFACE_RGBA32F ? sizeof(float32) : sizeof(float16);
+
+	ret->w = w;
+	ret->h = h;
+	ret->format = format;
+	ret->bytes_per_row = w * 4 * size;
+
+	/* all bits zero is 0.0 in both formats */
+	ret->pixels = LIBREX_CALLOC(w * h * 4, size);
+	if (!ret->pixels)
+	{
+		LIBREX_FREE(ret);
+		return NULL;
+	}
+
+	return ret;
+}
+
+/* destroy float surface and free all associated memory */
+void fsurface_destroy(fsurface_t *s)
+{
+	if (s)
+	{
+		if (s->pixels) LIBREX_FREE(s->pixels);
+		LIBREX_FREE(s);
+	}
+}
+
+/*
+ * float surface operations
+ */
+
+/* pointer to the first channel of pixel x, y */
+#define FSURFACE_PTR(s, x, y) ((uint8_t *)(s)->pixels + \
+	(y) * (s)->bytes_per_row + (x) * ((s)->format == FSURFACE_RGBA32F ? \
+	4 * sizeof(float32) : 4 * sizeof(float16)))
+
+/*
+ * n pixels of s at x, y as float32 quads. rgba32f rows are used in place,
+ * rgba16f rows are widened into tmp, which holds FCOLOR_CHUNK pixels
+ */
+static float32 *fsurface_row_load(fsurface_t *s, int x, int y, int n,
+	float32 *tmp)
+{
+	if (s->format == FSURFACE_RGBA32F)
+		return (float32 *)FSURFACE_PTR(s, x, y);
+
+	fcolor_from_half_array((float16 *)FSURFACE_PTR(s, x, y), tmp, n * 4);
+
+	return tmp;
+}
+
+/* write back a row from fsurface_row_load once it has been changed */
+static void fsurface_row_store(fsurface_t *s, int x, int y, int n,
+	float32 *row)
+{
+	if (s->format == FSURFACE_RGBA16F)
+		fcolor_to_half_array(row, (float16 *)FSURFACE_PTR(s, x, y), n * 4);
+}
+
+/* set every pixel of s to c */
+void fsurface_clear(fsurface_t *s, fcolor_t *c)
+{
+	/* variables */
+	float32 row[FCOLOR_CHUNK * 4];
+	int x, y, n;
+
+	/* sanity checks */
+	if (!s || !s->pixels || !c) return;
+
+	for (x = 0; x < FCOLOR_CHUNK; x++)
+	{
+		row[x * 4 + 0] = c->r;
+		row[x * 4 + 1] = c->g;
+		row[x * 4 + 2] = c->b;
+		row[x * 4 + 3] = c->a;
+	}
+
+	for (y = 0; y < s->h; y++)
+	{
+		for (x = 0; x < s->w; x += n)
+		{
+			n = MIN(FCOLOR_CHUNK, s->w - x);
+
+			if (s->format == FSURFACE_RGBA32F)
+				memcpy(FSURFACE_PTR(s, x, y), row, n * 4 * sizeof(float32));
+			else
+				fsurface_row_store(s, x, y, n, row);
+		}
+	}
+}
+
+/*
+ * convert the 32 bpp argb8888 or 16 bpp rgb565 surface src into dst, over
+ * the area both have in common from the top left
+ */
+void fsurface_from_surface(fsurface_t *dst, surface_t *src)
+{
+	/* variables */
+	uint32_t argb[FCOLOR_CHUNK];
+	float32 tmp[FCOLOR_CHUNK * 4];
+	float32 *row;
+	uint8_t *s;
+	int x, y, n, w, h;
+
+	/* sanity checks */
+	if (!dst || !dst->pixels || !src || !src->pixels) return;
+	if (src->bpp != 16 && src->bpp != 32) return;
+
+	w = MIN(dst->w, src->w);
+	h = MIN(dst->h, src->h);
+
+	for (y = 0; y < h; y++)
+	{
+		for (x = 0; x < w; x += n)
+		{
+			n = MIN(FCOLOR_CHUNK, w - x);
+			s = SURFACE_PTR(src, x, y);
+
+			/* rgb565 goes through the exact expansion tables first */
+			if (src->bpp == 16)
+			{
+				expand_rgb565_array((uint16_t *)s, argb, n);
+				s = (uint8_t *)argb;
+			}
+
+			row = dst->format == FSURFACE_RGBA32F ?
+				(float32 *)FSURFACE_PTR(dst, x, y) : tmp;
+
+			fcolor_from_argb8888_array((uint32_t *)s, row, n);
+			fsurface_row_store(dst, x, y, n, row);
+		}
+	}
+}
+
+/*
+ * convert src into the 32 bpp argb8888 surface dst, clamped and rounded,
+ * over the area both have in common from the top left, within the clip
+ * rectangle of dst
+ */
+void fsurface_to_surface(fsurface_t *src, surface_t *dst)
+{
+	/* variables */
+	float32 tmp[FCOLOR_CHUNK * 4];
+	int x, y, n, x2, y2;
+
+	/* sanity checks */
+	if (!src || !src->pixels || !dst || !dst->pixels) return;
+	if (dst->bpp != 32) return;
+
+	/* clip */
+	x2 = MIN(dst->clip.x2, src->w);
+	y2 = MIN(dst->clip.y2, src->h);
+
+	/* fully clipped */
+	if (dst->clip.x1 >= x2 || dst->clip.y1 >= y2) return;
+	if (!surface_detach(dst)) return;
+
+	for (y = dst->clip.y1; y < y2; y++)
+	{
+		for (x = dst->clip.x1; x < x2; x += n)
+		{
+			n = MIN(FCOLOR_CHUNK, x2 - x);
+			fcolor_to_argb8888_array(fsurface_row_load(src, x, y, n, tmp),
+				(uint32_t *)SURFACE_PTR(dst, x, y), n);
+		}
+	}
+}
+
+/*
+ * blend src onto dst at dx, dy with one of the fcolor_blend_mode modes,
+ * clipped to dst. the formats of the two may differ, and src may be dst
+ */
+void fsurface_blend(fsurface_t *dst, fsurface_t *src, int dx, int dy,
+	int mode, float32 opacity)
+{
+	/* variables */
+	float32 stmp[FCOLOR_CHUNK * 4], dtmp[FCOLOR_CHUNK * 4];
+	float32 *s, *d;
+	int i, j, x, y, n, sx, sy, w, h, up, left;
+
+	/* sanity checks */
+	if (!dst || !dst->pixels || !src || !src->pixels) return;
+
+	/* clip */
+	sx = MAX(-dx, 0);
+	sy = MAX(-dy, 0);
+	w = MIN(src->w, dst->w - dx) - sx;
+	h = MIN(src->h, dst->h - dy) - sy;
+	if (w < 1 || h < 1) return;
+
+	/*
+	 * onto itself, rows are walked bottom up when moving down and chunks
+	 * right to left when moving right, so nothing is read after it has
+	 * been blended. each src chunk is copied so it can't overlap its dst
+	 */
+	up = src == dst && dy > 0;
+	left = src == dst && dy == 0 && dx > 0;
+
+	for (i = 0; i < h; i++)
+	{
+		y = up ? sy + h - 1 - i : sy + i;
+
+		for (j = 0; j < w; j += n)
+		{
+			n = MIN(FCOLOR_CHUNK, w - j);
+			x = left ? sx + w - j - n : sx + j;
+
+			s = fsurface_row_load(src, x, y, n, stmp);
+			if (src == dst && s != stmp)
+			{
+				memcpy(stmp, s, n * 4 * sizeof(float32));
+				s = stmp;
+			}
+
+			d = fsurface_row_load(dst, dx + x, dy + y, n, dtmp);
+			fcolor_blend_array(d, s, n, mode, opacity);
+			fsurface_row_store(dst, dx + x, dy + y, n, d);
+		}
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_FCOLOR_H__ */
@@ -73,6 +73,7 @@ extern "C" {
 
 typedef float float32;				/* 32-bit float */
 typedef double float64;				/* 64-bit float */
+typedef uint16_t float16;			/* 16-bit half float bits */
 
 /* 32-bit float static initialization macros */
 #define FLOAT32(a) ((float32)(a))
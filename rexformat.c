@@ -0,0 +1,112 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexformat.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexformat.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* rex */
+#include "rexformat.h"
+
+/* names of the built in formats */
+static const char *names[FORMAT_COUNT] = {
+	"rgb565", "rgb888", "rgba8888", "argb8888",
+	"xrgb8888", "bgra8888", "rgba4444", "rgba5551"
+};
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	uint32_t src[64], tmp[64], fast[64], slow[64], back[64];
+	uint8_t r, g, b, a;
+	int i, s, d, errors;
+
+	/* print header */
+	printf("librex: rexformat.h test\n");
+	printf("\n");
+
+	/* argb8888 test pixels */
+	for (i = 0; i < 64; i++)
+		src[i] = pack_argb8888(i * 4, 255 - i * 3, i * 37, i * 8 + 3);
+
+	/* specialised and generic converters must agree for every pair */
+	errors = 0;
+
+	for (s = 0; s < FORMAT_COUNT; s++)
+	{
+		format_convert(FORMAT_ARGB8888, src, s, tmp, 64);
+
+		for (d = 0; d < FORMAT_COUNT; d++)
+		{
+			memset(fast, 0, sizeof(fast));
+			memset(slow, 0, sizeof(slow));
+
+			format_get_converter(s, d)(tmp, fast, 64);
+			format_convert_generic(format_get(s), tmp, format_get(d), slow, 64);
+
+			if (memcmp(fast, slow, sizeof(fast)) != 0)
+			{
+				printf("mismatch: %s to %s\n", names[s], names[d]);
+				errors++;
+			}
+		}
+	}
+
+	printf("pairs checked: %d, errors: %d\n", FORMAT_COUNT * FORMAT_COUNT, errors);
+
+	/* every format, round tripped back to argb8888 */
+	for (s = 0; s < FORMAT_COUNT; s++)
+	{
+		format_convert(FORMAT_ARGB8888, src, s, tmp, 64);
+		format_convert(s, tmp, FORMAT_ARGB8888, back, 64);
+		printf("%s: %08x -> %08x\n", names[s], src[21], back[21]);
+	}
+
+	/* an external framebuffer described by masks */
+	i = format_find(32, 0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF);
+	printf("find bgra8888: %s\n", i >= 0 ? names[i] : "none");
+
+	format_unpack(format_get(FORMAT_RGBA5551), format_pack(format_get(FORMAT_RGBA5551),
+		200, 100, 50, 255), &r, &g, &b, &a);
+	printf("rgba5551: %u %u %u %u\n", r, g, b, a);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
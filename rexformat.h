@@ -0,0 +1,587 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexformat.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: descriptor driven pixel formats and converters
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_FORMAT_H__
+#define __LIBREX_FORMAT_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexcolor.h"
+
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+/*
+ * the built in formats. names follow the packed value from the high bits
+ * down, the same as RGB565 and ARGB8888 in color_t. RGB888 is three bytes,
+ * blue first in memory. XRGB8888 ignores the top byte and writes it as 0xFF
+ */
+enum format_id
+{
+	FORMAT_RGB565,
+	FORMAT_RGB888,
+	FORMAT_RGBA8888,
+	FORMAT_ARGB8888,
+	FORMAT_XRGB8888,
+	FORMAT_BGRA8888,
+	FORMAT_RGBA4444,
+	FORMAT_RGBA5551,
+	FORMAT_COUNT
+};
+
+/* a pixel format described by bits per pixel, masks and shifts */
+typedef struct format_t
+{
+	int bpp;
+	uint32_t rmask, gmask, bmask, amask;
+	int rshift, gshift, bshift, ashift;
+	int rbits, gbits, bbits, abits;
+	uint32_t fill;
+} format_t;
+
+/* converts n pixels from one buffer to another */
+typedef void (*format_converter_t)(void *src, void *dst, int n);
+
+/*
+ * compile time descriptors. each format has bpp, shift and bits per
+ * channel, a fill value for bits no channel owns, and a load and store
+ */
+
+/* rgb565 */
+#define FORMAT_RGB565_BPP 16
+#define FORMAT_RGB565_RSHIFT 11
+#define FORMAT_RGB565_GSHIFT 5
+#define FORMAT_RGB565_BSHIFT 0
+#define FORMAT_RGB565_ASHIFT 0
+#define FORMAT_RGB565_RBITS 5
+#define FORMAT_RGB565_GBITS 6
+#define FORMAT_RGB565_BBITS 5
+#define FORMAT_RGB565_ABITS 0
+#define FORMAT_RGB565_FILL 0
+#define FORMAT_RGB565_LOAD(p, i) FORMAT_LOAD16(p, i)
+#define FORMAT_RGB565_STORE(p, i, v) FORMAT_STORE16(p, i, v)
+
+/* rgb888 */
+#define FORMAT_RGB888_BPP 24
+#define FORMAT_RGB888_RSHIFT 16
+#define FORMAT_RGB888_GSHIFT 8
+#define FORMAT_RGB888_BSHIFT 0
+#define FORMAT_RGB888_ASHIFT 0
+#define FORMAT_RGB888_RBITS 8
+#define FORMAT_RGB888_GBITS 8
+#define FORMAT_RGB888_BBITS 8
+#define FORMAT_RGB888_ABITS 0
+#define FORMAT_RGB888_FILL 0
+#define FORMAT_RGB888_LOAD(p, i) FORMAT_LOAD24(p, i)
+#define FORMAT_RGB888_STORE(p, i, v) FORMAT_STORE24(p, i, v)
+
+/* rgba8888 */
+#define FORMAT_RGBA8888_BPP 32
+#define FORMAT_RGBA8888_RSHIFT 24
+#define FORMAT_RGBA8888_GSHIFT 16
+#define FORMAT_RGBA8888_BSHIFT 8
+#define FORMAT_RGBA8888_ASHIFT 0
+#define FORMAT_RGBA8888_RBITS 8
+#define FORMAT_RGBA8888_GBITS 8
+#define FORMAT_RGBA8888_BBITS 8
+#define FORMAT_RGBA8888_ABITS 8
+#define FORMAT_RGBA8888_FILL 0
+#define FORMAT_RGBA8888_LOAD(p, i) FORMAT_LOAD32(p, i)
+#define FORMAT_RGBA8888_STORE(p, i, v) FORMAT_STORE32(p, i, v)
+
+/* argb8888 */
+#define FORMAT_ARGB8888_BPP 32
+#define FORMAT_ARGB8888_RSHIFT 16
+#define FORMAT_ARGB8888_GSHIFT 8
+#define FORMAT_ARGB8888_BSHIFT 0
+#define FORMAT_ARGB8888_ASHIFT 24
+#define FORMAT_ARGB8888_RBITS 8
+#define FORMAT_ARGB8888_GBITS 8
+#define FORMAT_ARGB8888_BBITS 8
+#define FORMAT_ARGB8888_ABITS 8
+#define FORMAT_ARGB8888_FILL 0
+#define FORMAT_ARGB8888_LOAD(p, i) FORMAT_LOAD32(p, i)
+#define FORMAT_ARGB8888_STORE(p, i, v) FORMAT_STORE32(p, i, v)
+
+/* xrgb8888 */
+#define FORMAT_XRGB8888_BPP 32
+#define FORMAT_XRGB8888_RSHIFT 16
+#define FORMAT_XRGB8888_GSHIFT 8
+#define FORMAT_XRGB8888_BSHIFT 0
+#define FORMAT_XRGB8888_ASHIFT 0
+#define FORMAT_XRGB8888_RBITS 8
+#define FORMAT_XRGB8888_GBITS 8
+#define FORMAT_XRGB8888_BBITS 8
+#define FORMAT_XRGB8888_ABITS 0
+#define FORMAT_XRGB8888_FILL 0xFF000000
+#define FORMAT_XRGB8888_LOAD(p, i) FORMAT_LOAD32(p, i)
+#define FORMAT_XRGB8888_STORE(p, i, v) FORMAT_STORE32(p, i, v)
+
+/* bgra8888 */
+#define FORMAT_BGRA8888_BPP 32
+#define FORMAT_BGRA8888_RSHIFT 8
+#define FORMAT_BGRA8888_GSHIFT 16
+#define FORMAT_BGRA8888_BSHIFT 24
+#define FORMAT_BGRA8888_ASHIFT 0
+#define FORMAT_BGRA8888_RBITS 8
+#define FORMAT_BGRA8888_GBITS 8
+#define FORMAT_BGRA8888_BBITS 8
+#define FORMAT_BGRA8888_ABITS 8
+#define FORMAT_BGRA8888_FILL 0
+#define FORMAT_BGRA8888_LOAD(p, i) FORMAT_LOAD32(p, i)
+#define FORMAT_BGRA8888_STORE(p, i, v) FORMAT_STORE32(p, i, v)
+
+/* rgba4444 */
+#define FORMAT_RGBA4444_BPP 16
+#define FORMAT_RGBA4444_RSHIFT 12
+#define FORMAT_RGBA4444_GSHIFT 8
+#define FORMAT_RGBA4444_BSHIFT 4
+#define FORMAT_RGBA4444_ASHIFT 0
+#define FORMAT_RGBA4444_RBITS 4
+#define FORMAT_RGBA4444_GBITS 4
+#define FORMAT_RGBA4444_BBITS 4
+#define FORMAT_RGBA4444_ABITS 4
+#define FORMAT_RGBA4444_FILL 0
+#define FORMAT_RGBA4444_LOAD(p, i) FORMAT_LOAD16(p, i)
+#define FORMAT_RGBA4444_STORE(p, i, v) FORMAT_STORE16(p, i, v)
+
+/* rgba5551 */
+#define FORMAT_RGBA5551_BPP 16
+#define FORMAT_RGBA5551_RSHIFT 11
+#define FORMAT_RGBA5551_GSHIFT 6
+#define FORMAT_RGBA5551_BSHIFT 1
+#define FORMAT_RGBA5551_ASHIFT 0
+#define FORMAT_RGBA5551_RBITS 5
+#define FORMAT_RGBA5551_GBITS 5
+#define FORMAT_RGBA5551_BBITS 5
+#define FORMAT_RGBA5551_ABITS 1
+#define FORMAT_RGBA5551_FILL 0
+#define FORMAT_RGBA5551_LOAD(p, i) FORMAT_LOAD16(p, i)
+#define FORMAT_RGBA5551_STORE(p, i, v) FORMAT_STORE16(p, i, v)
+
+/* loads and stores by size */
+#define FORMAT_LOAD16(p, i) ((uint32_t)((uint16_t *)(p))[i])
+#define FORMAT_LOAD32(p, i) (((uint32_t *)(p))[i])
+#define FORMAT_LOAD24(p, i) ((uint32_t)((uint8_t *)(p))[(i) * 3] | \
+	((uint32_t)((uint8_t *)(p))[(i) * 3 + 1] << 8) | \
+	((uint32_t)((uint8_t *)(p))[(i) * 3 + 2] << 16))
+
+#define FORMAT_STORE16(p, i, v) (((uint16_t *)(p))[i] = (uint16_t)(v))
+#define FORMAT_STORE32(p, i, v) (((uint32_t *)(p))[i] = (v))
+#define FORMAT_STORE24(p, i, v) \
+	(((uint8_t *)(p))[(i) * 3] = (uint8_t)(v), \
+	((uint8_t *)(p))[(i) * 3 + 1] = (uint8_t)((v) >> 8), \
+	((uint8_t *)(p))[(i) * 3 + 2] = (uint8_t)((v) >> 16))
+
+/* largest value of a channel of bits */
+#define FORMAT_MAX(bits) ((1UL << (bits)) - 1)
+
+/*
+ * bits in the shortest run of whole sbits copies that covers dbits. the
+ * zero guard only keeps dead branches of FORMAT_CHANNEL well formed
+ */
+#define FORMAT_RUN(sbits, dbits) \
+	((((dbits) + (sbits) - 1) / ((sbits) + ((sbits) == 0))) * (sbits))
+
+/*
+ * rescale a channel value from sbits to dbits. narrowing truncates, like
+ * pack_rgb565 does, and widening replicates the source bits down into the
+ * new low bits, so 0x1F becomes 0xFF and 0x30 of 6 bits becomes 0xC3. the
+ * copies are made with one multiply by 1 + 2^s + 2^2s ..., which is the
+ * exact division below. a missing source channel is full intensity
+ */
+#define FORMAT_CHANNEL(v, sbits, dbits) \
+	((sbits) == (dbits) ? (uint32_t)(v) : \
+	(sbits) == 0 ? (uint32_t)FORMAT_MAX(dbits) : \
+	(sbits) > (dbits) ? \
+		(uint32_t)(v) >> ((sbits) > (dbits) ? (sbits) - (dbits) : 0) : \
+	(uint32_t)(((v) * FORMAT_MAX(FORMAT_RUN(sbits, dbits)) / \
+		(FORMAT_MAX(sbits) + ((sbits) == 0))) >> \
+		(FORMAT_RUN(sbits, dbits) > (dbits) ? \
+			FORMAT_RUN(sbits, dbits) - (dbits) : 0)))
+
+/* move one channel of pixel p from format S to format D */
+#define FORMAT_MOVE(p, S, D, C) \
+	(FORMAT_CHANNEL(((p) >> FORMAT_##S##_##C##SHIFT) & \
+		FORMAT_MAX(FORMAT_##S##_##C##BITS), FORMAT_##S##_##C##BITS, \
+		FORMAT_##D##_##C##BITS) << FORMAT_##D##_##C##SHIFT)
+
+/*
+ * define a specialised converter from format S to format D, with every
+ * shift, mask and scale folded to constants
+ */
+#define FORMAT_CONVERTER(name, S, D) \
+	static void name(void *src, void *dst, int n) \
+	{ \
+		uint32_t p; \
+		int i; \
+		for (i = 0; i < n; i++) \
+		{ \
+			p = FORMAT_##S##_LOAD(src, i); \
+			p = FORMAT_MOVE(p, S, D, R) | FORMAT_MOVE(p, S, D, G) | \
+				FORMAT_MOVE(p, S, D, B) | \
+				(FORMAT_##D##_ABITS ? FORMAT_MOVE(p, S, D, A) : 0) | \
+				FORMAT_##D##_FILL; \
+			FORMAT_##D##_STORE(dst, i, p); \
+		} \
+	}
+
+/* run M(S, D) for every pair of built in formats, in format_id order */
+#define FORMAT_EACH_DST(M, S) \
+	M(S, RGB565) M(S, RGB888) M(S, RGBA8888) M(S, ARGB8888) \
+	M(S, XRGB8888) M(S, BGRA8888) M(S, RGBA4444) M(S, RGBA5551)
+
+#define FORMAT_EACH_PAIR(M) \
+	FORMAT_EACH_DST(M, RGB565) FORMAT_EACH_DST(M, RGB888) \
+	FORMAT_EACH_DST(M, RGBA8888) FORMAT_EACH_DST(M, ARGB8888) \
+	FORMAT_EACH_DST(M, XRGB8888) FORMAT_EACH_DST(M, BGRA8888) \
+	FORMAT_EACH_DST(M, RGBA4444) FORMAT_EACH_DST(M, RGBA5551)
+
+/* run M(F) for every built in format, in format_id order */
+#define FORMAT_EACH(M) \
+	M(RGB565) M(RGB888) M(RGBA8888) M(ARGB8888) \
+	M(XRGB8888) M(BGRA8888) M(RGBA4444) M(RGBA5551)
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* format lookup */
+format_t *format_get(int id);
+int format_find(int bpp, uint32_t rmask, uint32_t gmask, uint32_t bmask,
+	uint32_t amask);
+int format_from_color(color_t *c);
+
+/* single pixels */
+uint32_t format_pack(format_t *f, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+void format_unpack(format_t *f, uint32_t p, uint8_t *r, uint8_t *g,
+	uint8_t *b, uint8_t *a);
+
+/* conversion */
+format_converter_t format_get_converter(int src, int dst);
+void format_convert(int src, void *s, int dst, void *d, int n);
+void format_convert_generic(format_t *src, void *s, format_t *dst, void *d,
+	int n);
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/*
+ * internal helpers
+ */
+
+/* the specialised converters, format_RGB565_to_RGB888 and so on */
+#define FORMAT_DEFINE(S, D) FORMAT_CONVERTER(format_##S##_to_##D, S, D)
+FORMAT_EACH_PAIR(FORMAT_DEFINE)
+#undef FORMAT_DEFINE
+
+/* converter table, indexed by src * FORMAT_COUNT + dst */
+#define FORMAT_ENTRY(S, D) format_##S##_to_##D,
+static const format_converter_t format_converters[FORMAT_COUNT * FORMAT_COUNT] =
+{
+	FORMAT_EACH_PAIR(FORMAT_ENTRY)
+};
+#undef FORMAT_ENTRY
+
+/*
+ * rgb565 to argb8888 and xrgb8888 is the common 16 to 32 bpp case, and goes
+ * through the per byte expansion tables in rexcolor.h instead. the results
+ * are the same, both replicate the high bits
+ */
+static void format_expand_rgb565(void *src, void *dst, int n)
+{
+	expand_rgb565_array((uint16_t *)src, (uint32_t *)dst, n);
+}
+
+/* runtime descriptors, built from the compile time ones */
+#define FORMAT_DESC(F) \
+	{ \
+		FORMAT_##F##_BPP, \
+		FORMAT_MAX(FORMAT_##F##_RBITS) << FORMAT_##F##_RSHIFT, \
+		FORMAT_MAX(FORMAT_##F##_GBITS) << FORMAT_##F##_GSHIFT, \
+		FORMAT_MAX(FORMAT_##F##_BBITS) << FORMAT_##F##_BSHIFT, \
+		FORMAT_MAX(FORMAT_##F##_ABITS) << FORMAT_##F##_ASHIFT, \
+		FORMAT_##F##_RSHIFT, FORMAT_##F##_GSHIFT, \
+		FORMAT_##F##_BSHIFT, FORMAT_##F##_ASHIFT, \
+		FORMAT_##F##_RBITS, FORMAT_##F##_GBITS, \
+		FORMAT_##F##_BBITS, FORMAT_##F##_ABITS, \
+		FORMAT_##F##_FILL \
+	},
+static format_t format_descs[FORMAT_COUNT] =
+{
+	FORMAT_EACH(FORMAT_DESC)
+};
+#undef FORMAT_DESC
+
+/* load pixel i of a buffer in format f */
+static uint32_t format_load(format_t *f, void *p, int i)
+{
+	switch (f->bpp)
+	{
+		case 8:
+			return ((uint8_t *)p)[i];
+		case 16:
+			return FORMAT_LOAD16(p, i);
+		case 24:
+			return FORMAT_LOAD24(p, i);
+		default:
+			return FORMAT_LOAD32(p, i);
+	}
+}
+
+/* store pixel i of a buffer in format f */
+static void format_store(format_t *f, void *p, int i, uint32_t v)
+{
+	switch (f->bpp)
+	{
+		case 8:
+			((uint8_t *)p)[i] = (uint8_t)v;
+			break;
+		case 16:
+			FORMAT_STORE16(p, i, v);
+			break;
+		case 24:
+			FORMAT_STORE24(p, i, v);
+			break;
+		default:
+			FORMAT_STORE32(p, i, v);
+			break;
+	}
+}
+
+/*
+ * format lookup
+ */
+
+/* the descriptor of a built in format */
+format_t *format_get(int id)
+{
+	/* sanity checks */
+	if (id < 0 || id >= FORMAT_COUNT) return NULL;
+
+	return &format_descs[id];
+}
+
+/*
+ * the built in format matching the masks of an external framebuffer, or -1.
+ * an amask of zero also matches formats with an ignored top byte
+ */
+int format_find(int bpp, uint32_t rmask, uint32_t gmask, uint32_t bmask,
+	uint32_t amask)
+{
+	/* variables */
+	format_t *f;
+	int i;
+
+	for (i = 0; i < FORMAT_COUNT; i++)
+	{
+		f = &format_descs[i];
+
+		if (f->bpp == bpp && f->rmask == rmask && f->gmask == gmask &&
+			f->bmask == bmask && f->amask == amask)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/* the built in format of a color_t tag, or -1 for INDEX8 */
+int format_from_color(color_t *c)
+{
+	/* sanity checks */
+	if (!c) return -1;
+
+	switch (c->tag)
+	{
+		case RGB565:
+			return FORMAT_RGB565;
+		case RGBA8888:
+			return FORMAT_RGBA8888;
+		case ARGB8888:
+			return FORMAT_ARGB8888;
+		default:
+			return -1;
+	}
+}
+
+/*
+ * single pixels
+ */
+
+/* pack 8-bit channels into a pixel of format f */
+uint32_t format_pack(format_t *f, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+	/* sanity checks */
+	if (!f) return 0;
+
+	return (FORMAT_CHANNEL(r, 8, f->rbits) << f->rshift) |
+		(FORMAT_CHANNEL(g, 8, f->gbits) << f->gshift) |
+		(FORMAT_CHANNEL(b, 8, f->bbits) << f->bshift) |
+		(f->abits ? FORMAT_CHANNEL(a, 8, f->abits) << f->ashift : 0) |
+		f->fill;
+}
+
+/* unpack a pixel of format f to 8-bit channels. any pointer may be NULL */
+void format_unpack(format_t *f, uint32_t p, uint8_t *r, uint8_t *g,
+	uint8_t *b, uint8_t *a)
+{
+	/* sanity checks */
+	if (!f) return;
+
+	if (r) *r = (uint8_t)FORMAT_CHANNEL((p & f->rmask) >> f->rshift, f->rbits, 8);
+	if (g) *g = (uint8_t)FORMAT_CHANNEL((p & f->gmask) >> f->gshift, f->gbits, 8);
+	if (b) *b = (uint8_t)FORMAT_CHANNEL((p & f->bmask) >> f->bshift, f->bbits, 8);
+	if (a) *a = (uint8_t)FORMAT_CHANNEL((p & f->amask) >> f->ashift, f->abits, 8);
+}
+
+/*
+ * conversion
+ */
+
+/* the specialised converter between two built in formats */
+format_converter_t format_get_converter(int src, int dst)
+{
+	/* sanity checks */
+	if (src < 0 || src >= FORMAT_COUNT) return NULL;
+	if (dst < 0 || dst >= FORMAT_COUNT) return NULL;
+
+	if (src == FORMAT_RGB565 &&
+		(dst == FORMAT_ARGB8888 || dst == FORMAT_XRGB8888))
+		return format_expand_rgb565;
+
+	return format_converters[src * FORMAT_COUNT + dst];
+}
+
+/*
+ * convert n pixels between two built in formats. same format pairs are a
+ * plain copy
+ */
+void format_convert(int src, void *s, int dst, void *d, int n)
+{
+	/* sanity checks */
+	if (!s || !d || n < 1) return;
+	if (src < 0 || src >= FORMAT_COUNT) return;
+	if (dst < 0 || dst >= FORMAT_COUNT) return;
+
+	if (src == dst && src != FORMAT_XRGB8888)
+	{
+		memmove(d, s, n * (format_descs[src].bpp / 8));
+		return;
+	}
+
+	format_get_converter(src, dst)(s, d, n);
+}
+
+/*
+ * convert n pixels between any two descriptors, such as ones filled in
+ * from an external framebuffer. gives the same results as the specialised
+ * converters, a lot slower
+ */
+void format_convert_generic(format_t *src, void *s, format_t *dst, void *d,
+	int n)
+{
+	/* variables */
+	uint32_t p, q;
+	int i;
+
+	/* sanity checks */
+	if (!src || !s || !dst || !d) return;
+
+	for (i = 0; i < n; i++)
+	{
+		p = format_load(src, s, i);
+
+		q = (FORMAT_CHANNEL((p & src->rmask) >> src->rshift, src->rbits, dst->rbits) << dst->rshift) |
+			(FORMAT_CHANNEL((p & src->gmask) >> src->gshift, src->gbits, dst->gbits) << dst->gshift) |
+			(FORMAT_CHANNEL((p & src->bmask) >> src->bshift, src->bbits, dst->bbits) << dst->bshift) |
+			dst->fill;
+
+		if (dst->abits)
+			q |= FORMAT_CHANNEL((p & src->amask) >> src->ashift, src->abits, dst->abits) << dst->ashift;
+
+		format_store(dst, d, i, q);
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_FORMAT_H__ */
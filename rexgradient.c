@@ -0,0 +1,96 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexgradient.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexgradient.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* rex */
+#include "rexgradient.h"
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	surface_t *dst32, *dst16;
+	gradient_t g;
+
+	/* create surfaces */
+	dst32 = surface_create(320, 200, 32, NULL);
+	dst16 = surface_create(320, 200, 16, NULL);
+
+	/* print header */
+	printf("librex: rexgradient.h test\n");
+	printf("\n");
+
+	/* diagonal three stop linear gradient */
+	gradient_linear(&g, REAL(0), REAL(0), REAL(320), REAL(100),
+		pack_argb8888(255, 0, 0, 255), pack_argb8888(0, 0, 255, 255));
+	gradient_add_stop(&g, REAL(0.5), pack_argb8888(255, 255, 255, 255));
+	gradient_fill(dst32, &g, 0, 0, 320, 100);
+	printf("linear at 0, 0: %08lx\n", (unsigned long)((uint32_t *)dst32->pixels)[0]);
+	printf("linear at 140, 50: %08lx\n", (unsigned long)((uint32_t *)dst32->pixels)[50 * 320 + 140]);
+
+	/* radial gradient, clipped */
+	gradient_radial(&g, REAL(160), REAL(150), REAL(80),
+		pack_argb8888(255, 255, 0, 255), pack_argb8888(0, 64, 0, 255));
+	surface_clip_push(dst32, 40, 100, 240, 100);
+	gradient_fill(dst32, &g, 0, 100, 320, 100);
+	surface_clip_pop(dst32);
+	printf("radial at 160, 150: %08lx\n", (unsigned long)((uint32_t *)dst32->pixels)[150 * 320 + 160]);
+	printf("radial at 0, 150: %08lx\n", (unsigned long)((uint32_t *)dst32->pixels)[150 * 320]);
+	surface_dump_buffer(dst32, "gradient32.data");
+
+	/* dark vertical ramp at 16 bpp, banded and dithered */
+	gradient_linear(&g, REAL(0), REAL(0), REAL(0), REAL(200),
+		pack_argb8888(0, 0, 16, 255), pack_argb8888(32, 48, 64, 255));
+	gradient_fill(dst16, &g, 0, 0, 160, 200);
+	g.flags |= GRADIENT_DITHER;
+	gradient_fill(dst16, &g, 160, 0, 160, 200);
+	printf("rgb565 at 0, 100: %04x\n", ((uint16_t *)dst16->pixels)[100 * 320]);
+	printf("rgb565 dithered at 161, 100: %04x\n", ((uint16_t *)dst16->pixels)[100 * 320 + 161]);
+	surface_dump_buffer(dst16, "gradient16.data");
+
+	/* destroy surfaces */
+	surface_destroy(dst32);
+	surface_destroy(dst16);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,558 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexgradient.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: linear and radial gradients
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_GRADIENT_H__
+#define __LIBREX_GRADIENT_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexmath.h"
+#include "rexfloat.h"
+#include "rexfixed.h"
+#include "rexreal.h"
+#include "rexcolor.h"
+#include "rexsurface.h"
+#include "rexdither.h"
+
+#endif
+
+/* simd */
+#ifdef LIBREX_SSE2
+#include <emmintrin.h>
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+#define GRADIENT_MAX_STOPS 8
+
+/* radial gradients look their colors up in a table this size */
+#define GRADIENT_LUT_SIZE 1024
+
+/* pixels generated per chunk for 16 bpp targets */
+#define GRADIENT_CHUNK 256
+
+/* gradient types */
+enum gradient_type
+{
+	GRADIENT_LINEAR,
+	GRADIENT_RADIAL
+};
+
+/* gradient flags */
+#define GRADIENT_DITHER 0x01
+
+/* color stop. pos is 0 to 65536 along the gradient, color is argb8888 */
+typedef struct gradient_stop_t
+{
+	fix32 pos;
+	uint32_t color;
+} gradient_stop_t;
+
+/*
+ * linear gradients run from x0, y0 to x1, y1. radial gradients run from
+ * the center x0, y0 out to radius r. colors are clamped past either end
+ */
+typedef struct gradient_t
+{
+	int type;
+	int flags;
+	float32 x0, y0, x1, y1, r;
+	int num_stops;
+	gradient_stop_t stops[GRADIENT_MAX_STOPS];
+	int lut_valid;
+	uint32_t lut[GRADIENT_LUT_SIZE];
+} gradient_t;
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* gradient setup */
+void gradient_linear(gradient_t *g, real_t x0, real_t y0, real_t x1,
+	real_t y1, uint32_t c0, uint32_t c1);
+void gradient_radial(gradient_t *g, real_t x, real_t y, real_t r,
+	uint32_t c0, uint32_t c1);
+int gradient_add_stop(gradient_t *g, real_t pos, uint32_t color);
+
+/* drawing */
+void gradient_span(surface_t *dst, gradient_t *g, int x1, int x2, int y);
+void gradient_fill(surface_t *dst, gradient_t *g, int x, int y, int w, int h);
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/*
+ * internal helpers
+ */
+
+/* channel i of an argb8888 color, b g r a from 0 to 3 */
+#define GRADIENT_CHANNEL(c, i) ((int)(((c) >> ((i) * 8)) & 0xFF))
+
+/*
+ * write n pixels of a color ramp. channels are 16.16 fixed, b g r a,
+ * starting at c and stepping by dc, saturated to 0 to 255
+ */
+static void gradient_ramp(uint32_t *out, int n, int32_t *c, int32_t *dc)
+{
+	/* variables */
+	int i, x;
+	int32_t v[4];
+
+	/* start */
+	x = 0;
+
+	for (i = 0; i < 4; i++)
+		v[i] = c[i];
+
+#ifdef LIBREX_SSE2
+	if (n >= 4)
+	{
+		/* variables */
+		__m128i p0, p1, p2, p3, d, d4;
+
+		/* one pixel per register, four pixels per loop */
+		d = _mm_set_epi32(dc[3], dc[2], dc[1], dc[0]);
+		d4 = _mm_slli_epi32(d, 2);
+		p0 = _mm_set_epi32(v[3], v[2], v[1], v[0]);
+		p1 = _mm_add_epi32(p0, d);
+		p2 = _mm_add_epi32(p1, d);
+		p3 = _mm_add_epi32(p2, d);
+
+		for (; x + 4 <= n; x += 4)
+		{
+			_mm_storeu_si128((__m128i *)(out + x), _mm_packus_epi16(
+				_mm_packs_epi32(_mm_srai_epi32(p0, 16), _mm_srai_epi32(p1, 16)),
+				_mm_packs_epi32(_mm_srai_epi32(p2, 16), _mm_srai_epi32(p3, 16))));
+
+			p0 = _mm_add_epi32(p0, d4);
+			p1 = _mm_add_epi32(p1, d4);
+			p2 = _mm_add_epi32(p2, d4);
+			p3 = _mm_add_epi32(p3, d4);
+		}
+
+		/* carry on from where the vectors stopped */
+		for (i = 0; i < 4; i++)
+			v[i] += dc[i] * x;
+	}
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < n; x++)
+	{
+		out[x] = ((uint32_t)CLAMP(v[3] >> 16, 0, 255) << 24) |
+			((uint32_t)CLAMP(v[2] >> 16, 0, 255) << 16) |
+			((uint32_t)CLAMP(v[1] >> 16, 0, 255) << 8) |
+			(uint32_t)CLAMP(v[0] >> 16, 0, 255);
+
+		for (i = 0; i < 4; i++)
+			v[i] += dc[i];
+	}
+}
+
+/*
+ * n pixels of a linear gradient with parameter t stepping by dt. the span
+ * is cut where it crosses a stop, and each piece is one ramp
+ */
+static void gradient_linear_row(gradient_t *g, uint32_t *out, int n, fix32 t,
+	fix32 dt)
+{
+	/* variables */
+	gradient_stop_t *a, *b;
+	int32_t c[4], dc[4];
+	float32 scale;
+	int i, k, m;
+
+	while (n > 0)
+	{
+		/* find the stops around t */
+		for (k = 0; k < g->num_stops && g->stops[k].pos <= t; k++)
+			continue;
+
+		/* before the first or past the last stop, solid color */
+		if (k == 0 || k == g->num_stops)
+		{
+			a = &g->stops[k == 0 ? 0 : g->num_stops - 1];
+
+			if (k == 0)
+				m = dt > 0 ? (a->pos - t + dt - 1) / dt : n;
+			else
+				m = dt < 0 ? (t - a->pos) / -dt + 1 : n;
+
+			m = CLAMP(m, 1, n);
+
+			for (i = 0; i < 4; i++)
+			{
+				c[i] = GRADIENT_CHANNEL(a->color, i) << 16;
+				dc[i] = 0;
+			}
+
+			gradient_ramp(out, m, c, dc);
+			out += m;
+			n -= m;
+			t += dt * m;
+			continue;
+		}
+
+		/* between stops k - 1 and k */
+		a = &g->stops[k - 1];
+		b = &g->stops[k];
+
+		if (dt > 0)
+			m = (b->pos - t + dt - 1) / dt;
+		else if (dt < 0)
+			m = (t - a->pos) / -dt + 1;
+		else
+			m = n;
+
+		m = CLAMP(m, 1, n);
+
+		/* channel values at t, and their step per pixel */
+		scale = 65536.0f / (float32)(b->pos - a->pos);
+
+		for (i = 0; i < 4; i++)
+		{
+			c[i] = (GRADIENT_CHANNEL(a->color, i) << 16) + (int32_t)((float32)
+				(GRADIENT_CHANNEL(b->color, i) - GRADIENT_CHANNEL(a->color, i)) *
+				(float32)(t - a->pos) * scale);
+			dc[i] = (int32_t)((float32)(GRADIENT_CHANNEL(b->color, i) -
+				GRADIENT_CHANNEL(a->color, i)) * (float32)dt * scale);
+		}
+
+		gradient_ramp(out, m, c, dc);
+		out += m;
+		n -= m;
+		t += dt * m;
+	}
+}
+
+/* color at t from 0 to 65536, for the lookup table */
+static uint32_t gradient_color_at(gradient_t *g, fix32 t)
+{
+	/* variables */
+	uint32_t out;
+
+	gradient_linear_row(g, &out, 1, t, 0);
+
+	return out;
+}
+
+/* build the radial lookup table from the stops */
+static void gradient_build_lut(gradient_t *g)
+{
+	/* variables */
+	int i;
+
+	for (i = 0; i < GRADIENT_LUT_SIZE; i++)
+	{
+		g->lut[i] = gradient_color_at(g, (fix32)(((int32_t)i * 2 + 1) *
+			(65536 / GRADIENT_LUT_SIZE / 2)));
+	}
+
+	g->lut_valid = 1;
+}
+
+/* n pixels of a radial gradient, starting at fx, fy relative to the center */
+static void gradient_radial_row(gradient_t *g, uint32_t *out, int n,
+	float32 fx, float32 fy)
+{
+	/* variables */
+	float32 scale, d2, t;
+	int x, i;
+
+	/* table index per pixel of distance */
+	scale = (float32)GRADIENT_LUT_SIZE / g->r;
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	{
+		/* variables */
+		__m128 vx, vfx, vy2, vs, vmax;
+		__m128i idx;
+		int32_t lanes[4];
+
+		vfx = _mm_set1_ps(fx);
+		vy2 = _mm_set1_ps(fy * fy);
+		vs = _mm_set1_ps(scale);
+		vmax = _mm_set1_ps((float32)(GRADIENT_LUT_SIZE - 1));
+
+		for (; x + 4 <= n; x += 4)
+		{
+			vx = _mm_add_ps(vfx, _mm_set_ps((float32)(x + 3), (float32)(x + 2),
+				(float32)(x + 1), (float32)x));
+			idx = _mm_cvttps_epi32(_mm_min_ps(_mm_mul_ps(_mm_sqrt_ps(
+				_mm_add_ps(_mm_mul_ps(vx, vx), vy2)), vs), vmax));
+
+			_mm_storeu_si128((__m128i *)lanes, idx);
+
+			for (i = 0; i < 4; i++)
+				out[x + i] = g->lut[lanes[i]];
+		}
+	}
+#endif
+
+	/* scalar path and leftovers, same operations in the same order */
+	for (; x < n; x++)
+	{
+		t = fx + (float32)x;
+		d2 = t * t + fy * fy;
+		t = (float32)sqrt(d2) * scale;
+		if (t > (float32)(GRADIENT_LUT_SIZE - 1))
+			t = (float32)(GRADIENT_LUT_SIZE - 1);
+
+		out[x] = g->lut[(int)t];
+	}
+}
+
+/* n gradient pixels of row y starting at x, as argb8888 */
+static void gradient_row(gradient_t *g, uint32_t *out, int x, int y, int n)
+{
+	/* variables */
+	float32 dx, dy, len2, fx, fy;
+	fix32 t, dt;
+
+	/* pixel centers */
+	fx = (float32)x + 0.5f - g->x0;
+	fy = (float32)y + 0.5f - g->y0;
+
+	if (g->type == GRADIENT_RADIAL)
+	{
+		gradient_radial_row(g, out, n, fx, fy);
+		return;
+	}
+
+	/* project onto the gradient axis */
+	dx = g->x1 - g->x0;
+	dy = g->y1 - g->y0;
+	len2 = dx * dx + dy * dy;
+
+	if (len2 > 0.0f)
+	{
+		t = (fix32)((fx * dx + fy * dy) / len2 * 65536.0f);
+		dt = (fix32)(dx / len2 * 65536.0f);
+	}
+	else
+	{
+		t = 65536;
+		dt = 0;
+	}
+
+	gradient_linear_row(g, out, n, t, dt);
+}
+
+/*
+ * gradient setup
+ */
+
+/* set up a linear gradient from c0 at x0, y0 to c1 at x1, y1 */
+void gradient_linear(gradient_t *g, real_t x0, real_t y0, real_t x1,
+	real_t y1, uint32_t c0, uint32_t c1)
+{
+	/* sanity checks */
+	if (!g) return;
+
+	g->type = GRADIENT_LINEAR;
+	g->flags = 0;
+	g->x0 = REAL_TO_FLOAT32(x0);
+	g->y0 = REAL_TO_FLOAT32(y0);
+	g->x1 = REAL_TO_FLOAT32(x1);
+	g->y1 = REAL_TO_FLOAT32(y1);
+	g->r = 0.0f;
+	g->num_stops = 2;
+	g->stops[0].pos = 0;
+	g->stops[0].color = c0;
+	g->stops[1].pos = 65536;
+	g->stops[1].color = c1;
+	g->lut_valid = 0;
+}
+
+/* set up a radial gradient from c0 at the center x, y to c1 at radius r */
+void gradient_radial(gradient_t *g, real_t x, real_t y, real_t r,
+	uint32_t c0, uint32_t c1)
+{
+	/* sanity checks */
+	if (!g) return;
+
+	gradient_linear(g, x, y, x, y, c0, c1);
+	g->type = GRADIENT_RADIAL;
+	g->r = REAL_TO_FLOAT32(r);
+}
+
+/*
+ * add a color stop at pos, from 0 to 1 along the gradient. stops at the
+ * same position make a hard edge. returns 0 if there is no room left
+ */
+int gradient_add_stop(gradient_t *g, real_t pos, uint32_t color)
+{
+	/* variables */
+	fix32 p;
+	int i;
+
+	/* sanity checks */
+	if (!g || g->num_stops >= GRADIENT_MAX_STOPS) return 0;
+
+	p = (fix32)(CLAMP(REAL_TO_FLOAT32(pos), 0.0f, 1.0f) * 65536.0f);
+
+	/* insert sorted, after any stops at the same position */
+	for (i = g->num_stops; i > 0 && g->stops[i - 1].pos > p; i--)
+		g->stops[i] = g->stops[i - 1];
+
+	g->stops[i].pos = p;
+	g->stops[i].color = color;
+	g->num_stops++;
+	g->lut_valid = 0;
+
+	return 1;
+}
+
+/*
+ * drawing
+ */
+
+/*
+ * draw pixels x1 to x2 - 1 of row y, within the clip rectangle. 32 bpp
+ * surfaces get argb8888, 16 bpp surfaces get rgb565, ordered dithered if
+ * GRADIENT_DITHER is set
+ */
+void gradient_span(surface_t *dst, gradient_t *g, int x1, int x2, int y)
+{
+	/* variables */
+	uint32_t buf[GRADIENT_CHUNK], bias[4];
+	int n, i, t;
+
+	/* sanity checks */
+	if (!dst || !dst->pixels || !g || g->num_stops < 1) return;
+	if (dst->bpp != 16 && dst->bpp != 32) return;
+	if (g->type == GRADIENT_RADIAL && g->r <= 0.0f) return;
+
+	/* clip */
+	if (y < dst->clip.y1 || y >= dst->clip.y2) return;
+	x1 = MAX(x1, dst->clip.x1);
+	x2 = MIN(x2, dst->clip.x2);
+	if (x1 >= x2) return;
+	if (!surface_detach(dst)) return;
+
+	if (g->type == GRADIENT_RADIAL && !g->lut_valid)
+		gradient_build_lut(g);
+
+	/* straight into the surface */
+	if (dst->bpp == 32)
+	{
+		gradient_row(g, (uint32_t *)SURFACE_PTR(dst, x1, y), x1, y, x2 - x1);
+		return;
+	}
+
+	/*
+	 * 16 bpp goes through the rgb565 dither kernel in chunks. the chunks
+	 * are multiples of 4 so the bias only needs rotating once
+	 */
+	for (i = 0; i < 4; i++)
+	{
+		t = (g->flags & GRADIENT_DITHER) ? dither_bayer4[y & 3][(x1 + i) & 3] : 0;
+		bias[i] = ((uint32_t)(t >> 1) << 16) | ((uint32_t)(t >> 2) << 8) |
+			(uint32_t)(t >> 1);
+	}
+
+	while (x1 < x2)
+	{
+		n = MIN(x2 - x1, GRADIENT_CHUNK);
+
+		gradient_row(g, buf, x1, y, n);
+		dither_row_rgb565(buf, (uint16_t *)SURFACE_PTR(dst, x1, y), n, bias);
+
+		x1 += n;
+	}
+}
+
+/* fill a rectangle with a gradient, within the clip rectangle */
+void gradient_fill(surface_t *dst, gradient_t *g, int x, int y, int w, int h)
+{
+	/* variables */
+	int i;
+
+	/* sanity checks */
+	if (!dst || !g) return;
+
+	for (i = MAX(y, dst->clip.y1); i < MIN(y + h, dst->clip.y2); i++)
+		gradient_span(dst, g, x, x + w, i);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_GRADIENT_H__ */
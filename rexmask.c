@@ -0,0 +1,125 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexmask.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexmask.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* rex */
+#include "rexmask.h"
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	surface_t *dst, *src;
+	mask_t *a, *b;
+	color_t c;
+	int x, y, count;
+
+	/* create surfaces and masks */
+	dst = surface_create(320, 200, 32, NULL);
+	src = surface_create(320, 200, 32, NULL);
+	a = mask_create(150, 100);
+	b = mask_create(150, 100);
+
+	/* gradient source */
+	for (y = 0; y < src->h; y++)
+	{
+		for (x = 0; x < src->w; x++)
+		{
+			((uint32_t *)src->pixels)[y * src->w + x] =
+				pack_argb8888(x, y, 128, 255);
+		}
+	}
+
+	/* a disc, xor a bar */
+	for (y = 0; y < a->h; y++)
+	{
+		for (x = 0; x < a->w; x++)
+		{
+			if ((x - 75) * (x - 75) + (y - 50) * (y - 50) < 45 * 45)
+				mask_set(a, x, y, 1);
+		}
+	}
+
+	mask_rect(b, 10, 40, 130, 20, 1);
+	mask_combine(a, b, MASK_XOR);
+
+	/* print header */
+	printf("librex: rexmask.h test\n");
+	printf("\n");
+
+	/* count and hit test */
+	count = 0;
+	for (y = 0; y < a->h; y++)
+	{
+		for (x = 0; x < a->w; x++)
+			count += mask_get(a, x, y);
+	}
+
+	printf("bits set: %d\n", count);
+	printf("hit 75, 20: %d\n", mask_get(a, 75, 20));
+	printf("hit 75, 50: %d\n", mask_get(a, 75, 50));
+	printf("hit 15, 50: %d\n", mask_get(a, 15, 50));
+
+	/* fill, partially off the left edge */
+	color_set_argb8888(&c, 255, 255, 255, 255);
+	mask_fill(dst, a, -30, 10, &c);
+
+	/* blit through the inverted mask, clipped */
+	mask_invert(a);
+	surface_clip_push(dst, 160, 50, 140, 140);
+	mask_blit(src, dst, a, 160, 80, 160, 80);
+	surface_clip_pop(dst);
+
+	printf("pixel 40, 60: %08lx\n", (unsigned long)((uint32_t *)dst->pixels)[60 * dst->w + 40]);
+	printf("pixel 170, 90: %08lx\n", (unsigned long)((uint32_t *)dst->pixels)[90 * dst->w + 170]);
+
+	surface_dump_buffer(dst, "rexmask.data");
+
+	/* destroy surfaces and masks */
+	mask_destroy(a);
+	mask_destroy(b);
+	surface_destroy(dst);
+	surface_destroy(src);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,641 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexmask.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: 1 bpp masks
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_MASK_H__
+#define __LIBREX_MASK_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexmath.h"
+#include "rexcolor.h"
+#include "rexmem.h"
+#include "rexsurface.h"
+
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+/* 64 mask bits per word on 64-bit targets, 32 elsewhere */
+#if defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__)
+typedef uint64_t mask_word_t;
+#define MASK_WORD_BITS 64
+#else
+typedef uint32_t mask_word_t;
+#define MASK_WORD_BITS 32
+#endif
+
+#define MASK_WORD_ALL ((mask_word_t)~(mask_word_t)0)
+
+/* mask combine operations */
+enum mask_op
+{
+	MASK_AND,
+	MASK_OR,
+	MASK_XOR,
+	MASK_ANDNOT
+};
+
+/*
+ * 1 bpp mask. bit x of a row is bit x % MASK_WORD_BITS of word
+ * x / MASK_WORD_BITS, and bits past w in the last word are always clear
+ */
+typedef struct mask_t
+{
+	int w;
+	int h;
+	int words_per_row;
+	mask_word_t *bits;
+} mask_t;
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* mask creation and destruction */
+mask_t *mask_create(int w, int h);
+void mask_destroy(mask_t *m);
+
+/* mask modification */
+void mask_clear(mask_t *m, int value);
+void mask_set(mask_t *m, int x, int y, int value);
+int mask_get(mask_t *m, int x, int y);
+void mask_rect(mask_t *m, int x, int y, int w, int h, int value);
+void mask_combine(mask_t *dst, mask_t *src, int op);
+void mask_invert(mask_t *m);
+void mask_from_surface(surface_t *s, mask_t *m, uint32_t key);
+
+/* mask driven drawing */
+void mask_fill(surface_t *dst, mask_t *m, int dx, int dy, color_t *c);
+void mask_blit(surface_t *src, surface_t *dst, mask_t *m, int sx, int sy,
+	int dx, int dy);
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/* pointer to the first word of row y */
+#define MASK_ROW(m, y) ((m)->bits + (y) * (m)->words_per_row)
+
+/* word with bits a to b - 1 set, 0 <= a < b <= MASK_WORD_BITS */
+#define MASK_RANGE(a, b) ((MASK_WORD_ALL << (a)) & \
+	(MASK_WORD_ALL >> (MASK_WORD_BITS - (b))))
+
+/*
+ * internal helpers
+ */
+
+/* span callback for runs of set bits */
+typedef void (*mask_runf)(void *ctx, int y, int x, int n);
+
+/*
+ * call f for every run of set bits between x1 and x2 of row y. whole
+ * clear words are skipped and whole set words become one run
+ */
+static void mask_row_runs(mask_t *m, int y, int x1, int x2, mask_runf f,
+	void *ctx)
+{
+	/* variables */
+	mask_word_t *row, word;
+	int i, i1, i2, x, n, run_x, run_n;
+
+	/* start */
+	row = MASK_ROW(m, y);
+	i1 = x1 / MASK_WORD_BITS;
+	i2 = (x2 - 1) / MASK_WORD_BITS;
+	run_x = 0;
+	run_n = 0;
+
+	for (i = i1; i <= i2; i++)
+	{
+		word = row[i];
+		x = i * MASK_WORD_BITS;
+
+		/* trim the first and last word to the range */
+		if (i == i1 || i == i2)
+		{
+			word &= MASK_RANGE(i == i1 ? x1 - x : 0,
+				i == i2 ? x2 - x : MASK_WORD_BITS);
+		}
+
+		/* nothing set */
+		if (!word)
+			continue;
+
+		/* everything set, extends a run that ended on the word boundary */
+		if (word == MASK_WORD_ALL)
+		{
+			if (run_n && run_x + run_n == x)
+			{
+				run_n += MASK_WORD_BITS;
+			}
+			else
+			{
+				if (run_n) f(ctx, y, run_x, run_n);
+				run_x = x;
+				run_n = MASK_WORD_BITS;
+			}
+
+			continue;
+		}
+
+		/* mixed, walk the runs of set bits */
+		while (word)
+		{
+			while (!(word & 1))
+			{
+				word >>= 1;
+				x++;
+			}
+
+			n = 0;
+			while (word & 1)
+			{
+				word >>= 1;
+				n++;
+			}
+
+			if (run_n && run_x + run_n == x)
+			{
+				run_n += n;
+			}
+			else
+			{
+				if (run_n) f(ctx, y, run_x, run_n);
+				run_x = x;
+				run_n = n;
+			}
+
+			x += n;
+		}
+	}
+
+	if (run_n) f(ctx, y, run_x, run_n);
+}
+
+/* mask drawing context */
+typedef struct mask_draw_t
+{
+	surface_t *src;
+	surface_t *dst;
+	color_t *c;
+	int sx, sy;
+	int dx, dy;
+	uint8_t *row;
+	int row_x;
+} mask_draw_t;
+
+static void mask_run_fill(void *ctx, int y, int x, int n)
+{
+	mask_draw_t *d = (mask_draw_t *)ctx;
+
+	surface_fill(d->dst, SURFACE_PTR(d->dst, d->dx + x, d->dy + y), d->c, n);
+}
+
+static void mask_run_blit(void *ctx, int y, int x, int n)
+{
+	mask_draw_t *d = (mask_draw_t *)ctx;
+	int bytes = d->dst->bpp / 8;
+	uint8_t *src;
+
+	/* read from the saved row when blitting onto the same row */
+	if (d->row)
+		src = d->row + (x - d->row_x) * bytes;
+	else
+		src = SURFACE_PTR(d->src, d->sx + x, d->sy + y);
+
+	memmove(SURFACE_PTR(d->dst, d->dx + x, d->dy + y), src, n * bytes);
+}
+
+/*
+ * mask creation and destruction
+ */
+
+/* create a mask with all bits clear */
+mask_t *mask_create(int w, int h)
+{
+	/* variables */
+	mask_t *ret;
+
+	/* sanity checks */
+	if (w < 1 || h < 1) return NULL;
+
+	/* alloc */
+	ret = (mask_t *)LIBREX_CALLOC(1, sizeof(mask_t));
+	if (!ret) return NULL;
+
+	/* assign values */
+	ret->w = w;
+	ret->h = h;
+	ret->words_per_row = (w + MASK_WORD_BITS - 1) / MASK_WORD_BITS;
+
+	ret->bits = (mask_word_t *)LIBREX_CALLOC(ret->words_per_row * h,
+		sizeof(mask_word_t));
+
+	if (!ret->bits)
+	{
+		LIBREX_FREE(ret);
+		return NULL;
+	}
+
+	/* return ptr */
+	return ret;
+}
+
+/* destroy mask and free all associated memory */
+void mask_destroy(mask_t *m)
+{
+	if (m)
+	{
+		if (m->bits)
+			LIBREX_FREE(m->bits);
+
+		LIBREX_FREE(m);
+	}
+}
+
+/*
+ * mask modification
+ */
+
+/* set every bit to value */
+void mask_clear(mask_t *m, int value)
+{
+	/* sanity checks */
+	if (!m) return;
+
+	if (value)
+		mask_rect(m, 0, 0, m->w, m->h, 1);
+	else
+		memset(m->bits, 0, m->words_per_row * m->h * sizeof(mask_word_t));
+}
+
+/* set or clear the bit at x, y */
+void mask_set(mask_t *m, int x, int y, int value)
+{
+	/* variables */
+	mask_word_t *word, bit;
+
+	/* sanity checks */
+	if (!m) return;
+	if (x < 0 || y < 0 || x >= m->w || y >= m->h) return;
+
+	word = MASK_ROW(m, y) + x / MASK_WORD_BITS;
+	bit = (mask_word_t)1 << (x % MASK_WORD_BITS);
+
+	if (value)
+		*word |= bit;
+	else
+		*word &= ~bit;
+}
+
+/* test the bit at x, y. outside the mask is clear */
+int mask_get(mask_t *m, int x, int y)
+{
+	/* sanity checks */
+	if (!m) return 0;
+	if (x < 0 || y < 0 || x >= m->w || y >= m->h) return 0;
+
+	return (int)((MASK_ROW(m, y)[x / MASK_WORD_BITS] >>
+		(x % MASK_WORD_BITS)) & 1);
+}
+
+/* set or clear a rectangle of bits, a word at a time */
+void mask_rect(mask_t *m, int x, int y, int w, int h, int value)
+{
+	/* variables */
+	int i, j, i1, i2, x2, y2;
+	mask_word_t *row, bits;
+
+	/* sanity checks */
+	if (!m) return;
+
+	/* clip */
+	x2 = MIN(x + w, m->w);
+	y2 = MIN(y + h, m->h);
+	x = MAX(x, 0);
+	y = MAX(y, 0);
+	if (x >= x2 || y >= y2) return;
+
+	i1 = x / MASK_WORD_BITS;
+	i2 = (x2 - 1) / MASK_WORD_BITS;
+
+	for (j = y; j < y2; j++)
+	{
+		row = MASK_ROW(m, j);
+
+		for (i = i1; i <= i2; i++)
+		{
+			bits = MASK_RANGE(i == i1 ? x - i * MASK_WORD_BITS : 0,
+				i == i2 ? x2 - i * MASK_WORD_BITS : MASK_WORD_BITS);
+
+			if (value)
+				row[i] |= bits;
+			else
+				row[i] &= ~bits;
+		}
+	}
+}
+
+/* combine src into dst, which must be the same size */
+void mask_combine(mask_t *dst, mask_t *src, int op)
+{
+	/* variables */
+	mask_word_t *d, *s;
+	int i, n;
+
+	/* sanity checks */
+	if (!dst || !src) return;
+	if (dst->w != src->w || dst->h != src->h) return;
+
+	d = dst->bits;
+	s = src->bits;
+	n = dst->words_per_row * dst->h;
+
+	switch (op)
+	{
+		case MASK_AND:
+			for (i = 0; i < n; i++) d[i] &= s[i];
+			break;
+
+		case MASK_OR:
+			for (i = 0; i < n; i++) d[i] |= s[i];
+			break;
+
+		case MASK_XOR:
+			for (i = 0; i < n; i++) d[i] ^= s[i];
+			break;
+
+		case MASK_ANDNOT:
+			for (i = 0; i < n; i++) d[i] &= ~s[i];
+			break;
+
+		default:
+			break;
+	}
+}
+
+/* flip every bit */
+void mask_invert(mask_t *m)
+{
+	/* variables */
+	mask_word_t *row, last;
+	int i, y;
+
+	/* sanity checks */
+	if (!m) return;
+
+	/* keep the bits past w clear */
+	last = MASK_RANGE(0, m->w - (m->words_per_row - 1) * MASK_WORD_BITS);
+
+	for (y = 0; y < m->h; y++)
+	{
+		row = MASK_ROW(m, y);
+
+		for (i = 0; i < m->words_per_row; i++)
+			row[i] = ~row[i];
+
+		row[m->words_per_row - 1] &= last;
+	}
+}
+
+/* set bits where the pixels of s differ from key, built a word at a time */
+void mask_from_surface(surface_t *s, mask_t *m, uint32_t key)
+{
+	/* variables */
+	int x, y, bit;
+	mask_word_t *row, word;
+	uint32_t p;
+	uint8_t *src;
+
+	/* sanity checks */
+	if (!s || !s->pixels || !m) return;
+	if (s->w != m->w || s->h != m->h) return;
+
+	for (y = 0; y < s->h; y++)
+	{
+		row = MASK_ROW(m, y);
+		src = SURFACE_PTR(s, 0, y);
+		word = 0;
+		bit = 0;
+
+		for (x = 0; x < s->w; x++)
+		{
+			switch (s->bpp)
+			{
+				case 8: p = src[x]; break;
+				case 16: p = ((uint16_t *)src)[x]; break;
+				default: p = ((uint32_t *)src)[x]; break;
+			}
+
+			if (p != key)
+				word |= (mask_word_t)1 << bit;
+
+			if (++bit == MASK_WORD_BITS)
+			{
+				*row++ = word;
+				word = 0;
+				bit = 0;
+			}
+		}
+
+		if (bit)
+			*row = word;
+	}
+}
+
+/*
+ * mask driven drawing
+ */
+
+/*
+ * clip the mask placed at dx, dy on dst, and at sx, sy on src if there is
+ * one. returns 0 if nothing is left
+ */
+static int mask_clip(surface_t *src, surface_t *dst, mask_t *m, int sx,
+	int sy, int dx, int dy, surface_rect_t *r)
+{
+	/* clip against dst */
+	r->x1 = MAX(0, dst->clip.x1 - dx);
+	r->y1 = MAX(0, dst->clip.y1 - dy);
+	r->x2 = MIN(m->w, dst->clip.x2 - dx);
+	r->y2 = MIN(m->h, dst->clip.y2 - dy);
+
+	/* clip against src */
+	if (src)
+	{
+		r->x1 = MAX(r->x1, -sx);
+		r->y1 = MAX(r->y1, -sy);
+		r->x2 = MIN(r->x2, src->w - sx);
+		r->y2 = MIN(r->y2, src->h - sy);
+	}
+
+	return r->x1 < r->x2 && r->y1 < r->y2;
+}
+
+/*
+ * fill the pixels of dst covered by set bits, with the mask placed at
+ * dx, dy. glyphs and stencils both draw through this
+ */
+void mask_fill(surface_t *dst, mask_t *m, int dx, int dy, color_t *c)
+{
+	/* variables */
+	mask_draw_t d;
+	surface_rect_t r;
+	int y;
+
+	/* sanity checks */
+	if (!dst || !dst->pixels || !m || !c) return;
+	if (c->tag == INDEX8 && dst->bpp != 8) return;
+	if (c->tag == RGB565 && dst->bpp != 16) return;
+	if (c->tag == RGBA8888 && dst->bpp != 32) return;
+	if (c->tag == ARGB8888 && dst->bpp != 32) return;
+	if (!mask_clip(NULL, dst, m, 0, 0, dx, dy, &r)) return;
+	if (!surface_detach(dst)) return;
+
+	d.dst = dst;
+	d.c = c;
+	d.dx = dx;
+	d.dy = dy;
+
+	for (y = r.y1; y < r.y2; y++)
+		mask_row_runs(m, y, r.x1, r.x2, mask_run_fill, &d);
+}
+
+/*
+ * copy the m->w by m->h block of src at sx, sy to dst at dx, dy, only
+ * where bits are set
+ */
+void mask_blit(surface_t *src, surface_t *dst, mask_t *m, int sx, int sy,
+	int dx, int dy)
+{
+	/* variables */
+	mask_draw_t d;
+	surface_rect_t r;
+	int bytes;
+	int y;
+
+	/* sanity checks */
+	if (!src || !src->pixels || !dst || !dst->pixels || !m) return;
+	if (src->bpp != dst->bpp) return;
+	if (!mask_clip(src, dst, m, sx, sy, dx, dy, &r)) return;
+	if (!surface_detach(dst)) return;
+
+	d.src = src;
+	d.dst = dst;
+	d.sx = sx;
+	d.sy = sy;
+	d.dx = dx;
+	d.dy = dy;
+	d.row = NULL;
+	d.row_x = r.x1;
+
+	/* start */
+	if (src != dst || dy < sy || (dy == sy && dx <= sx))
+	{
+		/* top down, each run is read before anything overwrites it */
+		for (y = r.y1; y < r.y2; y++)
+			mask_row_runs(m, y, r.x1, r.x2, mask_run_blit, &d);
+	}
+	else if (dy > sy)
+	{
+		/* bottom up so source rows are read before they're overwritten */
+		for (y = r.y2 - 1; y >= r.y1; y--)
+			mask_row_runs(m, y, r.x1, r.x2, mask_run_blit, &d);
+	}
+	else
+	{
+		/* same row moving right, an earlier run can overwrite a later
+		 * run's source, so save each source row first */
+		bytes = src->bpp / 8;
+		d.row = (uint8_t *)LIBREX_MALLOC((r.x2 - r.x1) * bytes);
+		if (!d.row) return;
+
+		for (y = r.y1; y < r.y2; y++)
+		{
+			memcpy(d.row, SURFACE_PTR(src, sx + r.x1, sy + y),
+				(r.x2 - r.x1) * bytes);
+			mask_row_runs(m, y, r.x1, r.x2, mask_run_blit, &d);
+		}
+
+		LIBREX_FREE(d.row);
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_MASK_H__ */
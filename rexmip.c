@@ -0,0 +1,121 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexmip.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexmip.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* rex */
+#include "rexmip.h"
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	surface_t *s32, *s16, *s8, *pal;
+	mipmap_t *m32, *m16, *m8;
+	surface_t *l;
+	int x, y, i;
+
+	/* create surfaces */
+	s32 = surface_create(64, 48, 32, NULL);
+	s16 = surface_create(64, 48, 16, NULL);
+	s8 = surface_create(64, 48, 8, NULL);
+	pal = surface_create(256, 1, 32, NULL);
+
+	/* grayscale palette */
+	for (i = 0; i < 256; i++)
+		((uint32_t *)pal->pixels)[i] = pack_argb8888(i, i, i, 255);
+
+	surface_set_palette(s8, &pal);
+
+	/* fill with a checkerboard gradient */
+	for (y = 0; y < s32->h; y++)
+	{
+		for (x = 0; x < s32->w; x++)
+		{
+			i = ((x ^ y) & 1) ? x * 4 : 255 - y * 4;
+			((uint32_t *)s32->pixels)[y * s32->w + x] = pack_argb8888(i, i, i, 255);
+			((uint16_t *)s16->pixels)[y * s16->w + x] = pack_rgb565(i, i, i);
+			((uint8_t *)s8->pixels)[y * s8->w + x] = (uint8_t)i;
+		}
+	}
+
+	/* create mip chains */
+	m32 = mipmap_create(s32);
+	m16 = mipmap_create(s16);
+	m8 = mipmap_create(s8);
+
+	/* print header */
+	printf("librex: rexmip.h test\n");
+	printf("\n");
+
+	/* print levels */
+	for (i = 0; i < m32->num_levels; i++)
+	{
+		l = mipmap_level(m32, i);
+		printf("level %d: %dx%d", i, l->w, l->h);
+		printf(" argb8888: %08x", ((uint32_t *)mipmap_level(m32, i)->pixels)[0]);
+		printf(" rgb565: %04x", ((uint16_t *)mipmap_level(m16, i)->pixels)[0]);
+		printf(" index8: %u\n", ((uint8_t *)mipmap_level(m8, i)->pixels)[0]);
+	}
+
+	printf("\n");
+
+	/* level selection */
+	printf("select 0.5: %d\n", mipmap_select(m32, FIX32(0.5)));
+	printf("select 1.0: %d\n", mipmap_select(m32, FIX32(1)));
+	printf("select 3.0: %d\n", mipmap_select(m32, FIX32(3)));
+	printf("select 64.0: %d\n", mipmap_select(m32, FIX32(64)));
+
+	/* save level 1 */
+	surface_dump_buffer(mipmap_level(m32, 1), "mip1.data");
+
+	/* destroy */
+	mipmap_destroy(m32);
+	mipmap_destroy(m16);
+	mipmap_destroy(m8);
+	surface_destroy(s32);
+	surface_destroy(s16);
+	surface_destroy(s8);
+	surface_destroy(pal);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
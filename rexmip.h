@@ -0,0 +1,498 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexmip.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: surface mipmap chains
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_MIP_H__
+#define __LIBREX_MIP_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexmath.h"
+#include "rexfixed.h"
+#include "rexcolor.h"
+#include "rexsurface.h"
+#include "rexdither.h"
+
+#endif
+
+/* simd */
+#ifdef LIBREX_SSE2
+#include <emmintrin.h>
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+/* enough levels for a 32768x32768 surface */
+#define MIPMAP_MAX_LEVELS 16
+
+/* a mip chain. all levels live in one allocation, level 0 included */
+typedef struct mipmap_t
+{
+	int num_levels;
+	void *buffer;
+	surface_t levels[MIPMAP_MAX_LEVELS];
+} mipmap_t;
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* mipmap creation and destruction */
+mipmap_t *mipmap_create(surface_t *s);
+void mipmap_destroy(mipmap_t *m);
+
+/* mipmap modification */
+void mipmap_update(mipmap_t *m);
+
+/* mipmap access */
+surface_t *mipmap_level(mipmap_t *m, int level);
+int mipmap_select(mipmap_t *m, fix32 step);
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/*
+ * internal helpers
+ */
+
+/* pointer to row y of a surface */
+#define MIPMAP_ROW(s, y) ((uint8_t *)(s)->pixels + (y) * (s)->bytes_per_row)
+
+/* rounded average of four argb8888 pixels, two channels at a time */
+static uint32_t mipmap_average32(uint32_t a, uint32_t b, uint32_t c, uint32_t d)
+{
+	/* variables */
+	uint32_t rb, ag;
+
+	rb = (a & 0x00FF00FF) + (b & 0x00FF00FF) +
+		(c & 0x00FF00FF) + (d & 0x00FF00FF) + 0x00020002;
+	ag = ((a >> 8) & 0x00FF00FF) + ((b >> 8) & 0x00FF00FF) +
+		((c >> 8) & 0x00FF00FF) + ((d >> 8) & 0x00FF00FF) + 0x00020002;
+
+	return ((rb >> 2) & 0x00FF00FF) | (((ag >> 2) & 0x00FF00FF) << 8);
+}
+
+/* rounded average of four rgb565 pixels */
+static uint16_t mipmap_average16(uint16_t a, uint16_t b, uint16_t c, uint16_t d)
+{
+	/* variables */
+	uint32_t r, g, bl;
+
+	r = ((a >> 11) & 0x1F) + ((b >> 11) & 0x1F) +
+		((c >> 11) & 0x1F) + ((d >> 11) & 0x1F) + 2;
+	g = ((a >> 5) & 0x3F) + ((b >> 5) & 0x3F) +
+		((c >> 5) & 0x3F) + ((d >> 5) & 0x3F) + 2;
+	bl = (a & 0x1F) + (b & 0x1F) + (c & 0x1F) + (d & 0x1F) + 2;
+
+	return (uint16_t)(((r >> 2) << 11) | ((g >> 2) << 5) | (bl >> 2));
+}
+
+/* downsample one row pair of a 32 bpp level */
+static void mipmap_row32(uint32_t *s0, uint32_t *s1, uint32_t *dst, int dw,
+	int sw)
+{
+	/* variables */
+	int x, x0, x1;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	{
+		/* variables */
+		__m128i z, a, b, lo, hi, two;
+
+		z = _mm_setzero_si128();
+		two = _mm_set1_epi16(2);
+
+		/* two destination pixels from four source columns */
+		if (sw > 1)
+		{
+			for (; x + 2 <= dw; x += 2)
+			{
+				a = _mm_loadu_si128((__m128i *)(s0 + x * 2));
+				b = _mm_loadu_si128((__m128i *)(s1 + x * 2));
+
+				/* vertical sums in 16-bit lanes */
+				lo = _mm_add_epi16(_mm_unpacklo_epi8(a, z), _mm_unpacklo_epi8(b, z));
+				hi = _mm_add_epi16(_mm_unpackhi_epi8(a, z), _mm_unpackhi_epi8(b, z));
+
+				/* horizontal sums of neighbouring pixels */
+				lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+				hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+
+				/* round, divide and pack */
+				lo = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(lo, hi), two), 2);
+				_mm_storel_epi64((__m128i *)(dst + x), _mm_packus_epi16(lo, lo));
+			}
+		}
+	}
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < dw; x++)
+	{
+		x0 = x * 2;
+		x1 = MIN(x0 + 1, sw - 1);
+		dst[x] = mipmap_average32(s0[x0], s0[x1], s1[x0], s1[x1]);
+	}
+}
+
+/* downsample one row pair of a 16 bpp level */
+static void mipmap_row16(uint16_t *s0, uint16_t *s1, uint16_t *dst, int dw,
+	int sw)
+{
+	/* variables */
+	int x, x0, x1;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	{
+		/* variables */
+		__m128i a, b, lo, r, g, bl, o, m5, m6, two;
+
+		m5 = _mm_set1_epi32(0x1F);
+		m6 = _mm_set1_epi32(0x3F);
+		two = _mm_set1_epi32(2);
+
+		/* four destination pixels from eight source columns */
+		if (sw > 1)
+		{
+			for (; x + 4 <= dw; x += 4)
+			{
+				a = _mm_loadu_si128((__m128i *)(s0 + x * 2));
+				b = _mm_loadu_si128((__m128i *)(s1 + x * 2));
+
+				/* each 32-bit lane holds a horizontal pair, split and add */
+				lo = _mm_set1_epi32(0xFFFF);
+				r = _mm_add_epi32(
+					_mm_add_epi32(_mm_srli_epi32(_mm_and_si128(a, lo), 11), _mm_srli_epi32(a, 27)),
+					_mm_add_epi32(_mm_srli_epi32(_mm_and_si128(b, lo), 11), _mm_srli_epi32(b, 27)));
+				g = _mm_add_epi32(
+					_mm_add_epi32(_mm_and_si128(_mm_srli_epi32(a, 5), m6), _mm_and_si128(_mm_srli_epi32(a, 21), m6)),
+					_mm_add_epi32(_mm_and_si128(_mm_srli_epi32(b, 5), m6), _mm_and_si128(_mm_srli_epi32(b, 21), m6)));
+				bl = _mm_add_epi32(
+					_mm_add_epi32(_mm_and_si128(a, m5), _mm_and_si128(_mm_srli_epi32(a, 16), m5)),
+					_mm_add_epi32(_mm_and_si128(b, m5), _mm_and_si128(_mm_srli_epi32(b, 16), m5)));
+
+				/* round, divide and repack */
+				r = _mm_srli_epi32(_mm_add_epi32(r, two), 2);
+				g = _mm_srli_epi32(_mm_add_epi32(g, two), 2);
+				bl = _mm_srli_epi32(_mm_add_epi32(bl, two), 2);
+				o = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(r, 11), _mm_slli_epi32(g, 5)), bl);
+
+				/* sign extend so the signed pack keeps the exact bits */
+				o = _mm_srai_epi32(_mm_slli_epi32(o, 16), 16);
+				_mm_storel_epi64((__m128i *)(dst + x), _mm_packs_epi32(o, o));
+			}
+		}
+	}
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < dw; x++)
+	{
+		x0 = x * 2;
+		x1 = MIN(x0 + 1, sw - 1);
+		dst[x] = mipmap_average16(s0[x0], s0[x1], s1[x0], s1[x1]);
+	}
+}
+
+/* downsample one row pair of an 8 bpp level through its palette */
+static void mipmap_row8(uint8_t *s0, uint8_t *s1, uint8_t *dst, int dw,
+	int sw, uint8_t *rgb, int n)
+{
+	/* variables */
+	int x, x0, x1, i;
+	uint8_t c[4];
+	int r, g, b;
+
+	for (x = 0; x < dw; x++)
+	{
+		x0 = x * 2;
+		x1 = MIN(x0 + 1, sw - 1);
+
+		c[0] = s0[x0];
+		c[1] = s0[x1];
+		c[2] = s1[x0];
+		c[3] = s1[x1];
+
+		/* flat areas and surfaces without a palette keep their index */
+		if (!n || (c[0] == c[1] && c[0] == c[2] && c[0] == c[3]))
+		{
+			dst[x] = c[0];
+			continue;
+		}
+
+		/* average the palette colors and find the closest entry */
+		r = g = b = 2;
+		for (i = 0; i < 4; i++)
+		{
+			r += rgb[c[i] * 3 + 0];
+			g += rgb[c[i] * 3 + 1];
+			b += rgb[c[i] * 3 + 2];
+		}
+
+		dst[x] = dither_nearest_index(rgb, n, r >> 2, g >> 2, b >> 2);
+	}
+}
+
+/*
+ * mipmap creation and destruction
+ */
+
+/* create a full mip chain from surface s, down to 1x1 */
+mipmap_t *mipmap_create(surface_t *s)
+{
+	/* variables */
+	mipmap_t *ret;
+	size_t size, ofs;
+	int w, h, i, bytes;
+
+	/* sanity checks */
+	if (!s || !s->pixels) return NULL;
+	if (s->bpp != 8 && s->bpp != 16 && s->bpp != 32) return NULL;
+
+	/* alloc */
+	ret = (mipmap_t *)LIBREX_CALLOC(1, sizeof(mipmap_t));
+	if (!ret) return NULL;
+
+	/* lay out the levels, each one starting 16-byte aligned */
+	bytes = s->bpp / 8;
+	w = s->w;
+	h = s->h;
+	size = 0;
+
+	for (i = 0; i < MIPMAP_MAX_LEVELS; i++)
+	{
+		ret->levels[i].w = w;
+		ret->levels[i].h = h;
+		ret->levels[i].bpp = s->bpp;
+		ret->levels[i].bytes_per_row = w * bytes;
+		ret->levels[i].palette = s->palette;
+		surface_clip_reset(&ret->levels[i]);
+		ret->levels[i].pixels = (void *)size;
+		ret->num_levels = i + 1;
+
+		size += ((size_t)w * h * bytes + 15) & ~(size_t)15;
+
+		if (w == 1 && h == 1) break;
+
+		w = MAX(w / 2, 1);
+		h = MAX(h / 2, 1);
+	}
+
+	/* allocate buffer */
+	ret->buffer = LIBREX_CALLOC(size, 1);
+	if (!ret->buffer)
+	{
+		LIBREX_FREE(ret);
+		return NULL;
+	}
+
+	/* resolve level offsets to pointers */
+	for (i = 0; i < ret->num_levels; i++)
+	{
+		ofs = (size_t)ret->levels[i].pixels;
+		ret->levels[i].pixels = (uint8_t *)ret->buffer + ofs;
+	}
+
+	/* copy level 0 row by row, since s may be a view with padding */
+	for (i = 0; i < s->h; i++)
+	{
+		memcpy(MIPMAP_ROW(&ret->levels[0], i), MIPMAP_ROW(s, i),
+			ret->levels[0].bytes_per_row);
+	}
+
+	/* build the rest of the chain */
+	mipmap_update(ret);
+
+	/* return ptr */
+	return ret;
+}
+
+/* destroy mip chain and free all associated memory */
+void mipmap_destroy(mipmap_t *m)
+{
+	if (m)
+	{
+		if (m->buffer)
+			LIBREX_FREE(m->buffer);
+
+		LIBREX_FREE(m);
+	}
+}
+
+/*
+ * mipmap modification
+ */
+
+/* rebuild levels 1 and up from level 0 with a 2x2 box filter */
+void mipmap_update(mipmap_t *m)
+{
+	/* variables */
+	int i, y, y0, y1, n;
+	surface_t *src, *dst;
+	uint8_t rgb[768];
+
+	/* sanity checks */
+	if (!m || !m->buffer) return;
+
+	/* palette for 8 bpp chains */
+	n = 0;
+	if (m->levels[0].bpp == 8 && m->levels[0].palette)
+		n = dither_load_palette(*m->levels[0].palette, rgb);
+
+	for (i = 1; i < m->num_levels; i++)
+	{
+		src = &m->levels[i - 1];
+		dst = &m->levels[i];
+
+		for (y = 0; y < dst->h; y++)
+		{
+			y0 = y * 2;
+			y1 = MIN(y0 + 1, src->h - 1);
+
+			switch (dst->bpp)
+			{
+				case 8:
+					mipmap_row8(MIPMAP_ROW(src, y0), MIPMAP_ROW(src, y1),
+						MIPMAP_ROW(dst, y), dst->w, src->w, rgb, n);
+					break;
+
+				case 16:
+					mipmap_row16((uint16_t *)MIPMAP_ROW(src, y0),
+						(uint16_t *)MIPMAP_ROW(src, y1),
+						(uint16_t *)MIPMAP_ROW(dst, y), dst->w, src->w);
+					break;
+
+				case 32:
+					mipmap_row32((uint32_t *)MIPMAP_ROW(src, y0),
+						(uint32_t *)MIPMAP_ROW(src, y1),
+						(uint32_t *)MIPMAP_ROW(dst, y), dst->w, src->w);
+					break;
+
+				default:
+					break;
+			}
+		}
+	}
+}
+
+/*
+ * mipmap access
+ */
+
+/* return a view of the given level. the view must not be destroyed */
+surface_t *mipmap_level(mipmap_t *m, int level)
+{
+	/* sanity checks */
+	if (!m || level < 0) return NULL;
+
+	/* clamp to the smallest level */
+	if (level >= m->num_levels) level = m->num_levels - 1;
+
+	return &m->levels[level];
+}
+
+/* pick a level for a minification step given in source texels per pixel */
+int mipmap_select(mipmap_t *m, fix32 step)
+{
+	/* variables */
+	int level;
+
+	/* sanity checks */
+	if (!m) return 0;
+
+	/* floor(log2(step)) */
+	level = 0;
+	step = ABS(step);
+	while (step >= FIX32_ONE * 2 && level < m->num_levels - 1)
+	{
+		step >>= 1;
+		level++;
+	}
+
+	return level;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_MIP_H__ */
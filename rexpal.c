@@ -0,0 +1,183 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexpal.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexpal.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* rex */
+#include "rexpal.h"
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	palette_t *base, *screen;
+	colormap_t *shade, *blend;
+	surface_t *src, *dst32, *dst16, *dst8;
+	int x, y, frame, rebuilds, errors;
+	uint32_t sum, cells[32];
+	uint8_t mapped[32];
+
+	/* create palettes and surfaces */
+	base = palette_create();
+	screen = palette_create();
+	src = surface_create(320, 200, 8, NULL);
+	dst32 = surface_create(320, 200, 32, NULL);
+	dst16 = surface_create(320, 200, 16, NULL);
+	dst8 = surface_create(320, 200, 8, NULL);
+
+	/* a gray ramp, and a red ramp to cycle */
+	for (x = 0; x < 128; x++)
+		palette_set(base, x, pack_argb8888(x * 2, x * 2, x * 2, 255));
+
+	for (x = 128; x < 160; x++)
+		palette_set(base, x, pack_argb8888((x - 128) * 8, 0, 0, 255));
+
+	palette_cycle_add(base, 128, 159, 40);
+
+	/* diagonal bands of both ramps */
+	for (y = 0; y < src->h; y++)
+	{
+		for (x = 0; x < src->w; x++)
+		{
+			((uint8_t *)src->pixels)[y * src->w + x] =
+				x < 160 ? (x + y) & 127 : 128 + ((x + y) & 31);
+		}
+	}
+
+	/* print header */
+	printf("librex: rexpal.h test\n");
+	printf("\n");
+
+	/* cycle while fading out over 64 frames of 20ms */
+	for (frame = 0; frame < 64; frame++)
+	{
+		palette_update(base, 20);
+		palette_fade_color(screen, base, 0xFF000000, frame * 4);
+		palette_expand(screen, src, dst32, 0, 0);
+	}
+
+	printf("fade: %d frames, %d lut builds\n", frame, screen->lut_builds);
+
+	/* unchanged palette, no rebuilds */
+	rebuilds = screen->lut_builds;
+	for (frame = 0; frame < 16; frame++)
+		palette_expand(screen, src, dst32, 0, 0);
+
+	printf("static: %d frames, %d lut builds\n", frame, screen->lut_builds - rebuilds);
+
+	/* back to full brightness */
+	palette_copy(base, screen);
+	palette_expand(screen, src, dst32, 0, 0);
+	palette_expand(screen, src, dst16, 0, 0);
+
+	for (sum = 0, x = 0; x < dst32->w * dst32->h; x++)
+		sum = sum * 31 + ((uint32_t *)dst32->pixels)[x];
+
+	printf("argb8888: %08x checksum %08x\n", ((uint32_t *)dst32->pixels)[200], sum);
+	printf("rgb565: %04x\n", ((uint16_t *)dst16->pixels)[200]);
+
+	surface_dump_buffer(dst32, "pal_argb8888.data");
+	surface_dump_buffer(dst16, "pal_rgb565.data");
+
+	/* 32 light levels into black, and a 50% translucency table */
+	shade = colormap_create_shade(base, 32, 0xFF000000);
+	blend = colormap_create_blend(base, 128);
+
+	printf("nearest: %d\n", palette_nearest(base, 100, 100, 100));
+	printf("shade: %d %d %d\n", COLORMAP_ROW(shade, 0)[100],
+		COLORMAP_ROW(shade, 16)[100], COLORMAP_ROW(shade, 31)[100]);
+	printf("blend: %d\n", COLORMAP_ROW(blend, 159)[127]);
+
+	/* the left half lit at level 12, then the right half blended over it */
+	surface_clip_push(dst8, 0, 0, 160, 200);
+	colormap_blit(shade, 12, src, dst8, 0, 0);
+	surface_clip_pop(dst8);
+	colormap_blit_blend(blend, src, dst8, 80, 0);
+
+	printf("index8: %d %d\n", ((uint8_t *)dst8->pixels)[100],
+		((uint8_t *)dst8->pixels)[200]);
+
+	surface_dump_buffer(dst8, "pal_index8.data");
+
+	/* quantize the expanded frame back to 8 bpp through the inverse cache */
+	palette_map_surface(screen, dst32, dst8, 0, 0);
+	printf("map: %d %d, %d cells filled\n", ((uint8_t *)dst8->pixels)[100],
+		((uint8_t *)dst8->pixels)[200], screen->inverse_fills);
+
+	/* every cell against the exact search for the color it stands for */
+	errors = 0;
+
+	for (x = 0; x < PALETTE_INVERSE_SIZE; x += 32)
+	{
+		for (y = 0; y < 32; y++)
+		{
+			cells[y] = pack_argb8888(COLOR_EXPAND5((x + y) >> 10),
+				COLOR_EXPAND5((x + y) >> 5), COLOR_EXPAND5(x + y), 255);
+		}
+
+		palette_map(base, cells, mapped, 32);
+
+		for (y = 0; y < 32; y++)
+		{
+			if (mapped[y] != palette_nearest(base, (cells[y] >> 16) & 0xFF,
+				(cells[y] >> 8) & 0xFF, cells[y] & 0xFF))
+				errors++;
+		}
+	}
+
+	printf("inverse: %d cells filled, %d errors\n", base->inverse_fills, errors);
+	printf("nearest cached: %d\n", palette_nearest_cached(base, 100, 100, 100));
+
+	surface_dump_buffer(dst8, "pal_mapped.data");
+
+	/* destroy palettes and surfaces */
+	palette_destroy(base);
+	palette_destroy(screen);
+	colormap_destroy(shade);
+	colormap_destroy(blend);
+	surface_destroy(src);
+	surface_destroy(dst32);
+	surface_destroy(dst16);
+	surface_destroy(dst8);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
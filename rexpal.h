@@ -0,0 +1,1075 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexpal.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: palettes, colormaps and translucency tables
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_PAL_H__
+#define __LIBREX_PAL_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexmath.h"
+#include "rexcolor.h"
+#include "rexsurface.h"
+#include "rexdither.h"
+
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+/* limits */
+#define PALETTE_SIZE 256
+#define PALETTE_MAX_CYCLES 16
+
+/* a rotating range of entries. negative delays rotate backwards */
+typedef struct palette_cycle_t
+{
+	int first;
+	int last;
+	int delay;
+	int elapsed;
+} palette_cycle_t;
+
+/* palette entries sorted by green, for searching outwards from a green */
+typedef struct palette_search_t
+{
+	uint8_t r[PALETTE_SIZE];
+	uint8_t g[PALETTE_SIZE];
+	uint8_t b[PALETTE_SIZE];
+	uint8_t index[PALETTE_SIZE];
+} palette_search_t;
+
+/*
+ * the inverse colormap has a cell per 15-bit color, 5 bits each of red,
+ * green and blue, holding the palette entry nearest to that cell
+ */
+#define PALETTE_INVERSE_BITS 5
+#define PALETTE_INVERSE_SIZE (1 << (PALETTE_INVERSE_BITS * 3))
+
+/* the inverse colormap cell of an argb8888 color */
+#define PALETTE_INVERSE_CELL(c) ((((c) >> 9) & 0x7C00) | \
+	(((c) >> 6) & 0x03E0) | (((c) >> 3) & 0x001F))
+
+/*
+ * a 256 entry argb8888 palette. surface is a 256x1 surface holding the
+ * entries, so it can be handed to surface_set_palette. every change bumps
+ * version, and the expansion luts are only derived again when it moves
+ */
+typedef struct palette_t
+{
+	surface_t *surface;
+	uint32_t version;
+
+	/* color cycling */
+	int num_cycles;
+	palette_cycle_t cycles[PALETTE_MAX_CYCLES];
+
+	/* expansion luts and the versions they were derived from */
+	uint32_t lut32[PALETTE_SIZE];
+	uint16_t lut16[PALETTE_SIZE];
+	uint32_t lut32_version;
+	uint32_t lut16_version;
+
+	/* nearest color search table, derived again on version changes */
+	palette_search_t search;
+	uint32_t search_version;
+
+	/*
+	 * inverse colormap cache. allocated on the first batch query, and its
+	 * cells are only searched for when first hit, with a bit per cell in
+	 * inverse_filled. a version change just clears the bits
+	 */
+	uint8_t *inverse;
+	uint32_t *inverse_filled;
+	uint32_t inverse_version;
+
+	/* stats */
+	int lut_builds;
+	int inverse_fills;
+} palette_t;
+
+/* the entries of a palette */
+#define PALETTE_COLORS(p) ((uint32_t *)(p)->surface->pixels)
+
+/*
+ * an 8 bpp lookup table of rows of 256 indices. shade tables have one row
+ * per light level, blend tables have one row per source index so that
+ * COLORMAP_ROW(m, src)[dst] is the blended index
+ */
+typedef struct colormap_t
+{
+	int rows;
+	uint8_t *table;
+} colormap_t;
+
+/* row r of a colormap */
+#define COLORMAP_ROW(m, r) ((m)->table + (r) * PALETTE_SIZE)
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* palette creation and destruction */
+palette_t *palette_create(void);
+void palette_destroy(palette_t *p);
+
+/* palette entries */
+void palette_set(palette_t *p, int i, uint32_t color);
+void palette_set_range(palette_t *p, int first, int n, uint32_t *colors);
+uint32_t palette_get(palette_t *p, int i);
+int palette_load(palette_t *p, surface_t *s);
+void palette_copy(palette_t *src, palette_t *dst);
+
+/* palette fades */
+void palette_fade(palette_t *p, palette_t *from, palette_t *to, int t);
+void palette_fade_color(palette_t *p, palette_t *from, uint32_t color, int t);
+
+/* palette cycling */
+void palette_rotate(palette_t *p, int first, int last, int steps);
+int palette_cycle_add(palette_t *p, int first, int last, int delay);
+void palette_cycle_clear(palette_t *p);
+int palette_update(palette_t *p, int ms);
+
+/* palette expansion */
+uint32_t *palette_lut32(palette_t *p);
+uint16_t *palette_lut16(palette_t *p);
+void palette_expand(palette_t *p, surface_t *src, surface_t *dst, int dx,
+	int dy);
+
+/* colormap creation and destruction */
+colormap_t *colormap_create_shade(palette_t *p, int levels, uint32_t fog);
+colormap_t *colormap_create_blend(palette_t *p, int alpha);
+void colormap_destroy(colormap_t *m);
+
+/* colormap nearest color search */
+int palette_nearest(palette_t *p, int r, int g, int b);
+int palette_nearest_cached(palette_t *p, int r, int g, int b);
+void palette_map(palette_t *p, uint32_t *src, uint8_t *dst, int n);
+void palette_map_surface(palette_t *p, surface_t *src, surface_t *dst,
+	int dx, int dy);
+
+/* colormap spans and blits */
+void colormap_span(uint8_t *dst, uint8_t *src, int n, uint8_t *row);
+void colormap_span_blend(uint8_t *dst, uint8_t *src, int n, colormap_t *m);
+void colormap_blit(colormap_t *m, int row, surface_t *src, surface_t *dst,
+	int dx, int dy);
+void colormap_blit_blend(colormap_t *m, surface_t *src, surface_t *dst,
+	int dx, int dy);
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/*
+ * palette creation and destruction
+ */
+
+/* create a palette with all entries opaque black */
+palette_t *palette_create(void)
+{
+	/* variables */
+	palette_t *p;
+	int i;
+
+	/* alloc */
+	p = LIBREX_CALLOC(1, sizeof(palette_t));
+	if (!p) return NULL;
+
+	p->surface = surface_create(PALETTE_SIZE, 1, 32, NULL);
+	if (!p->surface)
+	{
+		LIBREX_FREE(p);
+		return NULL;
+	}
+
+	for (i = 0; i < PALETTE_SIZE; i++)
+		PALETTE_COLORS(p)[i] = 0xFF000000;
+
+	/* the luts start out stale */
+	p->version = 1;
+
+	return p;
+}
+
+/* destroy palette and free all associated memory */
+void palette_destroy(palette_t *p)
+{
+	if (p)
+	{
+		surface_destroy(p->surface);
+		if (p->inverse_filled) LIBREX_FREE(p->inverse_filled);
+		LIBREX_FREE(p);
+	}
+}
+
+/*
+ * palette entries
+ */
+
+/* set entry i */
+void palette_set(palette_t *p, int i, uint32_t color)
+{
+	/* sanity checks */
+	if (!p || i < 0 || i >= PALETTE_SIZE) return;
+
+	if (PALETTE_COLORS(p)[i] != color)
+	{
+		if (!surface_detach(p->surface)) return;
+
+		PALETTE_COLORS(p)[i] = color;
+		p->version++;
+	}
+}
+
+/* set n entries starting at first */
+void palette_set_range(palette_t *p, int first, int n, uint32_t *colors)
+{
+	/* sanity checks */
+	if (!p || !colors || first < 0 || n < 1) return;
+	if (first + n > PALETTE_SIZE) n = PALETTE_SIZE - first;
+	if (n < 1) return;
+
+	if (memcmp(PALETTE_COLORS(p) + first, colors, n * sizeof(uint32_t)) != 0)
+	{
+		if (!surface_detach(p->surface)) return;
+
+		memcpy(PALETTE_COLORS(p) + first, colors, n * sizeof(uint32_t));
+		p->version++;
+	}
+}
+
+/* get entry i */
+uint32_t palette_get(palette_t *p, int i)
+{
+	/* sanity checks */
+	if (!p || i < 0 || i >= PALETTE_SIZE) return 0;
+
+	return PALETTE_COLORS(p)[i];
+}
+
+/*
+ * load the entries of an argb8888 or rgb565 palette surface, as used with
+ * surface_set_palette. returns the number of entries loaded
+ */
+int palette_load(palette_t *p, surface_t *s)
+{
+	/* variables */
+	uint8_t rgb[PALETTE_SIZE * 3];
+	uint32_t colors[PALETTE_SIZE];
+	int i, n;
+
+	/* sanity checks */
+	if (!p) return 0;
+
+	n = dither_load_palette(s, rgb);
+
+	for (i = 0; i < n; i++)
+		colors[i] = pack_argb8888(rgb[i * 3 + 0], rgb[i * 3 + 1], rgb[i * 3 + 2], 255);
+
+	palette_set_range(p, 0, n, colors);
+
+	return n;
+}
+
+/* copy the entries of src to dst */
+void palette_copy(palette_t *src, palette_t *dst)
+{
+	/* sanity checks */
+	if (!src || !dst || src == dst) return;
+
+	palette_set_range(dst, 0, PALETTE_SIZE, PALETTE_COLORS(src));
+}
+
+/*
+ * palette fades
+ */
+
+/* mix two argb8888 colors, t from 0 to 256 */
+static uint32_t palette_mix(uint32_t a, uint32_t b, int t)
+{
+	/* variables */
+	uint32_t rb, ag;
+
+	/* two channels per multiply */
+	rb = (((a & 0x00FF00FF) * (256 - t) + (b & 0x00FF00FF) * t) >> 8) & 0x00FF00FF;
+	ag = ((((a >> 8) & 0x00FF00FF) * (256 - t) + ((b >> 8) & 0x00FF00FF) * t) >> 8) & 0x00FF00FF;
+
+	return rb | (ag << 8);
+}
+
+/*
+ * set p to the mix of from and to, t from 0 (all from) to 256 (all to).
+ * p may be the same palette as from or to
+ */
+void palette_fade(palette_t *p, palette_t *from, palette_t *to, int t)
+{
+	/* variables */
+	uint32_t colors[PALETTE_SIZE];
+	int i;
+
+	/* sanity checks */
+	if (!p || !from || !to) return;
+
+	t = CLAMP(t, 0, 256);
+
+	for (i = 0; i < PALETTE_SIZE; i++)
+		colors[i] = palette_mix(PALETTE_COLORS(from)[i], PALETTE_COLORS(to)[i], t);
+
+	palette_set_range(p, 0, PALETTE_SIZE, colors);
+}
+
+/* set p to the mix of from and a single color, t from 0 to 256 */
+void palette_fade_color(palette_t *p, palette_t *from, uint32_t color, int t)
+{
+	/* variables */
+	uint32_t colors[PALETTE_SIZE];
+	int i;
+
+	/* sanity checks */
+	if (!p || !from) return;
+
+	t = CLAMP(t, 0, 256);
+
+	for (i = 0; i < PALETTE_SIZE; i++)
+		colors[i] = palette_mix(PALETTE_COLORS(from)[i], color, t);
+
+	palette_set_range(p, 0, PALETTE_SIZE, colors);
+}
+
+/*
+ * palette cycling
+ */
+
+/*
+ * rotate the entries from first to last by steps. positive steps move every
+ * entry up by one, with last wrapping around to first
+ */
+void palette_rotate(palette_t *p, int first, int last, int steps)
+{
+	/* variables */
+	uint32_t colors[PALETTE_SIZE];
+	int i, n;
+
+	/* sanity checks */
+	if (!p || first < 0 || last >= PALETTE_SIZE || first >= last) return;
+
+	n = last - first + 1;
+	steps %= n;
+	if (steps < 0) steps += n;
+	if (!steps) return;
+
+	for (i = 0; i < n; i++)
+		colors[(i + steps) % n] = PALETTE_COLORS(p)[first + i];
+
+	palette_set_range(p, first, n, colors);
+}
+
+/*
+ * add a range that rotates one step every delay milliseconds of
+ * palette_update. returns the index of the cycle, or -1 if there's no room
+ */
+int palette_cycle_add(palette_t *p, int first, int last, int delay)
+{
+	/* variables */
+	palette_cycle_t *c;
+
+	/* sanity checks */
+	if (!p || first < 0 || last >= PALETTE_SIZE || first >= last) return -1;
+	if (!delay || p->num_cycles >= PALETTE_MAX_CYCLES) return -1;
+
+	c = &p->cycles[p->num_cycles];
+	c->first = first;
+	c->last = last;
+	c->delay = delay;
+	c->elapsed = 0;
+
+	return p->num_cycles++;
+}
+
+/* remove all cycles */
+void palette_cycle_clear(palette_t *p)
+{
+	/* sanity checks */
+	if (!p) return;
+
+	p->num_cycles = 0;
+}
+
+/*
+ * advance all cycles by ms milliseconds. returns non-zero if any entries
+ * moved, which is also when the palette version changes
+ */
+int palette_update(palette_t *p, int ms)
+{
+	/* variables */
+	palette_cycle_t *c;
+	uint32_t version;
+	int i, steps;
+
+	/* sanity checks */
+	if (!p || ms < 1) return 0;
+
+	version = p->version;
+
+	for (i = 0; i < p->num_cycles; i++)
+	{
+		c = &p->cycles[i];
+		c->elapsed += ms;
+
+		steps = c->elapsed / ABS(c->delay);
+		if (!steps) continue;
+
+		c->elapsed -= steps * ABS(c->delay);
+		palette_rotate(p, c->first, c->last, c->delay < 0 ? -steps : steps);
+	}
+
+	return p->version != version;
+}
+
+/*
+ * palette expansion
+ */
+
+/*
+ * clip src placed at dx, dy against the dst clip rectangle. returns zero if
+ * nothing is left
+ */
+static int palette_clip(surface_t *src, surface_t *dst, int dx, int dy,
+	int *sx, int *sy, int *w, int *h)
+{
+	*sx = MAX(dst->clip.x1 - dx, 0);
+	*sy = MAX(dst->clip.y1 - dy, 0);
+	*w = MIN(src->w, dst->clip.x2 - dx) - *sx;
+	*h = MIN(src->h, dst->clip.y2 - dy) - *sy;
+
+	return *w > 0 && *h > 0;
+}
+
+/* the argb8888 lut, forced opaque. only derived again on version changes */
+uint32_t *palette_lut32(palette_t *p)
+{
+	/* variables */
+	int i;
+
+	/* sanity checks */
+	if (!p) return NULL;
+
+	if (p->lut32_version != p->version)
+	{
+		for (i = 0; i < PALETTE_SIZE; i++)
+			p->lut32[i] = PALETTE_COLORS(p)[i] | 0xFF000000;
+
+		p->lut32_version = p->version;
+		p->lut_builds++;
+	}
+
+	return p->lut32;
+}
+
+/* the rgb565 lut. only derived again on version changes */
+uint16_t *palette_lut16(palette_t *p)
+{
+	/* variables */
+	uint32_t c;
+	int i;
+
+	/* sanity checks */
+	if (!p) return NULL;
+
+	if (p->lut16_version != p->version)
+	{
+		for (i = 0; i < PALETTE_SIZE; i++)
+		{
+			c = PALETTE_COLORS(p)[i];
+			p->lut16[i] = (uint16_t)(((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x001F));
+		}
+
+		p->lut16_version = p->version;
+		p->lut_builds++;
+	}
+
+	return p->lut16;
+}
+
+/*
+ * expand the 8 bpp surface src into the 16 or 32 bpp surface dst at dx, dy
+ * through the palette luts, clipped to the dst clip rectangle. fades and
+ * cycling only touch the palette, so a frame costs one lut lookup per pixel
+ * and a lut rebuild only when the palette changed
+ */
+void palette_expand(palette_t *p, surface_t *src, surface_t *dst, int dx,
+	int dy)
+{
+	/* variables */
+	int x, y, sx, sy, w, h;
+	uint32_t *lut32, *d32;
+	uint16_t *lut16, *d16;
+	uint8_t *s;
+
+	/* sanity checks */
+	if (!p || !src || !src->pixels || !dst || !dst->pixels) return;
+	if (src->bpp != 8 || (dst->bpp != 16 && dst->bpp != 32)) return;
+
+	/* clip against the dst clip rectangle */
+	if (!palette_clip(src, dst, dx, dy, &sx, &sy, &w, &h)) return;
+	if (!surface_detach(dst)) return;
+
+	if (dst->bpp == 32)
+	{
+		lut32 = palette_lut32(p);
+
+		for (y = 0; y < h; y++)
+		{
+			s = (uint8_t *)SURFACE_PTR(src, sx, sy + y);
+			d32 = (uint32_t *)SURFACE_PTR(dst, dx + sx, dy + sy + y);
+
+			/* start */
+			x = 0;
+
+			for (; x + 4 <= w; x += 4)
+			{
+				d32[x + 0] = lut32[s[x + 0]];
+				d32[x + 1] = lut32[s[x + 1]];
+				d32[x + 2] = lut32[s[x + 2]];
+				d32[x + 3] = lut32[s[x + 3]];
+			}
+
+			/* leftovers */
+			for (; x < w; x++)
+				d32[x] = lut32[s[x]];
+		}
+	}
+	else
+	{
+		lut16 = palette_lut16(p);
+
+		for (y = 0; y < h; y++)
+		{
+			s = (uint8_t *)SURFACE_PTR(src, sx, sy + y);
+			d16 = (uint16_t *)SURFACE_PTR(dst, dx + sx, dy + sy + y);
+
+			/* start */
+			x = 0;
+
+			for (; x + 4 <= w; x += 4)
+			{
+				d16[x + 0] = lut16[s[x + 0]];
+				d16[x + 1] = lut16[s[x + 1]];
+				d16[x + 2] = lut16[s[x + 2]];
+				d16[x + 3] = lut16[s[x + 3]];
+			}
+
+			/* leftovers */
+			for (; x < w; x++)
+				d16[x] = lut16[s[x]];
+		}
+	}
+}
+
+/*
+ * colormap nearest color search
+ */
+
+/* fill a search table from the entries of p */
+static void palette_search_init(palette_search_t *s, palette_t *p)
+{
+	/* variables */
+	int counts[257], i, j;
+	uint32_t c;
+
+	/* counting sort on green */
+	memset(counts, 0, sizeof(counts));
+
+	for (i = 0; i < PALETTE_SIZE; i++)
+		counts[((PALETTE_COLORS(p)[i] >> 8) & 0xFF) + 1]++;
+
+	for (i = 1; i < 257; i++)
+		counts[i] += counts[i - 1];
+
+	for (i = 0; i < PALETTE_SIZE; i++)
+	{
+		c = PALETTE_COLORS(p)[i];
+		j = counts[(c >> 8) & 0xFF]++;
+
+		s->r[j] = (c >> 16) & 0xFF;
+		s->g[j] = (c >> 8) & 0xFF;
+		s->b[j] = c & 0xFF;
+		s->index[j] = i;
+	}
+}
+
+/*
+ * the entry closest to r, g, b. the search walks outwards from the first
+ * entry at or above g and stops each way once the green distance alone is
+ * worse than the best match. ties go to the lowest index
+ */
+static int palette_search(palette_search_t *s, int r, int g, int b)
+{
+	/* variables */
+	int lo, hi, mid, d, dg, best, dist;
+
+	/* first entry with green at or above g */
+	lo = 0;
+	hi = PALETTE_SIZE;
+
+	while (lo < hi)
+	{
+		mid = (lo + hi) / 2;
+		if (s->g[mid] < g)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	best = 0;
+	dist = 0x7FFFFFFF;
+
+	/* upwards */
+	for (hi = lo; hi < PALETTE_SIZE; hi++)
+	{
+		dg = (s->g[hi] - g) * (s->g[hi] - g);
+		if (dg > dist) break;
+
+		d = dg + (s->r[hi] - r) * (s->r[hi] - r) + (s->b[hi] - b) * (s->b[hi] - b);
+		if (d < dist || (d == dist && s->index[hi] < best))
+		{
+			dist = d;
+			best = s->index[hi];
+		}
+	}
+
+	/* downwards */
+	for (lo = lo - 1; lo >= 0; lo--)
+	{
+		dg = (s->g[lo] - g) * (s->g[lo] - g);
+		if (dg > dist) break;
+
+		d = dg + (s->r[lo] - r) * (s->r[lo] - r) + (s->b[lo] - b) * (s->b[lo] - b);
+		if (d < dist || (d == dist && s->index[lo] < best))
+		{
+			dist = d;
+			best = s->index[lo];
+		}
+	}
+
+	return best;
+}
+
+/* the search table of p, sorted again only on version changes */
+static palette_search_t *palette_searcher(palette_t *p)
+{
+	if (p->search_version != p->version)
+	{
+		palette_search_init(&p->search, p);
+		p->search_version = p->version;
+	}
+
+	return &p->search;
+}
+
+/* the entry of p closest to r, g, b */
+int palette_nearest(palette_t *p, int r, int g, int b)
+{
+	/* sanity checks */
+	if (!p) return 0;
+
+	return palette_search(palette_searcher(p), r, g, b);
+}
+
+/*
+ * make the inverse colormap of p ready for lookups, allocating it on first
+ * use and emptying it if the palette changed. returns zero on failure
+ */
+static int palette_inverse_prepare(palette_t *p)
+{
+	if (!p->inverse_filled)
+	{
+		/* the fill bits first, then a byte per cell */
+		p->inverse_filled = (uint32_t *)LIBREX_MALLOC(
+			PALETTE_INVERSE_SIZE / 8 + PALETTE_INVERSE_SIZE);
+		if (!p->inverse_filled) return 0;
+
+		p->inverse = (uint8_t *)(p->inverse_filled + PALETTE_INVERSE_SIZE / 32);
+		p->inverse_version = p->version - 1;
+	}
+
+	if (p->inverse_version != p->version)
+	{
+		memset(p->inverse_filled, 0, PALETTE_INVERSE_SIZE / 8);
+		p->inverse_version = p->version;
+	}
+
+	return 1;
+}
+
+/*
+ * the entry for an inverse colormap cell, searching for it on first use.
+ * the cell stands for its color widened back to 8 bits, so black, white
+ * and the other corners of the cube are matched exactly
+ */
+static int palette_inverse_lookup(palette_t *p, int cell)
+{
+	if (!(p->inverse_filled[cell >> 5] & (1UL << (cell & 31))))
+	{
+		p->inverse[cell] = (uint8_t)palette_search(palette_searcher(p),
+			COLOR_EXPAND5(cell >> 10), COLOR_EXPAND5(cell >> 5),
+			COLOR_EXPAND5(cell));
+		p->inverse_filled[cell >> 5] |= 1UL << (cell & 31);
+		p->inverse_fills++;
+	}
+
+	return p->inverse[cell];
+}
+
+/*
+ * the entry of p closest to r, g, b at 5 bits per channel, through the
+ * inverse colormap. falls back to the exact search if the cache can't be
+ * allocated
+ */
+int palette_nearest_cached(palette_t *p, int r, int g, int b)
+{
+	/* sanity checks */
+	if (!p) return 0;
+
+	r = CLAMP(r, 0, 255);
+	g = CLAMP(g, 0, 255);
+	b = CLAMP(b, 0, 255);
+
+	if (!palette_inverse_prepare(p))
+		return palette_search(palette_searcher(p), r, g, b);
+
+	return palette_inverse_lookup(p, ((r >> 3) << 10) | ((g >> 3) << 5) | (b >> 3));
+}
+
+/*
+ * map n argb8888 colors to their nearest entries of p through the inverse
+ * colormap. alpha is ignored. runs of one color are only looked up once
+ */
+void palette_map(palette_t *p, uint32_t *src, uint8_t *dst, int n)
+{
+	/* variables */
+	int i, cell, last;
+	uint32_t c, prev;
+
+	/* sanity checks */
+	if (!p || !src || !dst || n < 1) return;
+
+	if (!palette_inverse_prepare(p))
+	{
+		for (i = 0; i < n; i++)
+		{
+			dst[i] = (uint8_t)palette_search(palette_searcher(p),
+				(src[i] >> 16) & 0xFF, (src[i] >> 8) & 0xFF, src[i] & 0xFF);
+		}
+
+		return;
+	}
+
+	prev = src[0] ^ 0x00FFFFFF;
+	last = 0;
+
+	for (i = 0; i < n; i++)
+	{
+		c = src[i] & 0x00FFFFFF;
+
+		if (c != prev)
+		{
+			cell = (int)PALETTE_INVERSE_CELL(c);
+
+			/* straight from the cache once a cell has been searched */
+			if (p->inverse_filled[cell >> 5] & (1UL << (cell & 31)))
+				last = p->inverse[cell];
+			else
+				last = palette_inverse_lookup(p, cell);
+
+			prev = c;
+		}
+
+		dst[i] = (uint8_t)last;
+	}
+}
+
+/*
+ * map the 32 bpp surface src onto the 8 bpp surface dst at dx, dy, clipped
+ * to the dst clip rectangle, with each pixel set to its nearest entry of p
+ */
+void palette_map_surface(palette_t *p, surface_t *src, surface_t *dst,
+	int dx, int dy)
+{
+	/* variables */
+	int y, sx, sy, w, h;
+
+	/* sanity checks */
+	if (!p || !src || !src->pixels || !dst || !dst->pixels) return;
+	if (src->bpp != 32 || dst->bpp != 8) return;
+
+	/* clip against the dst clip rectangle */
+	if (!palette_clip(src, dst, dx, dy, &sx, &sy, &w, &h)) return;
+	if (!surface_detach(dst)) return;
+
+	for (y = 0; y < h; y++)
+	{
+		palette_map(p, (uint32_t *)SURFACE_PTR(src, sx, sy + y),
+			SURFACE_PTR(dst, dx + sx, dy + sy + y), w);
+	}
+}
+
+/*
+ * colormap creation and destruction
+ */
+
+/* allocate a colormap of rows */
+static colormap_t *colormap_alloc(int rows)
+{
+	/* variables */
+	colormap_t *m;
+
+	m = LIBREX_CALLOC(1, sizeof(colormap_t));
+	if (!m) return NULL;
+
+	m->table = LIBREX_MALLOC(rows * PALETTE_SIZE);
+	if (!m->table)
+	{
+		LIBREX_FREE(m);
+		return NULL;
+	}
+
+	m->rows = rows;
+
+	return m;
+}
+
+/*
+ * build a shade table of levels rows. row 0 is the palette at full
+ * brightness, and each row after fades further towards fog, with the last
+ * row all fog. a black fog gives classic distance lighting
+ */
+colormap_t *colormap_create_shade(palette_t *p, int levels, uint32_t fog)
+{
+	/* variables */
+	palette_search_t *s;
+	colormap_t *m;
+	uint32_t c;
+	int l, i, t;
+
+	/* sanity checks */
+	if (!p || levels < 2) return NULL;
+
+	m = colormap_alloc(levels);
+	if (!m) return NULL;
+
+	s = palette_searcher(p);
+
+	for (l = 0; l < levels; l++)
+	{
+		t = l * 256 / (levels - 1);
+
+		for (i = 0; i < PALETTE_SIZE; i++)
+		{
+			c = palette_mix(PALETTE_COLORS(p)[i], fog, t);
+			COLORMAP_ROW(m, l)[i] = palette_search(s, (c >> 16) & 0xFF,
+				(c >> 8) & 0xFF, c & 0xFF);
+		}
+	}
+
+	return m;
+}
+
+/*
+ * build a 256x256 translucency table. alpha from 0 to 256 is the weight of
+ * the source index, so COLORMAP_ROW(m, src)[dst] is src over dst
+ */
+colormap_t *colormap_create_blend(palette_t *p, int alpha)
+{
+	/* variables */
+	palette_search_t *s;
+	colormap_t *m;
+	uint32_t c;
+	int i, j;
+
+	/* sanity checks */
+	if (!p) return NULL;
+
+	m = colormap_alloc(PALETTE_SIZE);
+	if (!m) return NULL;
+
+	alpha = CLAMP(alpha, 0, 256);
+	s = palette_searcher(p);
+
+	for (i = 0; i < PALETTE_SIZE; i++)
+	{
+		for (j = 0; j < PALETTE_SIZE; j++)
+		{
+			c = palette_mix(PALETTE_COLORS(p)[j], PALETTE_COLORS(p)[i], alpha);
+			COLORMAP_ROW(m, i)[j] = palette_search(s, (c >> 16) & 0xFF,
+				(c >> 8) & 0xFF, c & 0xFF);
+		}
+	}
+
+	return m;
+}
+
+/* destroy colormap and free all associated memory */
+void colormap_destroy(colormap_t *m)
+{
+	if (m)
+	{
+		if (m->table) LIBREX_FREE(m->table);
+		LIBREX_FREE(m);
+	}
+}
+
+/*
+ * colormap spans and blits
+ */
+
+/* remap n indices of src through a row of a colormap. dst may be src */
+void colormap_span(uint8_t *dst, uint8_t *src, int n, uint8_t *row)
+{
+	/* variables */
+	int x;
+
+	/* start */
+	x = 0;
+
+	for (; x + 4 <= n; x += 4)
+	{
+		dst[x + 0] = row[src[x + 0]];
+		dst[x + 1] = row[src[x + 1]];
+		dst[x + 2] = row[src[x + 2]];
+		dst[x + 3] = row[src[x + 3]];
+	}
+
+	/* leftovers */
+	for (; x < n; x++)
+		dst[x] = row[src[x]];
+}
+
+/* blend n indices of src over dst through a blend table */
+void colormap_span_blend(uint8_t *dst, uint8_t *src, int n, colormap_t *m)
+{
+	/* variables */
+	int x;
+
+	for (x = 0; x < n; x++)
+		dst[x] = m->table[(src[x] << 8) | dst[x]];
+}
+
+/* copy src to dst at dx, dy through row of a colormap */
+void colormap_blit(colormap_t *m, int row, surface_t *src, surface_t *dst,
+	int dx, int dy)
+{
+	/* variables */
+	int y, sx, sy, w, h;
+
+	/* sanity checks */
+	if (!m || row < 0 || row >= m->rows) return;
+	if (!src || !src->pixels || !dst || !dst->pixels) return;
+	if (src->bpp != 8 || dst->bpp != 8) return;
+	if (!palette_clip(src, dst, dx, dy, &sx, &sy, &w, &h)) return;
+	if (!surface_detach(dst)) return;
+
+	for (y = 0; y < h; y++)
+	{
+		colormap_span(SURFACE_PTR(dst, dx + sx, dy + sy + y),
+			SURFACE_PTR(src, sx, sy + y), w, COLORMAP_ROW(m, row));
+	}
+}
+
+/* blend src over dst at dx, dy through a blend table */
+void colormap_blit_blend(colormap_t *m, surface_t *src, surface_t *dst,
+	int dx, int dy)
+{
+	/* variables */
+	int y, sx, sy, w, h;
+
+	/* sanity checks */
+	if (!m || m->rows != PALETTE_SIZE) return;
+	if (!src || !src->pixels || !dst || !dst->pixels) return;
+	if (src->bpp != 8 || dst->bpp != 8) return;
+	if (!palette_clip(src, dst, dx, dy, &sx, &sy, &w, &h)) return;
+	if (!surface_detach(dst)) return;
+
+	for (y = 0; y < h; y++)
+	{
+		colormap_span_blend(SURFACE_PTR(dst, dx + sx, dy + sy + y),
+			SURFACE_PTR(src, sx, sy + y), w, m);
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_PAL_H__ */
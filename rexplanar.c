@@ -0,0 +1,102 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexplanar.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexplanar.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* rex */
+#include "rexplanar.h"
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	surface_t *src, *dst;
+	planar_t *a, *b;
+	int x, y;
+
+	/* create surfaces */
+	src = surface_create(203, 97, 32, NULL);
+	dst = surface_create(203, 97, 32, NULL);
+	a = planar_create(src->w, src->h);
+	b = planar_create(src->w, src->h);
+
+	/* fill source with a checkered gradient */
+	for (y = 0; y < src->h; y++)
+	{
+		for (x = 0; x < src->w; x++)
+		{
+			((uint32_t *)src->pixels)[y * src->w + x] = pack_argb8888(x,
+				y * 2, ((x / 8) ^ (y / 8)) & 1 ? 255 : 0, 255 - y);
+		}
+	}
+
+	/* print header */
+	printf("librex: rexplanar.h test\n");
+	printf("\n");
+
+	/* round trip */
+	planar_from_surface(src, a);
+	planar_to_surface(a, dst);
+	printf("round trip: %s\n", memcmp(src->pixels, dst->pixels,
+		src->bytes_per_row * src->h) ? "mismatch" : "ok");
+	printf("pixel 100, 50: r %u g %u b %u a %u\n",
+		*PLANAR_PTR(a, PLANAR_R, 100, 50), *PLANAR_PTR(a, PLANAR_G, 100, 50),
+		*PLANAR_PTR(a, PLANAR_B, 100, 50), *PLANAR_PTR(a, PLANAR_A, 100, 50));
+
+	/* blur the color planes and darken */
+	planar_blur(a, b, PLANAR_MASK_RGB);
+	memcpy(b->planes[PLANAR_A], a->planes[PLANAR_A], a->stride * a->h);
+	planar_modulate(b, PLANAR_MASK_RGB, 192);
+	planar_to_surface(b, dst);
+	printf("filtered 100, 50: %08lx\n",
+		(unsigned long)((uint32_t *)dst->pixels)[50 * dst->w + 100]);
+	surface_dump_buffer(dst, "rexplanar.data");
+
+	/* destroy surfaces */
+	planar_destroy(a);
+	planar_destroy(b);
+	surface_destroy(src);
+	surface_destroy(dst);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
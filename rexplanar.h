@@ -0,0 +1,530 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexplanar.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: planar surfaces
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_PLANAR_H__
+#define __LIBREX_PLANAR_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexcolor.h"
+#include "rexsurface.h"
+
+#endif
+
+/* simd */
+#ifdef LIBREX_SSE2
+#include <emmintrin.h>
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+/* plane indices */
+enum
+{
+	PLANAR_R,
+	PLANAR_G,
+	PLANAR_B,
+	PLANAR_A,
+	PLANAR_NUM_PLANES
+};
+
+/* plane masks */
+#define PLANAR_MASK_R (1 << PLANAR_R)
+#define PLANAR_MASK_G (1 << PLANAR_G)
+#define PLANAR_MASK_B (1 << PLANAR_B)
+#define PLANAR_MASK_A (1 << PLANAR_A)
+#define PLANAR_MASK_RGB (PLANAR_MASK_R | PLANAR_MASK_G | PLANAR_MASK_B)
+#define PLANAR_MASK_ALL (PLANAR_MASK_RGB | PLANAR_MASK_A)
+
+/*
+ * surface stored as four separate 8 bit planes. rows are padded to a
+ * multiple of 16 bytes so kernels can run whole vectors per row
+ */
+typedef struct planar_t
+{
+	int w;
+	int h;
+	int stride;
+	uint8_t *planes[PLANAR_NUM_PLANES];
+	void *buffer;
+} planar_t;
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* planar surface creation and destruction */
+planar_t *planar_create(int w, int h);
+void planar_destroy(planar_t *p);
+
+/* conversion to and from packed surfaces */
+void planar_from_surface(surface_t *src, planar_t *dst);
+void planar_to_surface(planar_t *src, surface_t *dst);
+
+/* filter kernels */
+void planar_blur(planar_t *src, planar_t *dst, int mask);
+void planar_modulate(planar_t *p, int mask, int scale);
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/* pointer to pixel x, y of plane i */
+#define PLANAR_PTR(p, i, x, y) ((p)->planes[(i)] + (y) * (p)->stride + (x))
+
+/*
+ * planar surface creation and destruction
+ */
+
+/* create a planar surface with all planes cleared */
+planar_t *planar_create(int w, int h)
+{
+	/* variables */
+	planar_t *ret;
+	size_t size;
+	int i;
+
+	/* sanity checks */
+	if (w < 1 || h < 1) return NULL;
+
+	/* alloc */
+	ret = (planar_t *)LIBREX_CALLOC(1, sizeof(planar_t));
+	if (!ret) return NULL;
+
+	/* assign values */
+	ret->w = w;
+	ret->h = h;
+	ret->stride = (w + 15) & ~15;
+
+	/* one buffer for all planes, padded for 16 byte alignment */
+	size = (size_t)ret->stride * h;
+	ret->buffer = LIBREX_CALLOC(1, size * PLANAR_NUM_PLANES + 15);
+	if (!ret->buffer)
+	{
+		LIBREX_FREE(ret);
+		return NULL;
+	}
+
+	ret->planes[0] = (uint8_t *)(((size_t)ret->buffer + 15) & ~(size_t)15);
+	for (i = 1; i < PLANAR_NUM_PLANES; i++)
+		ret->planes[i] = ret->planes[i - 1] + size;
+
+	/* return ptr */
+	return ret;
+}
+
+/* destroy planar surface and free all associated memory */
+void planar_destroy(planar_t *p)
+{
+	if (p)
+	{
+		if (p->buffer)
+			LIBREX_FREE(p->buffer);
+
+		LIBREX_FREE(p);
+	}
+}
+
+/*
+ * conversion to and from packed surfaces
+ */
+
+/* split one row of argb8888 pixels into planes */
+static void planar_deinterleave_argb8888(uint32_t *src, uint8_t *r,
+	uint8_t *g, uint8_t *b, uint8_t *a, int w)
+{
+	/* variables */
+	int x;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	{
+		/* variables */
+		__m128i p0, p1, p2, p3, m;
+
+		m = _mm_set1_epi32(0xFF);
+
+		for (; x + 16 <= w; x += 16)
+		{
+			p0 = _mm_loadu_si128((__m128i *)(src + x));
+			p1 = _mm_loadu_si128((__m128i *)(src + x + 4));
+			p2 = _mm_loadu_si128((__m128i *)(src + x + 8));
+			p3 = _mm_loadu_si128((__m128i *)(src + x + 12));
+
+			/* sixteen bytes of one channel from four vectors */
+			#define PLANAR_GATHER(shift, out) \
+				_mm_storeu_si128((__m128i *)(out + x), _mm_packus_epi16( \
+					_mm_packs_epi32( \
+						_mm_and_si128(_mm_srli_epi32(p0, shift), m), \
+						_mm_and_si128(_mm_srli_epi32(p1, shift), m)), \
+					_mm_packs_epi32( \
+						_mm_and_si128(_mm_srli_epi32(p2, shift), m), \
+						_mm_and_si128(_mm_srli_epi32(p3, shift), m))))
+
+			PLANAR_GATHER(0, b);
+			PLANAR_GATHER(8, g);
+			PLANAR_GATHER(16, r);
+			PLANAR_GATHER(24, a);
+
+			#undef PLANAR_GATHER
+		}
+	}
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < w; x++)
+	{
+		b[x] = (uint8_t)src[x];
+		g[x] = (uint8_t)(src[x] >> 8);
+		r[x] = (uint8_t)(src[x] >> 16);
+		a[x] = (uint8_t)(src[x] >> 24);
+	}
+}
+
+/* merge planes into one row of argb8888 pixels */
+static void planar_interleave_argb8888(uint8_t *r, uint8_t *g, uint8_t *b,
+	uint8_t *a, uint32_t *dst, int w)
+{
+	/* variables */
+	int x;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	{
+		/* variables */
+		__m128i vr, vg, vb, va, bg, ra;
+
+		for (; x + 16 <= w; x += 16)
+		{
+			vr = _mm_loadu_si128((__m128i *)(r + x));
+			vg = _mm_loadu_si128((__m128i *)(g + x));
+			vb = _mm_loadu_si128((__m128i *)(b + x));
+			va = _mm_loadu_si128((__m128i *)(a + x));
+
+			/* bytes in memory order b, g, r, a */
+			bg = _mm_unpacklo_epi8(vb, vg);
+			ra = _mm_unpacklo_epi8(vr, va);
+			_mm_storeu_si128((__m128i *)(dst + x), _mm_unpacklo_epi16(bg, ra));
+			_mm_storeu_si128((__m128i *)(dst + x + 4), _mm_unpackhi_epi16(bg, ra));
+
+			bg = _mm_unpackhi_epi8(vb, vg);
+			ra = _mm_unpackhi_epi8(vr, va);
+			_mm_storeu_si128((__m128i *)(dst + x + 8), _mm_unpacklo_epi16(bg, ra));
+			_mm_storeu_si128((__m128i *)(dst + x + 12), _mm_unpackhi_epi16(bg, ra));
+		}
+	}
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < w; x++)
+		dst[x] = pack_argb8888(r[x], g[x], b[x], a[x]);
+}
+
+/*
+ * split a packed surface into planes. 32 bpp surfaces are argb8888, 16 bpp
+ * surfaces are rgb565 with opaque alpha
+ */
+void planar_from_surface(surface_t *src, planar_t *dst)
+{
+	/* variables */
+	int x, y;
+	uint16_t *s16;
+
+	/* sanity checks */
+	if (!src || !src->pixels || !dst) return;
+	if (src->w != dst->w || src->h != dst->h) return;
+
+	for (y = 0; y < src->h; y++)
+	{
+		switch (src->bpp)
+		{
+			case 32:
+				planar_deinterleave_argb8888(
+					(uint32_t *)SURFACE_PTR(src, 0, y),
+					PLANAR_PTR(dst, PLANAR_R, 0, y),
+					PLANAR_PTR(dst, PLANAR_G, 0, y),
+					PLANAR_PTR(dst, PLANAR_B, 0, y),
+					PLANAR_PTR(dst, PLANAR_A, 0, y), src->w);
+				break;
+
+			case 16:
+				s16 = (uint16_t *)SURFACE_PTR(src, 0, y);
+				for (x = 0; x < src->w; x++)
+				{
+					*PLANAR_PTR(dst, PLANAR_R, x, y) = unpack_rgb565_red(s16[x]);
+					*PLANAR_PTR(dst, PLANAR_G, x, y) = unpack_rgb565_green(s16[x]);
+					*PLANAR_PTR(dst, PLANAR_B, x, y) = unpack_rgb565_blue(s16[x]);
+					*PLANAR_PTR(dst, PLANAR_A, x, y) = 255;
+				}
+				break;
+
+			default:
+				return;
+		}
+	}
+}
+
+/* merge planes into a packed 32 bpp argb8888 or 16 bpp rgb565 surface */
+void planar_to_surface(planar_t *src, surface_t *dst)
+{
+	/* variables */
+	int x, y;
+	uint16_t *d16;
+
+	/* sanity checks */
+	if (!src || !dst || !dst->pixels) return;
+	if (src->w != dst->w || src->h != dst->h) return;
+	if (!surface_detach(dst)) return;
+
+	for (y = 0; y < dst->h; y++)
+	{
+		switch (dst->bpp)
+		{
+			case 32:
+				planar_interleave_argb8888(
+					PLANAR_PTR(src, PLANAR_R, 0, y),
+					PLANAR_PTR(src, PLANAR_G, 0, y),
+					PLANAR_PTR(src, PLANAR_B, 0, y),
+					PLANAR_PTR(src, PLANAR_A, 0, y),
+					(uint32_t *)SURFACE_PTR(dst, 0, y), dst->w);
+				break;
+
+			case 16:
+				d16 = (uint16_t *)SURFACE_PTR(dst, 0, y);
+				for (x = 0; x < dst->w; x++)
+				{
+					d16[x] = pack_rgb565(*PLANAR_PTR(src, PLANAR_R, x, y),
+						*PLANAR_PTR(src, PLANAR_G, x, y),
+						*PLANAR_PTR(src, PLANAR_B, x, y));
+				}
+				break;
+
+			default:
+				return;
+		}
+	}
+}
+
+/*
+ * filter kernels
+ */
+
+/* rounded average, matches pavgb */
+#define PLANAR_AVG(a, b) (((a) + (b) + 1) >> 1)
+
+/* [1 2 1] / 4 of three rows or columns, as avg(avg(a, c), b) */
+static void planar_blur_row(uint8_t *a, uint8_t *b, uint8_t *c, uint8_t *dst,
+	int w)
+{
+	/* variables */
+	int x;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	for (; x + 16 <= w; x += 16)
+	{
+		_mm_storeu_si128((__m128i *)(dst + x), _mm_avg_epu8(
+			_mm_avg_epu8(_mm_loadu_si128((__m128i *)(a + x)),
+				_mm_loadu_si128((__m128i *)(c + x))),
+			_mm_loadu_si128((__m128i *)(b + x))));
+	}
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < w; x++)
+		dst[x] = (uint8_t)PLANAR_AVG(PLANAR_AVG(a[x], c[x]), b[x]);
+}
+
+/*
+ * separable [1 2 1] blur of the planes selected by mask, edges are clamped.
+ * src and dst must be the same size and must not be the same surface
+ */
+void planar_blur(planar_t *src, planar_t *dst, int mask)
+{
+	/* variables */
+	uint8_t *tmp, *row, *up, *down;
+	int i, y, w;
+
+	/* sanity checks */
+	if (!src || !dst || src == dst) return;
+	if (src->w != dst->w || src->h != dst->h) return;
+
+	/* padded row for the horizontal pass */
+	w = src->w;
+	tmp = (uint8_t *)LIBREX_MALLOC(w + 2);
+	if (!tmp) return;
+
+	for (i = 0; i < PLANAR_NUM_PLANES; i++)
+	{
+		if (!(mask & (1 << i)))
+			continue;
+
+		/* vertical pass */
+		for (y = 0; y < src->h; y++)
+		{
+			row = PLANAR_PTR(src, i, 0, y);
+			up = PLANAR_PTR(src, i, 0, y > 0 ? y - 1 : 0);
+			down = PLANAR_PTR(src, i, 0, y < src->h - 1 ? y + 1 : y);
+
+			planar_blur_row(up, row, down, PLANAR_PTR(dst, i, 0, y), w);
+		}
+
+		/* horizontal pass, in place through a clamped copy */
+		for (y = 0; y < dst->h; y++)
+		{
+			row = PLANAR_PTR(dst, i, 0, y);
+
+			memcpy(tmp + 1, row, w);
+			tmp[0] = row[0];
+			tmp[w + 1] = row[w - 1];
+
+			planar_blur_row(tmp, tmp + 1, tmp + 2, row, w);
+		}
+	}
+
+	LIBREX_FREE(tmp);
+}
+
+/* scale the planes selected by mask by scale / 256, saturating at 255 */
+void planar_modulate(planar_t *p, int mask, int scale)
+{
+	/* variables */
+	uint8_t *row;
+	int i, x, y, v;
+
+	/* sanity checks */
+	if (!p) return;
+	if (scale < 0) scale = 0;
+	if (scale > 0x7FFF) scale = 0x7FFF;
+
+	for (i = 0; i < PLANAR_NUM_PLANES; i++)
+	{
+		if (!(mask & (1 << i)))
+			continue;
+
+		for (y = 0; y < p->h; y++)
+		{
+			row = PLANAR_PTR(p, i, 0, y);
+			x = 0;
+
+#ifdef LIBREX_SSE2
+			{
+				/* variables */
+				__m128i z, s, lo, hi, v16;
+
+				z = _mm_setzero_si128();
+				s = _mm_set1_epi16((short)scale);
+
+				/* rows are padded, so whole vectors are always safe */
+				for (; x < p->w; x += 16)
+				{
+					v16 = _mm_load_si128((__m128i *)(row + x));
+
+					/* (v * scale) >> 8, via the high and low halves */
+					lo = _mm_unpacklo_epi8(v16, z);
+					hi = _mm_unpackhi_epi8(v16, z);
+					lo = _mm_or_si128(_mm_srli_epi16(_mm_mullo_epi16(lo, s), 8),
+						_mm_slli_epi16(_mm_mulhi_epu16(lo, s), 8));
+					hi = _mm_or_si128(_mm_srli_epi16(_mm_mullo_epi16(hi, s), 8),
+						_mm_slli_epi16(_mm_mulhi_epu16(hi, s), 8));
+
+					_mm_store_si128((__m128i *)(row + x), _mm_packus_epi16(lo, hi));
+				}
+			}
+#endif
+
+			/* scalar path */
+			for (; x < p->w; x++)
+			{
+				v = (row[x] * scale) >> 8;
+				row[x] = (uint8_t)(v > 255 ? 255 : v);
+			}
+		}
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_PLANAR_H__ */
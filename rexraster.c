@@ -0,0 +1,164 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexraster.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexraster.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* rex */
+#include "rexraster.h"
+
+/* set a vertex */
+static void set_vertex(raster_vertex_t *v, float x, float y, float z,
+	float u, float w)
+{
+	v->x = REAL(x);
+	v->y = REAL(y);
+	v->z = REAL(z);
+	v->u = REAL(u);
+	v->v = REAL(w);
+}
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	surface_t *tex8, *tex32, *dst8, *dst32;
+	raster_vertex_t v[4];
+	uint8_t colormap[256];
+	color_t white;
+	int x, y, h;
+	fix32 dist;
+
+	/* create surfaces */
+	tex8 = surface_create(64, 64, 8, NULL);
+	tex32 = surface_create(64, 64, 32, NULL);
+	dst8 = surface_create(320, 200, 8, NULL);
+	dst32 = surface_create(320, 200, 32, NULL);
+
+	/* checkerboard textures */
+	for (y = 0; y < 64; y++)
+	{
+		for (x = 0; x < 64; x++)
+		{
+			((uint8_t *)tex8->pixels)[y * 64 + x] = ((x ^ y) & 8) ? 255 : 64;
+			((uint32_t *)tex32->pixels)[y * 64 + x] = ((x ^ y) & 8) ?
+				pack_argb8888(255, 255, 255, 255) : pack_argb8888(64, 0, 0, 255);
+		}
+	}
+
+	/* half brightness colormap */
+	for (x = 0; x < 256; x++)
+		colormap[x] = (uint8_t)(x / 2);
+
+	/* a floor receding into the distance, projected from z = 1 to z = 8 */
+	set_vertex(&v[0], 40, 199, 1, 0, 0);
+	set_vertex(&v[1], 280, 199, 1, 256, 0);
+	set_vertex(&v[2], 175, 77.375f, 8, 256, 256);
+	set_vertex(&v[3], 145, 77.375f, 8, 0, 256);
+
+	/* print header */
+	printf("librex: rexraster.h test\n");
+	printf("\n");
+
+	/* draw */
+	raster_triangle_textured(dst8, tex8, &v[0], &v[1], &v[2], colormap);
+	raster_triangle_textured(dst8, tex8, &v[0], &v[2], &v[3], colormap);
+	raster_triangle_textured(dst32, tex32, &v[0], &v[1], &v[2], NULL);
+	raster_triangle_textured(dst32, tex32, &v[0], &v[2], &v[3], NULL);
+
+	printf("index8 at 160,190: %u\n", ((uint8_t *)dst8->pixels)[190 * 320 + 160]);
+	printf("index8 at 160,80: %u\n", ((uint8_t *)dst8->pixels)[80 * 320 + 160]);
+	printf("argb8888 at 160,190: %08x\n", ((uint32_t *)dst32->pixels)[190 * 320 + 160]);
+
+	/* flat triangle */
+	color_set_argb8888(&white, 255, 255, 255, 255);
+	set_vertex(&v[0], 10, 10, 1, 0, 0);
+	set_vertex(&v[1], 50, 10, 1, 0, 0);
+	set_vertex(&v[2], 10, 50, 1, 0, 0);
+	raster_triangle(dst32, &v[0], &v[1], &v[2], &white);
+
+	printf("flat at 20,20: %08x\n", ((uint32_t *)dst32->pixels)[20 * 320 + 20]);
+
+	/* save surfaces */
+	surface_dump_buffer(dst8, "raster8.data");
+	surface_dump_buffer(dst32, "raster32.data");
+
+	/* a wall of columns that gets taller to the right, like a raycaster */
+	for (x = 0; x < 320; x++)
+	{
+		h = 40 + x / 2;
+
+		raster_column(dst8, tex8, x, 100 - h / 2, 100 + h / 2, x / 4,
+			0, FIX32(64) / h, x < 160 ? colormap : NULL);
+		raster_column(dst32, tex32, x, 100 - h / 2, 100 + h / 2, x / 4,
+			0, FIX32(64) / h, x < 160 ? colormap : NULL);
+	}
+
+	/* floor spans below it, with the step growing with distance */
+	for (y = 180; y < 200; y++)
+	{
+		dist = FIX32(2000) / (y - 100);
+
+		raster_span(dst8, tex8, y, 0, 320, 0, dist * 4,
+			dist / 16, 0, NULL);
+		raster_span(dst32, tex32, y, 0, 320, 0, dist * 4,
+			dist / 16, 0, NULL);
+	}
+
+	printf("column at 10,100: %u %08x\n",
+		((uint8_t *)dst8->pixels)[100 * 320 + 10],
+		((uint32_t *)dst32->pixels)[100 * 320 + 10]);
+	printf("span at 300,190: %u %08x\n",
+		((uint8_t *)dst8->pixels)[190 * 320 + 300],
+		((uint32_t *)dst32->pixels)[190 * 320 + 300]);
+
+	/* save surfaces */
+	surface_dump_buffer(dst8, "columns8.data");
+	surface_dump_buffer(dst32, "columns32.data");
+
+	/* destroy */
+	surface_destroy(tex8);
+	surface_destroy(tex32);
+	surface_destroy(dst8);
+	surface_destroy(dst32);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,931 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexraster.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: triangle rasterization
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_RASTER_H__
+#define __LIBREX_RASTER_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexmath.h"
+#include "rexfloat.h"
+#include "rexfixed.h"
+#include "rexreal.h"
+#include "rexcolor.h"
+#include "rexmem.h"
+#include "rexsurface.h"
+#include "rextile.h"
+
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+/*
+ * perspective is corrected every 2^RASTER_SUBDIV_SHIFT pixels and
+ * interpolated linearly in between. 3 (8 pixels) or 4 (16 pixels)
+ */
+#ifndef RASTER_SUBDIV_SHIFT
+#define RASTER_SUBDIV_SHIFT 4
+#endif
+
+#define RASTER_SUBDIV (1 << RASTER_SUBDIV_SHIFT)
+
+/* triangle vertex. x and y in pixels, z in view space, u and v in texels */
+typedef struct raster_vertex_t
+{
+	real_t x;
+	real_t y;
+	real_t z;
+	real_t u;
+	real_t v;
+} raster_vertex_t;
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* triangle drawing */
+void raster_triangle(surface_t *dst, raster_vertex_t *v0, raster_vertex_t *v1,
+	raster_vertex_t *v2, color_t *c);
+void raster_triangle_textured(surface_t *dst, surface_t *tex,
+	raster_vertex_t *v0, raster_vertex_t *v1, raster_vertex_t *v2,
+	const uint8_t *colormap);
+void raster_triangle_tiled(surface_t *dst, tiled_t *tex,
+	raster_vertex_t *v0, raster_vertex_t *v1, raster_vertex_t *v2,
+	const uint8_t *colormap);
+
+/* column and span drawing */
+void raster_column(surface_t *dst, surface_t *tex, int x, int y1, int y2,
+	int u, fix32 v, fix32 dv, const uint8_t *colormap);
+void raster_span(surface_t *dst, surface_t *tex, int y, int x1, int x2,
+	fix32 u, fix32 v, fix32 du, fix32 dv, const uint8_t *colormap);
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/*
+ * internal helpers
+ */
+
+/* span callback used by the edge walker */
+typedef void (*raster_spanf)(void *ctx, int y, int x1, int x2);
+
+/* flat fill context */
+typedef struct raster_flat_t
+{
+	surface_t *dst;
+	color_t *c;
+} raster_flat_t;
+
+/* textured fill context */
+typedef struct raster_tex_t
+{
+	surface_t *dst;
+	surface_t *tex;
+	tiled_t *tiled;
+	const uint8_t *colormap;
+	float32 x0, y0;
+	float32 iz, iz_dx, iz_dy;
+	float32 uz, uz_dx, uz_dy;
+	float32 vz, vz_dx, vz_dy;
+} raster_tex_t;
+
+/* pointer to row y of a surface */
+#define RASTER_ROW(s, y) ((uint8_t *)(s)->pixels + (y) * (s)->bytes_per_row)
+
+/* float to 16.16 fixed */
+#define RASTER_FIX(a) ((fix32)((a) * 65536.0f))
+
+/* smallest integer >= a */
+static int raster_ceil(float32 a)
+{
+	/* variables */
+	int i;
+
+	i = (int)a;
+	return (float32)i < a ? i + 1 : i;
+}
+
+/*
+ * walk the edges of a triangle and emit one span per covered scanline.
+ * pixel centers are at +0.5, spans cover x1 to x2 exclusive
+ */
+static void raster_walk(surface_t *dst, float32 *x, float32 *y,
+	raster_spanf spanf, void *ctx)
+{
+	/* variables */
+	int i, t, iy, y1, y2, x1, x2;
+	int order[3];
+	float32 yc, xa, xb, dxa, dxb, dxc;
+	float32 ax, ay, bx, by, cx, cy;
+
+	/* sort by y */
+	order[0] = 0;
+	order[1] = 1;
+	order[2] = 2;
+
+	for (i = 0; i < 2; i++)
+	{
+		if (y[order[1]] < y[order[0]])
+		{
+			t = order[0];
+			order[0] = order[1];
+			order[1] = t;
+		}
+
+		if (y[order[2]] < y[order[1]])
+		{
+			t = order[1];
+			order[1] = order[2];
+			order[2] = t;
+		}
+	}
+
+	/* top, middle and bottom */
+	ax = x[order[0]];
+	ay = y[order[0]];
+	bx = x[order[1]];
+	by = y[order[1]];
+	cx = x[order[2]];
+	cy = y[order[2]];
+
+	/* degenerate */
+	if (cy <= ay) return;
+
+	/* scanline range, clipped to the clip rectangle */
+	y1 = MAX(raster_ceil(ay - 0.5f), dst->clip.y1);
+	y2 = MIN(raster_ceil(cy - 0.5f), dst->clip.y2);
+	if (y1 >= y2) return;
+
+	/* fully clipped horizontally */
+	if (MAX(MAX(ax, bx), cx) < (float32)dst->clip.x1) return;
+	if (MIN(MIN(ax, bx), cx) > (float32)dst->clip.x2) return;
+
+	/* shared pixels are copied before the first write */
+	if (!surface_detach(dst)) return;
+
+	/* edge slopes */
+	dxa = (cx - ax) / (cy - ay);
+	dxb = by > ay ? (bx - ax) / (by - ay) : 0.0f;
+	dxc = cy > by ? (cx - bx) / (cy - by) : 0.0f;
+
+	for (iy = y1; iy < y2; iy++)
+	{
+		yc = (float32)iy + 0.5f;
+
+		/* long edge */
+		xa = ax + (yc - ay) * dxa;
+
+		/* short edge, upper or lower half */
+		if (yc < by)
+			xb = ax + (yc - ay) * dxb;
+		else
+			xb = bx + (yc - by) * dxc;
+
+		/* order and convert to pixel columns */
+		if (xa > xb)
+		{
+			x1 = raster_ceil(xb - 0.5f);
+			x2 = raster_ceil(xa - 0.5f);
+		}
+		else
+		{
+			x1 = raster_ceil(xa - 0.5f);
+			x2 = raster_ceil(xb - 0.5f);
+		}
+
+		/* clip and emit */
+		x1 = MAX(x1, dst->clip.x1);
+		x2 = MIN(x2, dst->clip.x2);
+
+		if (x1 < x2)
+			spanf(ctx, iy, x1, x2);
+	}
+}
+
+/* flat colored span */
+static void raster_span_flat(void *ctx, int y, int x1, int x2)
+{
+	/* variables */
+	raster_flat_t *f = (raster_flat_t *)ctx;
+	uint8_t *row;
+
+	row = RASTER_ROW(f->dst, y);
+
+	switch (f->dst->bpp)
+	{
+		case 8:
+			memset8(row + x1, f->c->val.u8, x2 - x1);
+			break;
+
+		case 16:
+			memset16(row + x1 * 2, f->c->val.u16, x2 - x1);
+			break;
+
+		case 32:
+			memset32(row + x1 * 4, f->c->val.u32, x2 - x1);
+			break;
+
+		default:
+			break;
+	}
+}
+
+/*
+ * perspective correct textured span. u/z, v/z and 1/z are interpolated
+ * linearly in screen space, and u and v are only recovered with a divide
+ * at the ends of each subdivision. in between they step affinely
+ */
+static void raster_span_textured(void *ctx, int y, int x1, int x2)
+{
+	/* variables */
+	raster_tex_t *t = (raster_tex_t *)ctx;
+	float32 fx, fy, iz, uz, vz, z;
+	float32 iz_step, uz_step, vz_step;
+	fix32 u, v, u1, v1, du, dv;
+	int n, i, umask, vmask;
+	uint8_t *drow, *src8;
+	uint32_t *src32;
+	int pitch;
+
+	/* attributes at the center of the first pixel */
+	fx = (float32)x1 + 0.5f - t->x0;
+	fy = (float32)y + 0.5f - t->y0;
+
+	iz = t->iz + fx * t->iz_dx + fy * t->iz_dy;
+	uz = t->uz + fx * t->uz_dx + fy * t->uz_dy;
+	vz = t->vz + fx * t->vz_dx + fy * t->vz_dy;
+
+	/* whole subdivision steps */
+	iz_step = t->iz_dx * RASTER_SUBDIV;
+	uz_step = t->uz_dx * RASTER_SUBDIV;
+	vz_step = t->vz_dx * RASTER_SUBDIV;
+
+	/* texture addressing, sizes are powers of two */
+	if (t->tiled)
+	{
+		umask = t->tiled->umask;
+		vmask = t->tiled->vmask;
+		pitch = 0;
+	}
+	else
+	{
+		umask = t->tex->w - 1;
+		vmask = t->tex->h - 1;
+		pitch = t->tex->bytes_per_row;
+	}
+
+	/* first divide */
+	z = 1.0f / iz;
+	u = RASTER_FIX(uz * z);
+	v = RASTER_FIX(vz * z);
+
+	drow = RASTER_ROW(t->dst, y);
+
+	while (x1 < x2)
+	{
+		n = MIN(x2 - x1, RASTER_SUBDIV);
+
+		/*
+		 * one divide per subdivision. the last one ends on the last
+		 * pixel of the span instead of one past it
+		 */
+		if (x2 - x1 > RASTER_SUBDIV)
+		{
+			iz += iz_step;
+			uz += uz_step;
+			vz += vz_step;
+
+			z = 1.0f / iz;
+			u1 = RASTER_FIX(uz * z);
+			v1 = RASTER_FIX(vz * z);
+
+			du = (u1 - u) >> RASTER_SUBDIV_SHIFT;
+			dv = (v1 - v) >> RASTER_SUBDIV_SHIFT;
+		}
+		else if (n > 1)
+		{
+			iz += t->iz_dx * (n - 1);
+			uz += t->uz_dx * (n - 1);
+			vz += t->vz_dx * (n - 1);
+
+			z = 1.0f / iz;
+			u1 = RASTER_FIX(uz * z);
+			v1 = RASTER_FIX(vz * z);
+
+			du = (u1 - u) / (n - 1);
+			dv = (v1 - v) / (n - 1);
+		}
+		else
+		{
+			u1 = u;
+			v1 = v;
+			du = 0;
+			dv = 0;
+		}
+
+		/* inner loops */
+		if (t->tiled)
+		{
+			/* layout agnostic, through the offset tables */
+			if (t->tiled->bpp == 8 && t->colormap)
+			{
+				src8 = (uint8_t *)t->tiled->pixels;
+
+				for (i = 0; i < n; i++)
+				{
+					drow[x1 + i] = t->colormap[src8[t->tiled->xoffs[(u >> 16) & umask] + t->tiled->yoffs[(v >> 16) & vmask]]];
+					u += du;
+					v += dv;
+				}
+			}
+			else
+			{
+				tiled_sample_span(t->tiled, drow + x1 * (t->tiled->bpp / 8),
+					n, u, v, du, dv);
+			}
+		}
+		else if (t->tex->bpp == 8)
+		{
+			src8 = (uint8_t *)t->tex->pixels;
+
+			if (t->colormap)
+			{
+				for (i = 0; i < n; i++)
+				{
+					drow[x1 + i] = t->colormap[src8[((v >> 16) & vmask) * pitch + ((u >> 16) & umask)]];
+					u += du;
+					v += dv;
+				}
+			}
+			else
+			{
+				for (i = 0; i < n; i++)
+				{
+					drow[x1 + i] = src8[((v >> 16) & vmask) * pitch + ((u >> 16) & umask)];
+					u += du;
+					v += dv;
+				}
+			}
+		}
+		else
+		{
+			for (i = 0; i < n; i++)
+			{
+				src32 = (uint32_t *)((uint8_t *)t->tex->pixels + ((v >> 16) & vmask) * pitch);
+				((uint32_t *)drow)[x1 + i] = src32[(u >> 16) & umask];
+				u += du;
+				v += dv;
+			}
+		}
+
+		/* resync to the exact values to avoid drift */
+		u = u1;
+		v = v1;
+		x1 += n;
+	}
+}
+
+/*
+ * triangle drawing
+ */
+
+/* draw a flat colored triangle */
+void raster_triangle(surface_t *dst, raster_vertex_t *v0, raster_vertex_t *v1,
+	raster_vertex_t *v2, color_t *c)
+{
+	/* variables */
+	raster_flat_t f;
+	float32 x[3], y[3];
+
+	/* sanity checks */
+	if (!dst || !dst->pixels || !v0 || !v1 || !v2 || !c) return;
+	if (c->tag == INDEX8 && dst->bpp != 8) return;
+	if (c->tag == RGB565 && dst->bpp != 16) return;
+	if (c->tag == RGBA8888 && dst->bpp != 32) return;
+	if (c->tag == ARGB8888 && dst->bpp != 32) return;
+
+	/* positions */
+	x[0] = REAL_TO_FLOAT32(v0->x); y[0] = REAL_TO_FLOAT32(v0->y);
+	x[1] = REAL_TO_FLOAT32(v1->x); y[1] = REAL_TO_FLOAT32(v1->y);
+	x[2] = REAL_TO_FLOAT32(v2->x); y[2] = REAL_TO_FLOAT32(v2->y);
+
+	/* fill */
+	f.dst = dst;
+	f.c = c;
+	raster_walk(dst, x, y, raster_span_flat, &f);
+}
+
+/*
+ * set up the screen space gradients of a textured triangle. returns 0 if
+ * the triangle is degenerate or crosses the near plane
+ */
+static int raster_setup_textured(raster_tex_t *t, raster_vertex_t *v0,
+	raster_vertex_t *v1, raster_vertex_t *v2, float32 *x, float32 *y)
+{
+	/* variables */
+	raster_vertex_t *v[3];
+	float32 iz[3], uz[3], vz[3];
+	float32 area, dx1, dy1, dx2, dy2;
+	int i;
+
+	v[0] = v0;
+	v[1] = v1;
+	v[2] = v2;
+
+	/* project attributes into screen space */
+	for (i = 0; i < 3; i++)
+	{
+		x[i] = REAL_TO_FLOAT32(v[i]->x);
+		y[i] = REAL_TO_FLOAT32(v[i]->y);
+
+		if (REAL_TO_FLOAT32(v[i]->z) <= 0.0f) return 0;
+
+		iz[i] = 1.0f / REAL_TO_FLOAT32(v[i]->z);
+		uz[i] = REAL_TO_FLOAT32(v[i]->u) * iz[i];
+		vz[i] = REAL_TO_FLOAT32(v[i]->v) * iz[i];
+	}
+
+	/* twice the signed area */
+	dx1 = x[1] - x[0];
+	dy1 = y[1] - y[0];
+	dx2 = x[2] - x[0];
+	dy2 = y[2] - y[0];
+	area = dx1 * dy2 - dx2 * dy1;
+	if (area == 0.0f) return 0;
+
+	/* screen space gradients */
+	t->iz_dx = ((iz[1] - iz[0]) * dy2 - (iz[2] - iz[0]) * dy1) / area;
+	t->iz_dy = ((iz[2] - iz[0]) * dx1 - (iz[1] - iz[0]) * dx2) / area;
+	t->uz_dx = ((uz[1] - uz[0]) * dy2 - (uz[2] - uz[0]) * dy1) / area;
+	t->uz_dy = ((uz[2] - uz[0]) * dx1 - (uz[1] - uz[0]) * dx2) / area;
+	t->vz_dx = ((vz[1] - vz[0]) * dy2 - (vz[2] - vz[0]) * dy1) / area;
+	t->vz_dy = ((vz[2] - vz[0]) * dx1 - (vz[1] - vz[0]) * dx2) / area;
+
+	/* origin */
+	t->x0 = x[0];
+	t->y0 = y[0];
+	t->iz = iz[0];
+	t->uz = uz[0];
+	t->vz = vz[0];
+
+	return 1;
+}
+
+/*
+ * draw a perspective correct textured triangle. tex must have power of two
+ * dimensions and is wrapped. 8 bpp textures draw to 8 bpp surfaces, through
+ * the 256 entry colormap row if it isn't NULL. 32 bpp textures draw to 32
+ * bpp surfaces and ignore the colormap
+ */
+void raster_triangle_textured(surface_t *dst, surface_t *tex,
+	raster_vertex_t *v0, raster_vertex_t *v1, raster_vertex_t *v2,
+	const uint8_t *colormap)
+{
+	/* variables */
+	raster_tex_t t;
+	float32 x[3], y[3];
+
+	/* sanity checks */
+	if (!dst || !dst->pixels || !tex || !tex->pixels) return;
+	if (!v0 || !v1 || !v2) return;
+	if (tex->bpp != dst->bpp || (tex->bpp != 8 && tex->bpp != 32)) return;
+	if (tex->w & (tex->w - 1) || tex->h & (tex->h - 1)) return;
+
+	if (!raster_setup_textured(&t, v0, v1, v2, x, y)) return;
+
+	/* surfaces */
+	t.dst = dst;
+	t.tex = tex;
+	t.tiled = NULL;
+	t.colormap = tex->bpp == 8 ? colormap : NULL;
+
+	/* fill */
+	raster_walk(dst, x, y, raster_span_textured, &t);
+}
+
+/*
+ * same as raster_triangle_textured, sampling from a tiled or morton order
+ * texture. large textures mapped at an angle stay in cache much better
+ */
+void raster_triangle_tiled(surface_t *dst, tiled_t *tex,
+	raster_vertex_t *v0, raster_vertex_t *v1, raster_vertex_t *v2,
+	const uint8_t *colormap)
+{
+	/* variables */
+	raster_tex_t t;
+	float32 x[3], y[3];
+
+	/* sanity checks */
+	if (!dst || !dst->pixels || !tex || !tex->pixels) return;
+	if (!v0 || !v1 || !v2) return;
+	if (tex->bpp != dst->bpp || (tex->bpp != 8 && tex->bpp != 32)) return;
+	if (tex->umask < 0 || tex->vmask < 0) return;
+
+	if (!raster_setup_textured(&t, v0, v1, v2, x, y)) return;
+
+	/* surfaces */
+	t.dst = dst;
+	t.tex = NULL;
+	t.tiled = tex;
+	t.colormap = tex->bpp == 8 ? colormap : NULL;
+
+	/* fill */
+	raster_walk(dst, x, y, raster_span_textured, &t);
+}
+
+/*
+ * column and span drawing
+ */
+
+/* light the r, g and b channels of an argb8888 texel through a colormap */
+#define RASTER_LIGHT32(c, cm) (((c) & 0xFF000000) | \
+	((uint32_t)(cm)[((c) >> 16) & 0xFF] << 16) | \
+	((uint32_t)(cm)[((c) >> 8) & 0xFF] << 8) | \
+	(uint32_t)(cm)[(c) & 0xFF])
+
+/*
+ * texel row of a 16.16 coordinate, wrapped to a power of two. the kernels
+ * step coordinates as unsigned so they wrap instead of overflowing
+ */
+#define RASTER_WRAP(a, mask) ((int)(((a) >> 16) & (mask)))
+
+/* n pixels down an 8 bpp column */
+static void raster_column8(uint8_t *d, int pitch, uint8_t *s, int spitch,
+	int vmask, uint32_t v, uint32_t dv, int n, const uint8_t *cm)
+{
+	if (cm)
+	{
+		for (; n >= 4; n -= 4)
+		{
+			d[0] = cm[s[RASTER_WRAP(v, vmask) * spitch]];
+			v += dv;
+			d[pitch] = cm[s[RASTER_WRAP(v, vmask) * spitch]];
+			v += dv;
+			d[pitch * 2] = cm[s[RASTER_WRAP(v, vmask) * spitch]];
+			v += dv;
+			d[pitch * 3] = cm[s[RASTER_WRAP(v, vmask) * spitch]];
+			v += dv;
+			d += pitch * 4;
+		}
+
+		for (; n > 0; n--)
+		{
+			*d = cm[s[RASTER_WRAP(v, vmask) * spitch]];
+			v += dv;
+			d += pitch;
+		}
+	}
+	else
+	{
+		for (; n >= 4; n -= 4)
+		{
+			d[0] = s[RASTER_WRAP(v, vmask) * spitch];
+			v += dv;
+			d[pitch] = s[RASTER_WRAP(v, vmask) * spitch];
+			v += dv;
+			d[pitch * 2] = s[RASTER_WRAP(v, vmask) * spitch];
+			v += dv;
+			d[pitch * 3] = s[RASTER_WRAP(v, vmask) * spitch];
+			v += dv;
+			d += pitch * 4;
+		}
+
+		for (; n > 0; n--)
+		{
+			*d = s[RASTER_WRAP(v, vmask) * spitch];
+			v += dv;
+			d += pitch;
+		}
+	}
+}
+
+/* n pixels down a 32 bpp column. pitches are in pixels */
+static void raster_column32(uint32_t *d, int pitch, uint32_t *s, int spitch,
+	int vmask, uint32_t v, uint32_t dv, int n, const uint8_t *cm)
+{
+	/* variables */
+	uint32_t c;
+
+	if (cm)
+	{
+		for (; n >= 2; n -= 2)
+		{
+			c = s[RASTER_WRAP(v, vmask) * spitch];
+			d[0] = RASTER_LIGHT32(c, cm);
+			v += dv;
+			c = s[RASTER_WRAP(v, vmask) * spitch];
+			d[pitch] = RASTER_LIGHT32(c, cm);
+			v += dv;
+			d += pitch * 2;
+		}
+
+		if (n)
+		{
+			c = s[RASTER_WRAP(v, vmask) * spitch];
+			*d = RASTER_LIGHT32(c, cm);
+		}
+	}
+	else
+	{
+		for (; n >= 4; n -= 4)
+		{
+			d[0] = s[RASTER_WRAP(v, vmask) * spitch];
+			v += dv;
+			d[pitch] = s[RASTER_WRAP(v, vmask) * spitch];
+			v += dv;
+			d[pitch * 2] = s[RASTER_WRAP(v, vmask) * spitch];
+			v += dv;
+			d[pitch * 3] = s[RASTER_WRAP(v, vmask) * spitch];
+			v += dv;
+			d += pitch * 4;
+		}
+
+		for (; n > 0; n--)
+		{
+			*d = s[RASTER_WRAP(v, vmask) * spitch];
+			v += dv;
+			d += pitch;
+		}
+	}
+}
+
+/* texel offset of 16.16 u, v */
+#define RASTER_TEXEL(u, v, umask, vmask, pitch) \
+	(RASTER_WRAP(v, vmask) * (pitch) + RASTER_WRAP(u, umask))
+
+/* n pixels along an 8 bpp span */
+static void raster_span8(uint8_t *d, uint8_t *s, int pitch, int umask,
+	int vmask, uint32_t u, uint32_t v, uint32_t du, uint32_t dv, int n,
+	const uint8_t *cm)
+{
+	/* variables */
+	int x;
+
+	/* start */
+	x = 0;
+
+	if (cm)
+	{
+		for (; x + 4 <= n; x += 4)
+		{
+			d[x + 0] = cm[s[RASTER_TEXEL(u, v, umask, vmask, pitch)]];
+			u += du; v += dv;
+			d[x + 1] = cm[s[RASTER_TEXEL(u, v, umask, vmask, pitch)]];
+			u += du; v += dv;
+			d[x + 2] = cm[s[RASTER_TEXEL(u, v, umask, vmask, pitch)]];
+			u += du; v += dv;
+			d[x + 3] = cm[s[RASTER_TEXEL(u, v, umask, vmask, pitch)]];
+			u += du; v += dv;
+		}
+
+		for (; x < n; x++)
+		{
+			d[x] = cm[s[RASTER_TEXEL(u, v, umask, vmask, pitch)]];
+			u += du; v += dv;
+		}
+	}
+	else
+	{
+		for (; x + 4 <= n; x += 4)
+		{
+			d[x + 0] = s[RASTER_TEXEL(u, v, umask, vmask, pitch)];
+			u += du; v += dv;
+			d[x + 1] = s[RASTER_TEXEL(u, v, umask, vmask, pitch)];
+			u += du; v += dv;
+			d[x + 2] = s[RASTER_TEXEL(u, v, umask, vmask, pitch)];
+			u += du; v += dv;
+			d[x + 3] = s[RASTER_TEXEL(u, v, umask, vmask, pitch)];
+			u += du; v += dv;
+		}
+
+		for (; x < n; x++)
+		{
+			d[x] = s[RASTER_TEXEL(u, v, umask, vmask, pitch)];
+			u += du; v += dv;
+		}
+	}
+}
+
+/* n pixels along a 32 bpp span. pitch is in pixels */
+static void raster_span32(uint32_t *d, uint32_t *s, int pitch, int umask,
+	int vmask, uint32_t u, uint32_t v, uint32_t du, uint32_t dv, int n,
+	const uint8_t *cm)
+{
+	/* variables */
+	uint32_t c;
+	int x;
+
+	/* start */
+	x = 0;
+
+	if (cm)
+	{
+		for (; x + 2 <= n; x += 2)
+		{
+			c = s[RASTER_TEXEL(u, v, umask, vmask, pitch)];
+			d[x + 0] = RASTER_LIGHT32(c, cm);
+			u += du; v += dv;
+			c = s[RASTER_TEXEL(u, v, umask, vmask, pitch)];
+			d[x + 1] = RASTER_LIGHT32(c, cm);
+			u += du; v += dv;
+		}
+
+		if (x < n)
+		{
+			c = s[RASTER_TEXEL(u, v, umask, vmask, pitch)];
+			d[x] = RASTER_LIGHT32(c, cm);
+		}
+	}
+	else
+	{
+		for (; x + 4 <= n; x += 4)
+		{
+			d[x + 0] = s[RASTER_TEXEL(u, v, umask, vmask, pitch)];
+			u += du; v += dv;
+			d[x + 1] = s[RASTER_TEXEL(u, v, umask, vmask, pitch)];
+			u += du; v += dv;
+			d[x + 2] = s[RASTER_TEXEL(u, v, umask, vmask, pitch)];
+			u += du; v += dv;
+			d[x + 3] = s[RASTER_TEXEL(u, v, umask, vmask, pitch)];
+			u += du; v += dv;
+		}
+
+		for (; x < n; x++)
+		{
+			d[x] = s[RASTER_TEXEL(u, v, umask, vmask, pitch)];
+			u += du; v += dv;
+		}
+	}
+}
+
+/*
+ * draw a vertical run of texture column u into column x of dst, from y1 to
+ * y2 exclusive. v is the 16.16 texture row at y1 and dv the step per pixel,
+ * so a wall slice h pixels tall maps a 64 texel column with dv = 64 / h.
+ * texture heights must be powers of two, rows wrap. the colormap is a
+ * lighting row indexed by texel for 8 bpp, and by each of r, g and b for
+ * 32 bpp. dst and tex must have the same bpp
+ */
+void raster_column(surface_t *dst, surface_t *tex, int x, int y1, int y2,
+	int u, fix32 v, fix32 dv, const uint8_t *colormap)
+{
+	/* sanity checks */
+	if (!dst || !dst->pixels || !tex || !tex->pixels) return;
+	if (tex->bpp != dst->bpp || (tex->bpp != 8 && tex->bpp != 32)) return;
+	if (tex->h & (tex->h - 1)) return;
+
+	/* clip */
+	if (x < dst->clip.x1 || x >= dst->clip.x2) return;
+
+	if (y1 < dst->clip.y1)
+	{
+		v = (fix32)((uint32_t)v + (uint32_t)dv * (uint32_t)(dst->clip.y1 - y1));
+		y1 = dst->clip.y1;
+	}
+
+	y2 = MIN(y2, dst->clip.y2);
+	if (y1 >= y2) return;
+	if (!surface_detach(dst)) return;
+
+	/* texture column */
+	u = ((u % tex->w) + tex->w) % tex->w;
+
+	if (dst->bpp == 8)
+	{
+		raster_column8(SURFACE_PTR(dst, x, y1), dst->bytes_per_row,
+			SURFACE_PTR(tex, u, 0), tex->bytes_per_row, tex->h - 1,
+			v, dv, y2 - y1, colormap);
+	}
+	else
+	{
+		raster_column32((uint32_t *)SURFACE_PTR(dst, x, y1),
+			dst->bytes_per_row / 4, (uint32_t *)SURFACE_PTR(tex, u, 0),
+			tex->bytes_per_row / 4, tex->h - 1, v, dv, y2 - y1, colormap);
+	}
+}
+
+/*
+ * draw a horizontal run of texture into row y of dst, from x1 to x2
+ * exclusive. u and v are 16.16 texture coordinates at x1 and du, dv the
+ * steps per pixel, as for floors and ceilings. texture sizes must be powers
+ * of two and wrap. colormap works as it does for raster_column
+ */
+void raster_span(surface_t *dst, surface_t *tex, int y, int x1, int x2,
+	fix32 u, fix32 v, fix32 du, fix32 dv, const uint8_t *colormap)
+{
+	/* variables */
+	uint32_t n;
+
+	/* sanity checks */
+	if (!dst || !dst->pixels || !tex || !tex->pixels) return;
+	if (tex->bpp != dst->bpp || (tex->bpp != 8 && tex->bpp != 32)) return;
+	if (tex->w & (tex->w - 1) || tex->h & (tex->h - 1)) return;
+
+	/* clip */
+	if (y < dst->clip.y1 || y >= dst->clip.y2) return;
+
+	if (x1 < dst->clip.x1)
+	{
+		n = (uint32_t)(dst->clip.x1 - x1);
+		u = (fix32)((uint32_t)u + (uint32_t)du * n);
+		v = (fix32)((uint32_t)v + (uint32_t)dv * n);
+		x1 = dst->clip.x1;
+	}
+
+	x2 = MIN(x2, dst->clip.x2);
+	if (x1 >= x2) return;
+	if (!surface_detach(dst)) return;
+
+	if (dst->bpp == 8)
+	{
+		raster_span8(SURFACE_PTR(dst, x1, y), (uint8_t *)tex->pixels,
+			tex->bytes_per_row, tex->w - 1, tex->h - 1, u, v, du, dv,
+			x2 - x1, colormap);
+	}
+	else
+	{
+		raster_span32((uint32_t *)SURFACE_PTR(dst, x1, y),
+			(uint32_t *)tex->pixels, tex->bytes_per_row / 4, tex->w - 1,
+			tex->h - 1, u, v, du, dv, x2 - x1, colormap);
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_RASTER_H__ */
@@ -0,0 +1,137 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexrecord.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexrecord.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* rex */
+#include "rexrecord.h"
+
+/* draw frame i of a box moving over a static background */
+void draw_frame(surface_t *s, int i)
+{
+	/* variables */
+	int x, y;
+
+	for (y = 0; y < s->h; y++)
+	{
+		for (x = 0; x < s->w; x++)
+		{
+			((uint32_t *)s->pixels)[y * s->w + x] =
+				pack_argb8888(x, y, (x ^ y) & 0xFF, 255);
+		}
+	}
+
+	for (y = 0; y < 16; y++)
+	{
+		for (x = 0; x < 16; x++)
+		{
+			((uint32_t *)s->pixels)[(y + 40) * s->w + (x + i * 2) % s->w] =
+				pack_argb8888(255, 255, 255, 255);
+		}
+	}
+}
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	surface_t *frame;
+	record_t *record;
+	playback_t *playback;
+	int i, frames;
+
+	/* create surface */
+	frame = surface_create(256, 128, 32, NULL);
+
+	/* print header */
+	printf("librex: rexrecord.h test\n");
+	printf("\n");
+
+	/* record */
+	record = record_open("rexrecord.rec", frame->w, frame->h, frame->bpp, 30);
+
+	for (i = 0; i < 120; i++)
+	{
+		draw_frame(frame, i);
+		record_frame(record, frame);
+	}
+
+	printf("frames recorded: %lu\n", (unsigned long)record->num_frames);
+	printf("raw size: %.0f bytes\n", (double)record->bytes_in);
+	printf("recorded size: %.0f bytes\n", (double)record->bytes_out);
+	printf("ratio: %lu:1\n", (unsigned long)(record->bytes_in / record->bytes_out));
+
+	record_close(record);
+
+	/* play back in order, then seek backwards */
+	playback = playback_open("rexrecord.rec");
+	frames = 0;
+
+	while (playback_next(playback))
+	{
+		draw_frame(frame, playback->current);
+
+		if (memcmp(frame->pixels, playback->surface->pixels,
+			frame->bytes_per_row * frame->h) == 0)
+		{
+			frames++;
+		}
+	}
+
+	printf("frames played back: %d of %d\n", frames, playback->num_frames);
+
+	playback_seek(playback, 77);
+	draw_frame(frame, 77);
+	printf("seek to frame 77: %s\n", memcmp(frame->pixels,
+		playback->surface->pixels, frame->bytes_per_row * frame->h) ?
+		"mismatch" : "ok");
+
+	surface_dump_buffer(playback->surface, "rexrecord.data");
+
+	playback_close(playback);
+
+	/* destroy surface */
+	surface_destroy(frame);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,737 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexrecord.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: delta compressed frame recording
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_RECORD_H__
+#define __LIBREX_RECORD_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexsurface.h"
+
+#endif
+
+/* simd */
+#ifdef LIBREX_SSE2
+#include <emmintrin.h>
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+/* file magic and version */
+#define RECORD_MAGIC "RXRC"
+#define RECORD_VERSION 1
+
+/* magic plus five 32-bit header values */
+#define RECORD_HEADER_SIZE 24
+
+/*
+ * file offsets. windows keeps long at 32 bits even on 64-bit targets, so
+ * it seeks with _fseeki64. everywhere else uses fseek and ftell, and a
+ * recording stops growing before it passes what long can index. on djgpp
+ * and 32-bit linux that cap is 2 gb
+ */
+#if defined(_WIN32) && (defined(_MSC_VER) || defined(__MINGW32__))
+typedef int64_t record_offset_t;
+#define RECORD_FSEEK(f, o, w) _fseeki64(f, o, w)
+#define RECORD_FTELL(f) _ftelli64(f)
+#define RECORD_MAX_SIZE (~(uint64_t)0 >> 1)
+#else
+typedef long record_offset_t;
+#define RECORD_FSEEK(f, o, w) fseek(f, o, w)
+#define RECORD_FTELL(f) ftell(f)
+#define RECORD_MAX_SIZE ((uint64_t)LONG_MAX)
+#endif
+
+/* frame types */
+#define RECORD_KEYFRAME 0
+#define RECORD_DELTA 1
+
+/* unchanged runs shorter than this are cheaper to store as literals */
+#define RECORD_MIN_SKIP 4
+
+/* delta recorder */
+typedef struct record_t
+{
+	FILE *file;
+	int w;
+	int h;
+	int bpp;
+	int keyframe_interval;
+	size_t frame_size;
+
+	/* previous frame and encode buffer */
+	uint8_t *prev;
+	uint8_t *buffer;
+
+	/* set by a failed write, every later frame is refused */
+	int error;
+
+	/* counters. the byte counts are 64-bit so long replays can't wrap */
+	uint32_t num_frames;
+	uint64_t bytes_in;
+	uint64_t bytes_out;
+} record_t;
+
+/* delta player */
+typedef struct playback_t
+{
+	FILE *file;
+	int keyframe_interval;
+	size_t frame_size;
+
+	/* frame index, built when the file is opened */
+	int num_frames;
+	record_offset_t *offsets;
+
+	/* decode buffer */
+	uint8_t *buffer;
+	size_t buffer_size;
+
+	/* last decoded frame, -1 if none */
+	int current;
+	surface_t *surface;
+} playback_t;
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* recording */
+record_t *record_open(const char *filename, int w, int h, int bpp,
+	int keyframe_interval);
+void record_close(record_t *r);
+int record_frame(record_t *r, surface_t *s);
+
+/* playback */
+playback_t *playback_open(const char *filename);
+void playback_close(playback_t *p);
+int playback_seek(playback_t *p, int frame);
+int playback_next(playback_t *p);
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/*
+ * internal helpers
+ */
+
+/* little endian file values */
+static int record_put32(FILE *file, uint32_t v)
+{
+	uint8_t b[4];
+
+	b[0] = (uint8_t)v;
+	b[1] = (uint8_t)(v >> 8);
+	b[2] = (uint8_t)(v >> 16);
+	b[3] = (uint8_t)(v >> 24);
+
+	return fwrite(b, 1, 4, file) == 4;
+}
+
+static int record_get32(FILE *file, uint32_t *v)
+{
+	uint8_t b[4];
+
+	if (fread(b, 1, 4, file) != 4) return 0;
+
+	*v = (uint32_t)b[0] | ((uint32_t)b[1] << 8) |
+		((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+
+	return 1;
+}
+
+/* variable length counts, 7 bits per byte */
+static uint8_t *record_put_count(uint8_t *out, size_t v)
+{
+	while (v >= 0x80)
+	{
+		*out++ = (uint8_t)(v | 0x80);
+		v >>= 7;
+	}
+
+	*out++ = (uint8_t)v;
+
+	return out;
+}
+
+static const uint8_t *record_get_count(const uint8_t *in, const uint8_t *end,
+	size_t *v)
+{
+	/* variables */
+	size_t r;
+	int shift;
+
+	r = 0;
+	shift = 0;
+
+	while (in < end && shift < 32)
+	{
+		r |= (size_t)(*in & 0x7F) << shift;
+
+		if (!(*in++ & 0x80))
+		{
+			*v = r;
+			return in;
+		}
+
+		shift += 7;
+	}
+
+	return NULL;
+}
+
+/* number of leading bytes that match between a and b */
+static size_t record_same(const uint8_t *a, const uint8_t *b, size_t n)
+{
+	/* variables */
+	size_t i;
+
+	/* start */
+	i = 0;
+
+#ifdef LIBREX_SSE2
+	{
+		/* variables */
+		int m;
+
+		for (; i + 16 <= n; i += 16)
+		{
+			m = _mm_movemask_epi8(_mm_cmpeq_epi8(
+				_mm_loadu_si128((const __m128i *)(a + i)),
+				_mm_loadu_si128((const __m128i *)(b + i))));
+
+			if (m != 0xFFFF)
+			{
+				while (m & 1)
+				{
+					m >>= 1;
+					i++;
+				}
+
+				return i;
+			}
+		}
+	}
+#endif
+
+	/* scalar path and leftovers */
+	while (i < n && a[i] == b[i])
+		i++;
+
+	return i;
+}
+
+/*
+ * encode cur against prev as alternating (skip, literal) runs. skipped
+ * bytes are unchanged, literal bytes are stored as cur ^ prev
+ */
+static size_t record_encode(const uint8_t *cur, const uint8_t *prev,
+	size_t n, uint8_t *out)
+{
+	/* variables */
+	uint8_t *o;
+	size_t i, skip, lit, run, j;
+
+	/* start */
+	o = out;
+	i = 0;
+
+	while (i < n)
+	{
+		/* unchanged bytes */
+		skip = record_same(cur + i, prev + i, n - i);
+
+		/* changed bytes, up to the next long enough unchanged run */
+		lit = 0;
+		run = 0;
+
+		for (j = i + skip; j < n; j++)
+		{
+			if (cur[j] == prev[j])
+			{
+				if (++run == RECORD_MIN_SKIP)
+				{
+					j -= RECORD_MIN_SKIP - 1;
+					break;
+				}
+			}
+			else
+			{
+				run = 0;
+			}
+		}
+
+		/* trailing unchanged bytes belong to the next skip */
+		if (j >= n)
+			j = n - run;
+
+		lit = j - i - skip;
+
+		o = record_put_count(o, skip);
+		o = record_put_count(o, lit);
+
+		for (j = i + skip; j < i + skip + lit; j++)
+			*o++ = cur[j] ^ prev[j];
+
+		i += skip + lit;
+	}
+
+	return o - out;
+}
+
+/* apply an encoded frame on top of frame. returns 0 on a corrupt payload */
+static int record_decode(uint8_t *frame, size_t n, const uint8_t *in,
+	size_t size)
+{
+	/* variables */
+	const uint8_t *end;
+	size_t i, skip, lit;
+	uint8_t *p;
+
+	/* start */
+	end = in + size;
+	i = 0;
+
+	while (in < end)
+	{
+		in = record_get_count(in, end, &skip);
+		if (!in) return 0;
+		in = record_get_count(in, end, &lit);
+		if (!in) return 0;
+
+		/* bounds */
+		if (skip > n - i || lit > n - i - skip || lit > (size_t)(end - in))
+			return 0;
+
+		p = frame + i + skip;
+		i += skip + lit;
+
+#ifdef LIBREX_SSE2
+		for (; lit >= 16; lit -= 16, p += 16, in += 16)
+		{
+			_mm_storeu_si128((__m128i *)p, _mm_xor_si128(
+				_mm_loadu_si128((const __m128i *)p),
+				_mm_loadu_si128((const __m128i *)in)));
+		}
+#endif
+
+		while (lit--)
+			*p++ ^= *in++;
+	}
+
+	return 1;
+}
+
+/*
+ * recording
+ */
+
+/*
+ * open a recording of w by h surfaces of the given bpp. every
+ * keyframe_interval frames is stored whole so playback can seek
+ */
+record_t *record_open(const char *filename, int w, int h, int bpp,
+	int keyframe_interval)
+{
+	/* variables */
+	record_t *ret;
+
+	/* sanity checks */
+	if (!filename || w < 1 || h < 1 || keyframe_interval < 1) return NULL;
+	if (bpp != 8 && bpp != 16 && bpp != 32) return NULL;
+
+	/* alloc */
+	ret = (record_t *)LIBREX_CALLOC(1, sizeof(record_t));
+	if (!ret) return NULL;
+
+	/* assign values */
+	ret->w = w;
+	ret->h = h;
+	ret->bpp = bpp;
+	ret->keyframe_interval = keyframe_interval;
+	ret->frame_size = (size_t)w * h * (bpp / 8);
+
+	/* worst case is one count pair per changed byte */
+	ret->prev = (uint8_t *)LIBREX_CALLOC(1, ret->frame_size);
+	ret->buffer = (uint8_t *)LIBREX_MALLOC(ret->frame_size * 2 + 16);
+	ret->file = fopen(filename, "wb");
+
+	if (!ret->prev || !ret->buffer || !ret->file)
+	{
+		record_close(ret);
+		return NULL;
+	}
+
+	/* write header */
+	if (fwrite(RECORD_MAGIC, 1, 4, ret->file) != 4 ||
+		!record_put32(ret->file, RECORD_VERSION) ||
+		!record_put32(ret->file, w) || !record_put32(ret->file, h) ||
+		!record_put32(ret->file, bpp) ||
+		!record_put32(ret->file, keyframe_interval))
+	{
+		record_close(ret);
+		return NULL;
+	}
+
+	/* return ptr */
+	return ret;
+}
+
+/* close a recording and free all memory */
+void record_close(record_t *r)
+{
+	if (r)
+	{
+		if (r->file)
+			fclose(r->file);
+
+		if (r->prev)
+			LIBREX_FREE(r->prev);
+
+		if (r->buffer)
+			LIBREX_FREE(r->buffer);
+
+		LIBREX_FREE(r);
+	}
+}
+
+/*
+ * append the pixels of s to the recording. returns 0 on failure. after a
+ * failed write the file ends mid frame, so the recorder stops there and
+ * playback keeps every frame before it
+ */
+int record_frame(record_t *r, surface_t *s)
+{
+	/* variables */
+	int type;
+	size_t size;
+
+	/* sanity checks */
+	if (!r || r->error || !s || !s->pixels) return 0;
+	if (s->w != r->w || s->h != r->h || s->bpp != r->bpp) return 0;
+
+	/* keyframes are deltas against a black frame */
+	if (r->num_frames % r->keyframe_interval == 0)
+	{
+		type = RECORD_KEYFRAME;
+		memset(r->prev, 0, r->frame_size);
+	}
+	else
+	{
+		type = RECORD_DELTA;
+	}
+
+	/* encode */
+	size = record_encode((uint8_t *)s->pixels, r->prev, r->frame_size,
+		r->buffer);
+
+	/* past this size playback couldn't seek to the frame */
+	if (RECORD_HEADER_SIZE + r->bytes_out + size + 5 > RECORD_MAX_SIZE)
+	{
+		r->error = 1;
+		return 0;
+	}
+
+	/* write frame header and payload */
+	if (fputc(type, r->file) == EOF ||
+		!record_put32(r->file, (uint32_t)size) ||
+		fwrite(r->buffer, 1, size, r->file) != size)
+	{
+		r->error = 1;
+		return 0;
+	}
+
+	/* the next delta is against what actually reached the file */
+	memcpy(r->prev, s->pixels, r->frame_size);
+
+	/* counters */
+	r->num_frames++;
+	r->bytes_in += r->frame_size;
+	r->bytes_out += size + 5;
+
+	return 1;
+}
+
+/*
+ * playback
+ */
+
+/* open a recording and index its frames */
+playback_t *playback_open(const char *filename)
+{
+	/* variables */
+	playback_t *ret;
+	char magic[4];
+	uint32_t version, w, h, bpp, interval, size;
+	record_offset_t *offsets, length, pos;
+	int type, max_frames;
+
+	/* sanity checks */
+	if (!filename) return NULL;
+
+	/* alloc */
+	ret = (playback_t *)LIBREX_CALLOC(1, sizeof(playback_t));
+	if (!ret) return NULL;
+
+	ret->current = -1;
+
+	/* open file */
+	ret->file = fopen(filename, "rb");
+	if (!ret->file)
+	{
+		playback_close(ret);
+		return NULL;
+	}
+
+	/* read header */
+	if (fread(magic, 1, 4, ret->file) != 4 ||
+		memcmp(magic, RECORD_MAGIC, 4) != 0 ||
+		!record_get32(ret->file, &version) || version != RECORD_VERSION ||
+		!record_get32(ret->file, &w) || !record_get32(ret->file, &h) ||
+		!record_get32(ret->file, &bpp) || !record_get32(ret->file, &interval) ||
+		interval < 1)
+	{
+		playback_close(ret);
+		return NULL;
+	}
+
+	ret->keyframe_interval = (int)interval;
+
+	/* create surface */
+	ret->surface = surface_create((int)w, (int)h, (int)bpp, NULL);
+	if (!ret->surface)
+	{
+		playback_close(ret);
+		return NULL;
+	}
+
+	ret->frame_size = ret->surface->bytes_per_row * ret->surface->h;
+
+	/*
+	 * index frames. a recording that was cut off mid frame keeps every
+	 * frame before the cut
+	 */
+	max_frames = 0;
+	pos = RECORD_FTELL(ret->file);
+
+	/* a file too long for the offsets to describe is refused */
+	if (pos < 0 || RECORD_FSEEK(ret->file, 0, SEEK_END) != 0 ||
+		(length = RECORD_FTELL(ret->file)) < 0 ||
+		RECORD_FSEEK(ret->file, pos, SEEK_SET) != 0)
+	{
+		playback_close(ret);
+		return NULL;
+	}
+
+	while ((type = fgetc(ret->file)) != EOF)
+	{
+		if (!record_get32(ret->file, &size)) break;
+
+		pos = RECORD_FTELL(ret->file);
+		if (pos < 0 || (record_offset_t)size > length - pos) break;
+
+		if (ret->num_frames == max_frames)
+		{
+			max_frames = max_frames ? max_frames * 2 : 64;
+			offsets = (record_offset_t *)LIBREX_REALLOC(ret->offsets,
+				max_frames * sizeof(record_offset_t));
+
+			if (!offsets)
+			{
+				playback_close(ret);
+				return NULL;
+			}
+
+			ret->offsets = offsets;
+		}
+
+		ret->offsets[ret->num_frames] = pos - 5;
+
+		if (RECORD_FSEEK(ret->file, size, SEEK_CUR) != 0) break;
+
+		ret->num_frames++;
+
+		if (size > ret->buffer_size)
+			ret->buffer_size = size;
+	}
+
+	/* decode buffer */
+	ret->buffer = (uint8_t *)LIBREX_MALLOC(ret->buffer_size + 1);
+	if (!ret->buffer)
+	{
+		playback_close(ret);
+		return NULL;
+	}
+
+	/* return ptr */
+	return ret;
+}
+
+/* close a recording and free all memory */
+void playback_close(playback_t *p)
+{
+	if (p)
+	{
+		if (p->file)
+			fclose(p->file);
+
+		if (p->offsets)
+			LIBREX_FREE(p->offsets);
+
+		if (p->buffer)
+			LIBREX_FREE(p->buffer);
+
+		if (p->surface)
+			surface_destroy(p->surface);
+
+		LIBREX_FREE(p);
+	}
+}
+
+/* decode a single frame on top of the current surface contents */
+static int playback_decode(playback_t *p, int frame)
+{
+	/* variables */
+	int type;
+	uint32_t size;
+
+	/* read frame header and payload */
+	if (RECORD_FSEEK(p->file, p->offsets[frame], SEEK_SET) != 0) return 0;
+	if ((type = fgetc(p->file)) == EOF) return 0;
+	if (!record_get32(p->file, &size) || size > p->buffer_size) return 0;
+	if (fread(p->buffer, 1, size, p->file) != size) return 0;
+	if (!surface_detach(p->surface)) return 0;
+
+	if (type == RECORD_KEYFRAME)
+		memset(p->surface->pixels, 0, p->frame_size);
+
+	if (!record_decode((uint8_t *)p->surface->pixels, p->frame_size,
+		p->buffer, size))
+	{
+		return 0;
+	}
+
+	p->current = frame;
+
+	return 1;
+}
+
+/*
+ * decode a frame into p->surface. starts from the nearest keyframe unless
+ * the current frame is already on the way. returns 0 on failure
+ */
+int playback_seek(playback_t *p, int frame)
+{
+	/* variables */
+	int i, key;
+
+	/* sanity checks */
+	if (!p || frame < 0 || frame >= p->num_frames) return 0;
+	if (frame == p->current) return 1;
+
+	/* start from the current frame or the keyframe */
+	key = frame - frame % p->keyframe_interval;
+	i = (p->current >= key && p->current < frame) ? p->current + 1 : key;
+
+	for (; i <= frame; i++)
+	{
+		if (!playback_decode(p, i))
+		{
+			p->current = -1;
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/* decode the next frame. returns 0 at the end of the recording */
+int playback_next(playback_t *p)
+{
+	/* sanity checks */
+	if (!p) return 0;
+
+	return playback_seek(p, p->current + 1);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_RECORD_H__ */
@@ -0,0 +1,121 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexsprite.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexsprite.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+/* rex */
+#include "rexsprite.h"
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	surface_t *parts[8], *atlas, *dst;
+	sprite_region_t regions[8];
+	spritebatch_t *b;
+	color_t c;
+	int i, a;
+	clock_t start;
+
+	/* create some differently sized sprites */
+	for (i = 0; i < 8; i++)
+	{
+		parts[i] = surface_create(8 + i * 4, 40 - i * 4, 32, NULL);
+		color_set_argb8888(&c, i * 32, 255 - i * 32, 128, 255);
+		surface_clear(parts[i], &c);
+	}
+
+	/* print header */
+	printf("librex: rexsprite.h test\n");
+	printf("\n");
+
+	/* pack them */
+	atlas = sprite_pack_atlas(parts, 8, 128, 128, regions);
+	if (!atlas)
+	{
+		fprintf(stderr, "error: couldn't pack atlas\n");
+		return EXIT_FAILURE;
+	}
+
+	for (i = 0; i < 8; i++)
+	{
+		printf("region %d: %d, %d, %dx%d\n", i, regions[i].x, regions[i].y,
+			regions[i].w, regions[i].h);
+	}
+
+	printf("\n");
+
+	/* batch */
+	dst = surface_create(640, 480, 32, NULL);
+	b = spritebatch_create(32, 20000, 0);
+	a = spritebatch_atlas(b, atlas);
+
+	spritebatch_begin(b);
+	for (i = 0; i < 20000; i++)
+	{
+		spritebatch_add(b, a, &regions[i & 7], (i * 37) % 680 - 20,
+			(i * 91) % 520 - 20, i % 4, i & 1 ? SPRITE_FLIPX : 0);
+	}
+
+	start = clock();
+	spritebatch_draw(b, dst);
+
+	printf("sprites: %d\n", b->num_sprites);
+	printf("first layer: %d, last layer: %d\n", b->sprites[0].layer,
+		b->sprites[b->num_sprites - 1].layer);
+	printf("draw time: %ld ms\n",
+		(long)((clock() - start) * 1000 / CLOCKS_PER_SEC));
+
+	/* save */
+	surface_dump_buffer(atlas, "atlas.data");
+	surface_dump_buffer(dst, "sprites.data");
+
+	/* destroy */
+	spritebatch_destroy(b);
+	surface_destroy(dst);
+	surface_destroy(atlas);
+	for (i = 0; i < 8; i++)
+		surface_destroy(parts[i]);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,567 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexsprite.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: batched sprite drawing and atlas packing
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_SPRITE_H__
+#define __LIBREX_SPRITE_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexmath.h"
+#include "rexcolor.h"
+#include "rexsurface.h"
+
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+/* sort keys are 8 bits of layer and 8 bits of atlas */
+#define SPRITE_MAX_ATLASES 256
+#define SPRITE_MAX_LAYERS 256
+
+/* sprite flags */
+#define SPRITE_FLIPX 0x01
+#define SPRITE_FLIPY 0x02
+#define SPRITE_KEYED 0x04
+
+/* queued positions are stored in 16 bits */
+#define SPRITE_COORD_MIN (-32768)
+#define SPRITE_COORD_MAX 32767
+
+/* one queued sprite */
+typedef struct sprite_t
+{
+	uint8_t atlas;
+	uint8_t layer;
+	uint16_t flags;
+	int16_t x;
+	int16_t y;
+	uint16_t sx;
+	uint16_t sy;
+	uint16_t sw;
+	uint16_t sh;
+} sprite_t;
+
+/* rectangle within an atlas */
+typedef struct sprite_region_t
+{
+	int x;
+	int y;
+	int w;
+	int h;
+} sprite_region_t;
+
+/*
+ * sprite batch. all atlases share one bpp. pixels equal to colorkey are
+ * skipped by SPRITE_KEYED sprites
+ */
+typedef struct spritebatch_t
+{
+	int bpp;
+	uint32_t colorkey;
+	int num_atlases;
+	surface_t *atlases[SPRITE_MAX_ATLASES];
+	int num_sprites;
+	int max_sprites;
+	sprite_t *sprites;
+	sprite_t *scratch;
+} spritebatch_t;
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* sprite batch creation and destruction */
+spritebatch_t *spritebatch_create(int bpp, int max_sprites, uint32_t colorkey);
+void spritebatch_destroy(spritebatch_t *b);
+
+/* sprite batch submission */
+int spritebatch_atlas(spritebatch_t *b, surface_t *atlas);
+void spritebatch_begin(spritebatch_t *b);
+int spritebatch_add(spritebatch_t *b, int atlas, sprite_region_t *region,
+	int x, int y, int layer, int flags);
+void spritebatch_draw(spritebatch_t *b, surface_t *dst);
+
+/* atlas packing */
+surface_t *sprite_pack_atlas(surface_t **surfaces, int n, int w, int h,
+	sprite_region_t *regions);
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/*
+ * internal helpers
+ */
+
+/*
+ * blit kernel for one pixel type. clipping is done by the caller, so the
+ * kernels only walk rows. flipped sprites walk the source backwards
+ */
+#define SPRITE_KERNEL(name, type) \
+static void name(uint8_t *src, int spitch, uint8_t *dst, int dpitch, \
+	int w, int h, int flags, uint32_t key) \
+{ \
+	int x, y, step; \
+	type *s, *d, k; \
+	k = (type)key; \
+	step = (flags & SPRITE_FLIPX) ? -1 : 1; \
+	if (flags & SPRITE_FLIPX) src += (w - 1) * sizeof(type); \
+	if (flags & SPRITE_FLIPY) \
+	{ \
+		src += (h - 1) * spitch; \
+		spitch = -spitch; \
+	} \
+	for (y = 0; y < h; y++, src += spitch, dst += dpitch) \
+	{ \
+		s = (type *)src; \
+		d = (type *)dst; \
+		if (flags & SPRITE_KEYED) \
+		{ \
+			for (x = 0; x < w; x++, s += step) \
+				if (*s != k) d[x] = *s; \
+		} \
+		else if (step == 1) \
+		{ \
+			memcpy(d, s, w * sizeof(type)); \
+		} \
+		else \
+		{ \
+			for (x = 0; x < w; x++, s += step) \
+				d[x] = *s; \
+		} \
+	} \
+}
+
+SPRITE_KERNEL(sprite_blit8, uint8_t)
+SPRITE_KERNEL(sprite_blit16, uint16_t)
+SPRITE_KERNEL(sprite_blit32, uint32_t)
+
+/* sort by layer, then atlas, keeping submission order. two 8-bit passes */
+static void sprite_radix_sort(spritebatch_t *b)
+{
+	/* variables */
+	int i, pass, sum, t;
+	int count[256];
+	sprite_t *src, *dst, *tmp;
+	uint8_t key;
+
+	src = b->sprites;
+	dst = b->scratch;
+
+	/* least significant key first: atlas, then layer */
+	for (pass = 0; pass < 2; pass++)
+	{
+		memset(count, 0, sizeof(count));
+
+		for (i = 0; i < b->num_sprites; i++)
+		{
+			key = pass ? src[i].layer : src[i].atlas;
+			count[key]++;
+		}
+
+		/* skip the scatter if every sprite has the same key */
+		key = pass ? src[0].layer : src[0].atlas;
+		if (count[key] == b->num_sprites)
+			continue;
+
+		/* prefix sums */
+		for (i = 0, sum = 0; i < 256; i++)
+		{
+			t = count[i];
+			count[i] = sum;
+			sum += t;
+		}
+
+		/* scatter */
+		for (i = 0; i < b->num_sprites; i++)
+		{
+			key = pass ? src[i].layer : src[i].atlas;
+			dst[count[key]++] = src[i];
+		}
+
+		tmp = src;
+		src = dst;
+		dst = tmp;
+	}
+
+	/* keep the sorted list in sprites */
+	if (src != b->sprites)
+	{
+		b->scratch = b->sprites;
+		b->sprites = src;
+	}
+}
+
+/*
+ * sprite batch creation and destruction
+ */
+
+/* create a sprite batch for bpp atlases holding up to max_sprites */
+spritebatch_t *spritebatch_create(int bpp, int max_sprites, uint32_t colorkey)
+{
+	/* variables */
+	spritebatch_t *ret;
+
+	/* sanity checks */
+	if (bpp != 8 && bpp != 16 && bpp != 32) return NULL;
+	if (max_sprites < 1) return NULL;
+
+	/* alloc */
+	ret = (spritebatch_t *)LIBREX_CALLOC(1, sizeof(spritebatch_t));
+	if (!ret) return NULL;
+
+	/* assign values */
+	ret->bpp = bpp;
+	ret->colorkey = colorkey;
+	ret->max_sprites = max_sprites;
+
+	/* sprite lists */
+	ret->sprites = (sprite_t *)LIBREX_CALLOC(max_sprites, sizeof(sprite_t));
+	ret->scratch = (sprite_t *)LIBREX_CALLOC(max_sprites, sizeof(sprite_t));
+
+	if (!ret->sprites || !ret->scratch)
+	{
+		spritebatch_destroy(ret);
+		return NULL;
+	}
+
+	/* return ptr */
+	return ret;
+}
+
+/* destroy sprite batch. atlases are owned by the caller */
+void spritebatch_destroy(spritebatch_t *b)
+{
+	if (b)
+	{
+		if (b->sprites)
+			LIBREX_FREE(b->sprites);
+
+		if (b->scratch)
+			LIBREX_FREE(b->scratch);
+
+		LIBREX_FREE(b);
+	}
+}
+
+/*
+ * sprite batch submission
+ */
+
+/* register an atlas and return its index, or -1 on failure */
+int spritebatch_atlas(spritebatch_t *b, surface_t *atlas)
+{
+	/* sanity checks */
+	if (!b || !atlas || !atlas->pixels) return -1;
+	if (atlas->bpp != b->bpp) return -1;
+	if (b->num_atlases >= SPRITE_MAX_ATLASES) return -1;
+
+	b->atlases[b->num_atlases] = atlas;
+
+	return b->num_atlases++;
+}
+
+/* start a new frame of sprites */
+void spritebatch_begin(spritebatch_t *b)
+{
+	if (b) b->num_sprites = 0;
+}
+
+/*
+ * queue a sprite. returns 0 if the batch is full or the sprite is invalid,
+ * including a position outside SPRITE_COORD_MIN to SPRITE_COORD_MAX
+ */
+int spritebatch_add(spritebatch_t *b, int atlas, sprite_region_t *region,
+	int x, int y, int layer, int flags)
+{
+	/* variables */
+	sprite_t *s;
+
+	/* sanity checks */
+	if (!b || !region) return 0;
+	if (b->num_sprites >= b->max_sprites) return 0;
+	if (atlas < 0 || atlas >= b->num_atlases) return 0;
+	if (layer < 0 || layer >= SPRITE_MAX_LAYERS) return 0;
+	if (region->w < 1 || region->h < 1) return 0;
+	if (x < SPRITE_COORD_MIN || x > SPRITE_COORD_MAX) return 0;
+	if (y < SPRITE_COORD_MIN || y > SPRITE_COORD_MAX) return 0;
+
+	/* the region must be inside the atlas, so drawing needs no checks */
+	if (region->x < 0 || region->y < 0) return 0;
+	if (region->x + region->w > b->atlases[atlas]->w) return 0;
+	if (region->y + region->h > b->atlases[atlas]->h) return 0;
+
+	/* store */
+	s = &b->sprites[b->num_sprites++];
+	s->atlas = (uint8_t)atlas;
+	s->layer = (uint8_t)layer;
+	s->flags = (uint16_t)flags;
+	s->x = (int16_t)x;
+	s->y = (int16_t)y;
+	s->sx = (uint16_t)region->x;
+	s->sy = (uint16_t)region->y;
+	s->sw = (uint16_t)region->w;
+	s->sh = (uint16_t)region->h;
+
+	return 1;
+}
+
+/*
+ * sort the queued sprites by layer and atlas and draw them to dst, lowest
+ * layer first. sprites within a layer and atlas keep their order
+ */
+void spritebatch_draw(spritebatch_t *b, surface_t *dst)
+{
+	/* variables */
+	int i, x, y, w, h, cx, cy, bytes, flags;
+	sprite_t *s;
+	surface_t *atlas;
+	uint8_t *src;
+
+	/* sanity checks */
+	if (!b || !dst || !dst->pixels) return;
+	if (dst->bpp != b->bpp) return;
+	if (b->num_sprites < 1) return;
+	if (surface_clip_empty(dst)) return;
+	if (!surface_detach(dst)) return;
+
+	/* sort */
+	sprite_radix_sort(b);
+
+	bytes = b->bpp / 8;
+
+	/* one pass over the sorted list */
+	for (i = 0; i < b->num_sprites; i++)
+	{
+		s = &b->sprites[i];
+		atlas = b->atlases[s->atlas];
+		flags = s->flags;
+
+		/* clip against the dst clip rectangle */
+		x = s->x;
+		y = s->y;
+		w = s->sw;
+		h = s->sh;
+		cx = 0;
+		cy = 0;
+
+		if (x < dst->clip.x1)
+		{
+			cx = dst->clip.x1 - x;
+			w -= cx;
+			x = dst->clip.x1;
+		}
+
+		if (y < dst->clip.y1)
+		{
+			cy = dst->clip.y1 - y;
+			h -= cy;
+			y = dst->clip.y1;
+		}
+
+		if (x + w > dst->clip.x2) w = dst->clip.x2 - x;
+		if (y + h > dst->clip.y2) h = dst->clip.y2 - y;
+
+		/* fully clipped */
+		if (w < 1 || h < 1) continue;
+
+		/* flipped sprites lose their clipped edge from the other side */
+		if (flags & SPRITE_FLIPX) cx = s->sw - w - cx;
+		if (flags & SPRITE_FLIPY) cy = s->sh - h - cy;
+
+		src = (uint8_t *)atlas->pixels + (s->sy + cy) * atlas->bytes_per_row +
+			(s->sx + cx) * bytes;
+
+		switch (bytes)
+		{
+			case 1:
+				sprite_blit8(src, atlas->bytes_per_row,
+					(uint8_t *)dst->pixels + y * dst->bytes_per_row + x,
+					dst->bytes_per_row, w, h, flags, b->colorkey);
+				break;
+
+			case 2:
+				sprite_blit16(src, atlas->bytes_per_row,
+					(uint8_t *)dst->pixels + y * dst->bytes_per_row + x * 2,
+					dst->bytes_per_row, w, h, flags, b->colorkey);
+				break;
+
+			case 4:
+				sprite_blit32(src, atlas->bytes_per_row,
+					(uint8_t *)dst->pixels + y * dst->bytes_per_row + x * 4,
+					dst->bytes_per_row, w, h, flags, b->colorkey);
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
+/*
+ * atlas packing
+ */
+
+/*
+ * pack n surfaces into a new w by h atlas using height sorted shelves.
+ * regions receives the placement of each surface, in input order.
+ * returns NULL if they don't fit or their bpp differs
+ */
+surface_t *sprite_pack_atlas(surface_t **surfaces, int n, int w, int h,
+	sprite_region_t *regions)
+{
+	/* variables */
+	surface_t *ret;
+	int *order;
+	int i, j, t, x, y, shelf;
+
+	/* sanity checks */
+	if (!surfaces || !regions || n < 1) return NULL;
+
+	for (i = 0; i < n; i++)
+	{
+		if (!surfaces[i] || !surfaces[i]->pixels) return NULL;
+		if (surfaces[i]->bpp != surfaces[0]->bpp) return NULL;
+	}
+
+	/* order by descending height, insertion sort is fine offline */
+	order = (int *)LIBREX_MALLOC(n * sizeof(int));
+	if (!order) return NULL;
+
+	for (i = 0; i < n; i++)
+	{
+		t = i;
+		for (j = i; j > 0 && surfaces[order[j - 1]]->h < surfaces[t]->h; j--)
+			order[j] = order[j - 1];
+		order[j] = t;
+	}
+
+	/* place on shelves */
+	x = 0;
+	y = 0;
+	shelf = 0;
+
+	for (i = 0; i < n; i++)
+	{
+		t = order[i];
+
+		/* next shelf */
+		if (x + surfaces[t]->w > w)
+		{
+			x = 0;
+			y += shelf;
+			shelf = 0;
+		}
+
+		/* out of room */
+		if (surfaces[t]->w > w || y + surfaces[t]->h > h)
+		{
+			LIBREX_FREE(order);
+			return NULL;
+		}
+
+		regions[t].x = x;
+		regions[t].y = y;
+		regions[t].w = surfaces[t]->w;
+		regions[t].h = surfaces[t]->h;
+
+		x += surfaces[t]->w;
+		shelf = MAX(shelf, surfaces[t]->h);
+	}
+
+	LIBREX_FREE(order);
+
+	/* create atlas and copy everything in */
+	ret = surface_create(w, h, surfaces[0]->bpp, NULL);
+	if (!ret) return NULL;
+
+	ret->palette = surfaces[0]->palette;
+
+	for (i = 0; i < n; i++)
+	{
+		surface_blit(surfaces[i], ret, 0, 0, regions[i].w, regions[i].h,
+			regions[i].x, regions[i].y);
+	}
+
+	/* return ptr */
+	return ret;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_SPRITE_H__ */
@@ -32,7 +32,7 @@
  *
  * authors: erysdren
  *
- * last modified: january 18 2023
+ * last modified: october 19 2026
  * 
  * description: global librex helpers
  *
@@ -106,6 +106,17 @@ extern "C" {
 
 #endif
 
+/* *************************************
+ *
+ * simd
+ *
+ * ********************************** */
+
+/* sse2 kernels, can be disabled with LIBREX_NO_SIMD */
+#if defined(__SSE2__) && !defined(LIBREX_NO_SIMD)
+#define LIBREX_SSE2 1
+#endif
+
 /* *************************************
  *
  * types
@@ -32,7 +32,7 @@
  *
  * authors: erysdren
  *
- * last modified: february 1 2023
+ * last modified: october 19 2026
  * 
  * description: rexsurface.h testapp
  *
@@ -62,8 +62,22 @@ int main(int argc, char **argv)
 	surface_clear(s1, &black);
 	surface_borderbox(s1, 32, 32, 16, 16, &red);
 
-	/* duplicate s1 to s2 */
+	/* nested clip rectangles, the box is cut to 8x8 at 4, 4 */
+	surface_clip_push(s1, 0, 0, 12, 12);
+	surface_clip_push(s1, 4, 4, 32, 32);
+	surface_filledbox(s1, 0, 0, 64, 64, &red);
+	surface_clip_pop(s1);
+	surface_clip_pop(s1);
+
+	/* off-screen lines are rejected */
+	surface_line_horizontal(s1, 0, 100, 64, &red);
+
+	/* duplicate s1 to s2, the pixels are shared until s2 is drawn to */
 	s2 = surface_duplicate(s1);
+	printf("shared: %d\n", s1->pixels == s2->pixels);
+
+	surface_pixel(s2, 0, 0, &red);
+	printf("shared after write: %d\n", s1->pixels == s2->pixels);
 
 	/* save surface */
 	surface_dump_buffer(s1, "test1.data");
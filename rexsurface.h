@@ -32,7 +32,7 @@
  *
  * authors: erysdren
  *
- * last modified: february 1 2023
+ * last modified: october 19 2026
  *
  * description: pixel buffer operations
  *
@@ -71,18 +71,64 @@ extern "C" {
 
 /* rex */
 #include "rexstd.h"
+#include "rexmath.h"
 #include "rexcolor.h"
 #include "rexmem.h"
 
 #endif
 
+/*
+ * atomic reference counts for shared pixel buffers. gcc style builtins or
+ * win32 interlocked calls, plain counts on targets without threads
+ */
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+#define SURFACE_REF_INC(a) __atomic_add_fetch((a), 1, __ATOMIC_ACQ_REL)
+#define SURFACE_REF_DEC(a) __atomic_sub_fetch((a), 1, __ATOMIC_ACQ_REL)
+#define SURFACE_REF_GET(a) __atomic_load_n((a), __ATOMIC_ACQUIRE)
+#elif defined(__GNUC__)
+#define SURFACE_REF_INC(a) __sync_add_and_fetch((a), 1)
+#define SURFACE_REF_DEC(a) __sync_sub_and_fetch((a), 1)
+#define SURFACE_REF_GET(a) (*(a))
+#elif defined(_WIN32)
+#include <windows.h>
+#define SURFACE_REF_INC(a) InterlockedIncrement((a))
+#define SURFACE_REF_DEC(a) InterlockedDecrement((a))
+#define SURFACE_REF_GET(a) (*(a))
+#else
+#define SURFACE_REF_INC(a) (++*(a))
+#define SURFACE_REF_DEC(a) (--*(a))
+#define SURFACE_REF_GET(a) (*(a))
+#endif
+
 /* *************************************
  *
  * the types
  *
  * ********************************** */
 
-/* the surface type */
+/* maximum depth of the clip rectangle stack */
+#define SURFACE_CLIP_DEPTH 16
+
+/* rectangle, x2 and y2 are exclusive */
+typedef struct surface_rect_t
+{
+	int x1;
+	int y1;
+	int x2;
+	int y2;
+} surface_rect_t;
+
+/* reference counted pixel storage, shared between duplicates */
+typedef struct surface_buffer_t
+{
+	volatile long refs;
+	void *pixels;
+} surface_buffer_t;
+
+/*
+ * the surface type. surfaces that allocated their own pixels keep them in
+ * buffer, which duplicates share until one of them is drawn to
+ */
 typedef struct surface_t
 {
 	int w;
@@ -90,7 +136,11 @@ typedef struct surface_t
 	int bpp;
 	int bytes_per_row;
 	void *pixels;
-	surface_t **palette;
+	surface_buffer_t *buffer;
+	struct surface_t **palette;
+	surface_rect_t clip;
+	int clip_depth;
+	surface_rect_t clip_stack[SURFACE_CLIP_DEPTH];
 } surface_t;
 
 /* *************************************
@@ -105,6 +155,7 @@ void surface_destroy(surface_t *s);
 
 /* surface modification */
 surface_t *surface_duplicate(surface_t *s);
+int surface_detach(surface_t *s);
 void surface_copy(surface_t *src, surface_t *dst);
 void surface_clear(surface_t *s, color_t *c);
 void surface_pixel(surface_t *s, int x, int y, color_t *c);
@@ -112,6 +163,15 @@ void surface_filledbox(surface_t *s, int x, int y, int w, int h, color_t *c);
 void surface_borderbox(surface_t *s, int x, int y, int w, int h, color_t *c);
 void surface_line_horizontal(surface_t *s, int x1, int y, int x2, color_t *c);
 void surface_line_vertical(surface_t *s, int x, int y1, int y2, color_t *c);
+void surface_blit(surface_t *src, surface_t *dst, int sx, int sy, int w, int h,
+	int dx, int dy);
+
+/* surface clipping */
+void surface_clip_reset(surface_t *s);
+int surface_clip_push(surface_t *s, int x, int y, int w, int h);
+void surface_clip_pop(surface_t *s);
+void surface_clip_intersect(surface_t *s, int x, int y, int w, int h);
+int surface_clip_empty(surface_t *s);
 
 /* surface palette operations */
 void surface_set_palette(surface_t *s, surface_t **palette);
@@ -148,6 +208,7 @@ surface_t *surface_create(int w, int h, int bpp, void *pixels)
 	ret->h = h;
 	ret->w = w;
 	ret->bytes_per_row = w * (bpp / 8);
+	surface_clip_reset(ret);
 
 	/* if pixel buffer provided */
 	if (pixels)
@@ -158,20 +219,47 @@ surface_t *surface_create(int w, int h, int bpp, void *pixels)
 	else
 	{
 		/* allocate buffer */
-		ret->pixels = LIBREX_CALLOC(w * h, bpp / 8);
-		if (!ret->pixels) return NULL;
+		ret->buffer = LIBREX_CALLOC(1, sizeof(surface_buffer_t));
+		if (!ret->buffer)
+		{
+			LIBREX_FREE(ret);
+			return NULL;
+		}
+
+		ret->buffer->pixels = LIBREX_CALLOC(w * h, bpp / 8);
+		if (!ret->buffer->pixels)
+		{
+			LIBREX_FREE(ret->buffer);
+			LIBREX_FREE(ret);
+			return NULL;
+		}
+
+		ret->buffer->refs = 1;
+		ret->pixels = ret->buffer->pixels;
 	}
 
 	/* return ptr */
 	return ret;
 }
 
+/* drop a reference to a shared buffer, freeing it with the last one */
+static void surface_buffer_release(surface_buffer_t *b)
+{
+	if (SURFACE_REF_DEC(&b->refs) == 0)
+	{
+		LIBREX_FREE(b->pixels);
+		LIBREX_FREE(b);
+	}
+}
+
 /* destroy surface and free all associated memory */
 void surface_destroy(surface_t *s)
 {
 	if (s)
 	{
-		if (s->pixels)
+		if (s->buffer)
+			surface_buffer_release(s->buffer);
+		else if (s->pixels)
 			free(s->pixels);
 
 		free(s);
@@ -182,7 +270,11 @@ void surface_destroy(surface_t *s)
  * surface modification
  */
 
-/* return a pointer to a new allocated surface (a copy of s) */
+/*
+ * return a pointer to a new allocated surface (a copy of s). if s allocated
+ * its own pixels, the copy shares them until either surface is drawn to.
+ * surfaces made from caller pixels are copied straight away
+ */
 surface_t *surface_duplicate(surface_t *s)
 {
 	/* variables */
@@ -191,47 +283,111 @@ surface_t *surface_duplicate(surface_t *s)
 	/* sanity checks */
 	if (!s || !s->pixels) return NULL;
 
-	/* create return surface */
-	ret = surface_create(s->w, s->h, s->bpp, NULL);
-	surface_copy(s, ret);
+	/* caller pixels can't be shared */
+	if (!s->buffer)
+	{
+		ret = surface_create(s->w, s->h, s->bpp, NULL);
+		surface_copy(s, ret);
+		return ret;
+	}
+
+	/* alloc */
+	ret = LIBREX_CALLOC(1, sizeof(surface_t));
+	if (!ret) return NULL;
+
+	/* share the buffer */
+	ret->w = s->w;
+	ret->h = s->h;
+	ret->bpp = s->bpp;
+	ret->bytes_per_row = s->bytes_per_row;
+	ret->palette = s->palette;
+	ret->buffer = s->buffer;
+	ret->pixels = s->pixels;
+	surface_clip_reset(ret);
+
+	SURFACE_REF_INC(&s->buffer->refs);
 
 	/* return pointer */
 	return ret;
 }
 
+/* give s a buffer of its own if it's shared, copying the pixels if asked */
+static int surface_unshare(surface_t *s, int copy)
+{
+	/* variables */
+	surface_buffer_t *b;
+
+	/* not shared */
+	if (!s->buffer || SURFACE_REF_GET(&s->buffer->refs) == 1) return 1;
+
+	/* alloc */
+	b = LIBREX_CALLOC(1, sizeof(surface_buffer_t));
+	if (!b) return 0;
+
+	b->pixels = LIBREX_MALLOC(s->bytes_per_row * s->h);
+	if (!b->pixels)
+	{
+		LIBREX_FREE(b);
+		return 0;
+	}
+
+	/* copy, then let go of the shared buffer */
+	if (copy) memcpy(b->pixels, s->pixels, s->bytes_per_row * s->h);
+	b->refs = 1;
+
+	surface_buffer_release(s->buffer);
+
+	s->buffer = b;
+	s->pixels = b->pixels;
+
+	return 1;
+}
+
+/*
+ * give s its own copy of its pixels if they are shared with a duplicate.
+ * every drawing function calls this before writing, so it only needs to be
+ * called by code that writes to s->pixels itself. returns zero if the copy
+ * couldn't be allocated, in which case nothing should be drawn
+ */
+int surface_detach(surface_t *s)
+{
+	/* sanity checks */
+	if (!s) return 0;
+
+	return surface_unshare(s, 1);
+}
+
 /* copy the pixel contents from src to dst */
 void surface_copy(surface_t *src, surface_t *dst)
 {
 	/* sanity checks */
 	if (!src || !src->pixels || !dst || !dst->pixels) return;
+	if (src->pixels == dst->pixels) return;
+	if (!surface_detach(dst)) return;
 
 	/* perform copy */
 	memcpy(dst->pixels, src->pixels, src->bytes_per_row * src->h);
 }
 
-/* clear the surface with the specified color */
-void surface_clear(surface_t *s, color_t *c)
-{
-	/* sanity checks */
-	if (!s || !s->pixels || !c) return;
-	if (c->tag == INDEX8 && s->bpp != 8) return;
-	if (c->tag == RGB565 && s->bpp != 16) return;
-	if (c->tag == RGBA8888 && s->bpp != 32) return;
-	if (c->tag == ARGB8888 && s->bpp != 32) return;
+/* pointer to pixel x, y of a surface */
+#define SURFACE_PTR(s, x, y) ((uint8_t *)(s)->pixels + \
+	(y) * (s)->bytes_per_row + (x) * ((s)->bpp / 8))
 
-	/* clear the pixel buffer */
+/* fill n pixels at p with the color value for the surface bpp */
+static void surface_fill(surface_t *s, uint8_t *p, color_t *c, int n)
+{
 	switch (s->bpp)
 	{
 		case 8:
-			memset8(s->pixels, c->val.u8, s->w * s->h);
+			memset8(p, c->val.u8, n);
 			break;
 
 		case 16:
-			memset16(s->pixels, c->val.u16, s->w * s->h);
+			memset16(p, c->val.u16, n);
 			break;
 
 		case 32:
-			memset32(s->pixels, c->val.u32, s->w * s->h);
+			memset32(p, c->val.u32, n);
 			break;
 
 		default:
@@ -239,67 +395,112 @@ void surface_clear(surface_t *s, color_t *c)
 	}
 }
 
-/* plot a pixel on the surface */
-void surface_pixel(surface_t *s, int x, int y, color_t *c)
+/* clear the surface with the specified color, within the clip rectangle */
+void surface_clear(surface_t *s, color_t *c)
 {
+	/* variables */
+	int y;
+
 	/* sanity checks */
-	if (!s || !s->pixels || !c || x < 0 || y < 0) return;
-	if (x >= s->w || y >= s->h) return;
+	if (!s || !s->pixels || !c) return;
 	if (c->tag == INDEX8 && s->bpp != 8) return;
 	if (c->tag == RGB565 && s->bpp != 16) return;
 	if (c->tag == RGBA8888 && s->bpp != 32) return;
 	if (c->tag == ARGB8888 && s->bpp != 32) return;
+	if (surface_clip_empty(s)) return;
 
-	/* plot pixel */
-	switch (s->bpp)
+	/* unclipped, clear the whole pixel buffer at once */
+	if (s->clip.x1 == 0 && s->clip.y1 == 0 &&
+		s->clip.x2 == s->w && s->clip.y2 == s->h &&
+		s->bytes_per_row == s->w * (s->bpp / 8))
 	{
-		case 8:
-			((uint8_t *)s->pixels)[y * s->h + x] = c->val.u8;
-			break;
+		/* shared pixels are about to be overwritten, don't copy them */
+		if (!surface_unshare(s, 0)) return;
 
-		case 16:
-			((uint16_t *)s->pixels)[y * s->h + x] = c->val.u16;
-			break;
+		surface_fill(s, (uint8_t *)s->pixels, c, s->w * s->h);
+		return;
+	}
 
-		case 32:
-			((uint32_t *)s->pixels)[y * s->h + x] = c->val.u32;
-			break;
+	if (!surface_detach(s)) return;
 
-		default:
-			break;
+	/* clear the clip rectangle */
+	for (y = s->clip.y1; y < s->clip.y2; y++)
+	{
+		surface_fill(s, SURFACE_PTR(s, s->clip.x1, y), c,
+			s->clip.x2 - s->clip.x1);
 	}
 }
 
+/* plot a pixel on the surface */
+void surface_pixel(surface_t *s, int x, int y, color_t *c)
+{
+	/* sanity checks */
+	if (!s || !s->pixels || !c) return;
+	if (x < s->clip.x1 || y < s->clip.y1) return;
+	if (x >= s->clip.x2 || y >= s->clip.y2) return;
+	if (c->tag == INDEX8 && s->bpp != 8) return;
+	if (c->tag == RGB565 && s->bpp != 16) return;
+	if (c->tag == RGBA8888 && s->bpp != 32) return;
+	if (c->tag == ARGB8888 && s->bpp != 32) return;
+
+	if (!surface_detach(s)) return;
+
+	/* plot pixel */
+	surface_fill(s, SURFACE_PTR(s, x, y), c, 1);
+}
+
 /* draw a filled box */
 void surface_filledbox(surface_t *s, int x, int y, int w, int h, color_t *c)
 {
 	/* variables */
-	int i;
+	int i, x2, y2;
 
 	/* sanity checks */
+	if (!s || !s->pixels || !c) return;
 	if (w < 1 || h < 1) return;
+	if (c->tag == INDEX8 && s->bpp != 8) return;
+	if (c->tag == RGB565 && s->bpp != 16) return;
+	if (c->tag == RGBA8888 && s->bpp != 32) return;
+	if (c->tag == ARGB8888 && s->bpp != 32) return;
+
+	/* clip */
+	x2 = MIN(x + w, s->clip.x2);
+	y2 = MIN(y + h, s->clip.y2);
+	x = MAX(x, s->clip.x1);
+	y = MAX(y, s->clip.y1);
+
+	/* fully clipped */
+	if (x >= x2 || y >= y2) return;
+	if (!surface_detach(s)) return;
 
 	/* make cube */
-	for (i = y; i < y + h; i++)
+	for (i = y; i < y2; i++)
 	{
-		surface_line_horizontal(s, x, i, x + w, c);
+		surface_fill(s, SURFACE_PTR(s, x, i), c, x2 - x);
 	}
 }
 
 /* draw a border box */
 void surface_borderbox(surface_t *s, int x, int y, int w, int h, color_t *c)
 {
+	/* sanity checks */
+	if (!s || w < 1 || h < 1) return;
+
+	/* fully clipped */
+	if (x >= s->clip.x2 || y >= s->clip.y2) return;
+	if (x + w <= s->clip.x1 || y + h <= s->clip.y1) return;
+
 	surface_line_horizontal(s, x, y, x + w, c);
 	surface_line_horizontal(s, x, y + h - 1, x + w, c);
 	surface_line_vertical(s, x, y, y + h, c);
 	surface_line_vertical(s, x + w - 1, y, y + h, c);
 }
 
-/* draw a horizontal line */
+/* draw a horizontal line from x1 to x2 (exclusive) */
 void surface_line_horizontal(surface_t *s, int x1, int y, int x2, color_t *c)
 {
 	/* variables */
-	int start, width;
+	int t;
 
 	/* if it has a width of one, just plot a pixel */
 	if (x1 == x2)
@@ -315,45 +516,33 @@ void surface_line_horizontal(surface_t *s, int x1, int y, int x2, color_t *c)
 	if (c->tag == RGBA8888 && s->bpp != 32) return;
 	if (c->tag == ARGB8888 && s->bpp != 32) return;
 
-	/* more sanity checks */
-	x1 = x1 >= s->w ? s->w - 1 : x1;
-	x1 = x1 < 0 ? 0 : x1;
+	/* rows outside the clip rectangle are rejected, not clamped */
+	if (y < s->clip.y1 || y >= s->clip.y2) return;
 
-	x2 = x2 >= s->w ? s->w - 1 : x2;
-	x2 = x2 < 0 ? 0 : x2;
-
-	y = y >= s->h ? s->h - 1 : y;
-	y = y < 0 ? 0 : y;
-
-	/* calculate start & width */
-	start = ((x2 > x1 ? x1 : x2) * (s->bpp / 8)) + (y * s->bytes_per_row);
-	width = x2 > x1 ? x2 - x1 : x1 - x2;
-
-	/* plot line */
-	switch (s->bpp)
+	/* order endpoints */
+	if (x2 < x1)
 	{
-		case 8:
-			memset8(s->pixels + start, c->val.u8, width);
-			break;
-
-		case 16:
-			memset16(s->pixels + start, c->val.u16, width);
-			break;
+		t = x1;
+		x1 = x2;
+		x2 = t;
+	}
 
-		case 32:
-			memset32(s->pixels + start, c->val.u32, width);
-			break;
+	/* clip */
+	x1 = MAX(x1, s->clip.x1);
+	x2 = MIN(x2, s->clip.x2);
+	if (x1 >= x2) return;
+	if (!surface_detach(s)) return;
 
-		default:
-			break;
-	}
+	/* plot line */
+	surface_fill(s, SURFACE_PTR(s, x1, y), c, x2 - x1);
 }
 
-/* plot a vertical line */
+/* plot a vertical line from y1 to y2 (exclusive) */
 void surface_line_vertical(surface_t *s, int x, int y1, int y2, color_t *c)
 {
 	/* variables */
-	int i, start, end;
+	int i, t;
+	uint8_t *p;
 
 	/* sanity check */
 	if (y1 == y2)
@@ -362,15 +551,180 @@ void surface_line_vertical(surface_t *s, int x, int y1, int y2, color_t *c)
 		return;
 	}
 
+	/* sanity checks */
+	if (!s || !s->pixels || !c) return;
+	if (c->tag == INDEX8 && s->bpp != 8) return;
+	if (c->tag == RGB565 && s->bpp != 16) return;
+	if (c->tag == RGBA8888 && s->bpp != 32) return;
+	if (c->tag == ARGB8888 && s->bpp != 32) return;
+
+	/* columns outside the clip rectangle are rejected */
+	if (x < s->clip.x1 || x >= s->clip.x2) return;
+
 	/* determine start and end */
-	start = y2 > y1 ? y1 : y2;
-	end = y2 > y1 ? y2 : y1;
+	if (y2 < y1)
+	{
+		t = y1;
+		y1 = y2;
+		y2 = t;
+	}
+
+	/* clip */
+	y1 = MAX(y1, s->clip.y1);
+	y2 = MIN(y2, s->clip.y2);
+	if (y1 >= y2) return;
+	if (!surface_detach(s)) return;
 
 	/* plot loop */
-	for (i = start; i < end; i++)
+	p = SURFACE_PTR(s, x, y1);
+	for (i = y1; i < y2; i++)
+	{
+		surface_fill(s, p, c, 1);
+		p += s->bytes_per_row;
+	}
+}
+
+/* copy a w by h rectangle of src at sx, sy to dst at dx, dy */
+void surface_blit(surface_t *src, surface_t *dst, int sx, int sy, int w, int h,
+	int dx, int dy)
+{
+	/* variables */
+	int i, bytes;
+	uint8_t *s, *d;
+
+	/* sanity checks */
+	if (!src || !src->pixels || !dst || !dst->pixels) return;
+	if (src->bpp != dst->bpp) return;
+
+	/* clip against src */
+	if (sx < 0)
+	{
+		w += sx;
+		dx -= sx;
+		sx = 0;
+	}
+
+	if (sy < 0)
 	{
-		surface_pixel(s, x, i, c);
+		h += sy;
+		dy -= sy;
+		sy = 0;
 	}
+
+	if (sx + w > src->w) w = src->w - sx;
+	if (sy + h > src->h) h = src->h - sy;
+
+	/* clip against the dst clip rectangle */
+	if (dx < dst->clip.x1)
+	{
+		w -= dst->clip.x1 - dx;
+		sx += dst->clip.x1 - dx;
+		dx = dst->clip.x1;
+	}
+
+	if (dy < dst->clip.y1)
+	{
+		h -= dst->clip.y1 - dy;
+		sy += dst->clip.y1 - dy;
+		dy = dst->clip.y1;
+	}
+
+	if (dx + w > dst->clip.x2) w = dst->clip.x2 - dx;
+	if (dy + h > dst->clip.y2) h = dst->clip.y2 - dy;
+
+	/* fully clipped */
+	if (w < 1 || h < 1) return;
+	if (!surface_detach(dst)) return;
+
+	/* row pointers */
+	bytes = src->bpp / 8;
+	s = (uint8_t *)src->pixels + sy * src->bytes_per_row + sx * bytes;
+	d = (uint8_t *)dst->pixels + dy * dst->bytes_per_row + dx * bytes;
+
+	/* copy rows, memmove in case src and dst are the same surface */
+	if (src == dst && dy > sy)
+	{
+		s += (h - 1) * src->bytes_per_row;
+		d += (h - 1) * dst->bytes_per_row;
+
+		for (i = 0; i < h; i++)
+		{
+			memmove(d, s, w * bytes);
+			s -= src->bytes_per_row;
+			d -= dst->bytes_per_row;
+		}
+	}
+	else
+	{
+		for (i = 0; i < h; i++)
+		{
+			memmove(d, s, w * bytes);
+			s += src->bytes_per_row;
+			d += dst->bytes_per_row;
+		}
+	}
+}
+
+/*
+ * surface clipping
+ */
+
+/* reset the clip rectangle to the whole surface and empty the stack */
+void surface_clip_reset(surface_t *s)
+{
+	/* sanity checks */
+	if (!s) return;
+
+	s->clip.x1 = 0;
+	s->clip.y1 = 0;
+	s->clip.x2 = s->w;
+	s->clip.y2 = s->h;
+	s->clip_depth = 0;
+}
+
+/*
+ * save the current clip rectangle and narrow it to its intersection with
+ * the given one. returns 0 if the stack is full
+ */
+int surface_clip_push(surface_t *s, int x, int y, int w, int h)
+{
+	/* sanity checks */
+	if (!s || s->clip_depth >= SURFACE_CLIP_DEPTH) return 0;
+
+	/* save */
+	s->clip_stack[s->clip_depth++] = s->clip;
+
+	/* narrow */
+	surface_clip_intersect(s, x, y, w, h);
+
+	return 1;
+}
+
+/* restore the clip rectangle saved by the last push */
+void surface_clip_pop(surface_t *s)
+{
+	/* sanity checks */
+	if (!s || s->clip_depth < 1) return;
+
+	s->clip = s->clip_stack[--s->clip_depth];
+}
+
+/* narrow the current clip rectangle without saving it */
+void surface_clip_intersect(surface_t *s, int x, int y, int w, int h)
+{
+	/* sanity checks */
+	if (!s) return;
+
+	s->clip.x1 = MAX(s->clip.x1, x);
+	s->clip.y1 = MAX(s->clip.y1, y);
+	s->clip.x2 = MIN(s->clip.x2, x + w);
+	s->clip.y2 = MIN(s->clip.y2, y + h);
+}
+
+/* returns 1 if nothing can be drawn to the surface */
+int surface_clip_empty(surface_t *s)
+{
+	return !s || s->clip.x1 >= s->clip.x2 || s->clip.y1 >= s->clip.y2;
 }
 
 /*
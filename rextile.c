@@ -0,0 +1,116 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rextile.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rextile.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* rex */
+#include "rexraster.h"
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	static const char *names[] = {"linear", "4x4", "8x8", "morton"};
+	surface_t *tex, *back, *dst, *ref;
+	tiled_t *tiled;
+	raster_vertex_t v[3];
+	int x, y, layout;
+
+	/* create surfaces */
+	tex = surface_create(256, 128, 32, NULL);
+	back = surface_create(256, 128, 32, NULL);
+	dst = surface_create(320, 200, 32, NULL);
+	ref = surface_create(320, 200, 32, NULL);
+
+	/* texture */
+	for (y = 0; y < tex->h; y++)
+	{
+		for (x = 0; x < tex->w; x++)
+		{
+			((uint32_t *)tex->pixels)[y * tex->w + x] =
+				pack_argb8888(x, y * 2, ((x / 16) ^ (y / 16)) & 1 ? 255 : 0, 255);
+		}
+	}
+
+	/* a rotated, perspective triangle */
+	v[0].x = REAL(20); v[0].y = REAL(10); v[0].z = REAL(1); v[0].u = REAL(0); v[0].v = REAL(0);
+	v[1].x = REAL(300); v[1].y = REAL(60); v[1].z = REAL(2); v[1].u = REAL(512); v[1].v = REAL(64);
+	v[2].x = REAL(60); v[2].y = REAL(190); v[2].z = REAL(4); v[2].u = REAL(64); v[2].v = REAL(384);
+
+	raster_triangle_textured(ref, tex, &v[0], &v[1], &v[2], NULL);
+
+	/* print header */
+	printf("librex: rextile.h test\n");
+	printf("\n");
+
+	for (layout = TILE_LINEAR; layout <= TILE_MORTON; layout++)
+	{
+		tiled = tiled_create(tex->w, tex->h, tex->bpp, layout);
+
+		/* round trip */
+		tiled_swizzle(tex, tiled);
+		memset(back->pixels, 0, back->bytes_per_row * back->h);
+		tiled_unswizzle(tiled, back);
+
+		/* draw with the tiled texture */
+		memset(dst->pixels, 0, dst->bytes_per_row * dst->h);
+		raster_triangle_tiled(dst, tiled, &v[0], &v[1], &v[2], NULL);
+
+		printf("%s: offset of 5, 3 is %lu, round trip %s, triangle %s\n",
+			names[layout], (unsigned long)TILED_OFFSET(tiled, 5, 3),
+			memcmp(tex->pixels, back->pixels, tex->bytes_per_row * tex->h) ? "mismatch" : "ok",
+			memcmp(ref->pixels, dst->pixels, ref->bytes_per_row * ref->h) ? "mismatch" : "ok");
+
+		tiled_destroy(tiled);
+	}
+
+	surface_dump_buffer(dst, "rextile.data");
+
+	/* destroy surfaces */
+	surface_destroy(tex);
+	surface_destroy(back);
+	surface_destroy(dst);
+	surface_destroy(ref);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
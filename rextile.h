@@ -0,0 +1,489 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rextile.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: tiled and morton order surfaces
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_TILE_H__
+#define __LIBREX_TILE_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexmath.h"
+#include "rexfixed.h"
+#include "rexsurface.h"
+
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+/* pixel layouts */
+enum tile_layout
+{
+	TILE_LINEAR,
+	TILE_4X4,
+	TILE_8X8,
+	TILE_MORTON
+};
+
+/*
+ * surface with a cache friendly pixel layout. the offset of pixel x, y is
+ * xoffs[x] + yoffs[y] for every layout, so samplers don't need to know
+ * which one is in use
+ */
+typedef struct tiled_t
+{
+	int w;
+	int h;
+	int bpp;
+	int layout;
+	int umask;
+	int vmask;
+	uint32_t *xoffs;
+	uint32_t *yoffs;
+	void *pixels;
+} tiled_t;
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* tiled surface creation and destruction */
+tiled_t *tiled_create(int w, int h, int bpp, int layout);
+void tiled_destroy(tiled_t *t);
+
+/* conversion to and from row major surfaces */
+void tiled_swizzle(surface_t *src, tiled_t *dst);
+void tiled_unswizzle(tiled_t *src, surface_t *dst);
+
+/* sampling */
+uint32_t tiled_sample(tiled_t *t, fix32 u, fix32 v);
+void tiled_sample_span(tiled_t *t, void *dst, int n, fix32 u, fix32 v,
+	fix32 du, fix32 dv);
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/* pixel offset of x, y in pixels */
+#define TILED_OFFSET(t, x, y) ((t)->xoffs[(x)] + (t)->yoffs[(y)])
+
+/* wrap power of two coordinates, clamp the rest */
+#define TILED_WRAP(c, n, mask) ((mask) >= 0 ? ((c) & (mask)) : \
+	(c) < 0 ? 0 : (c) >= (n) ? (n) - 1 : (c))
+
+/*
+ * internal helpers
+ */
+
+/* log2 of a power of two, -1 otherwise */
+static int tiled_log2(int n)
+{
+	/* variables */
+	int i;
+
+	for (i = 0; i < 31; i++)
+	{
+		if (n == (1 << i))
+			return i;
+	}
+
+	return -1;
+}
+
+/* spread the low bits of a across the even bits of the result */
+static uint32_t tiled_dilate(uint32_t a)
+{
+	a &= 0xFFFF;
+	a = (a | (a << 8)) & 0x00FF00FFUL;
+	a = (a | (a << 4)) & 0x0F0F0F0FUL;
+	a = (a | (a << 2)) & 0x33333333UL;
+	a = (a | (a << 1)) & 0x55555555UL;
+
+	return a;
+}
+
+/*
+ * fill the offset table of one axis. for morton order the shared low bits
+ * are interleaved, x on the even bits and y on the odd bits, and the extra
+ * high bits of a non square surface go on top
+ */
+static void tiled_build_axis(uint32_t *offs, int n, int layout, int tile,
+	int row_tiles, int shared, int is_y, int w)
+{
+	/* variables */
+	int i;
+	uint32_t low;
+
+	for (i = 0; i < n; i++)
+	{
+		switch (layout)
+		{
+			case TILE_4X4:
+			case TILE_8X8:
+				if (is_y)
+					offs[i] = (i / tile) * row_tiles * tile * tile + (i % tile) * tile;
+				else
+					offs[i] = (i / tile) * tile * tile + i % tile;
+				break;
+
+			case TILE_MORTON:
+				low = tiled_dilate(i & ((1 << shared) - 1));
+				offs[i] = (is_y ? low << 1 : low) |
+					((uint32_t)(i >> shared) << (shared * 2));
+				break;
+
+			default:
+				offs[i] = is_y ? (uint32_t)i * w : (uint32_t)i;
+				break;
+		}
+	}
+}
+
+/*
+ * tiled surface creation and destruction
+ */
+
+/*
+ * create a tiled surface. tile layouts take any size and are padded to
+ * whole tiles, morton order needs power of two dimensions
+ */
+tiled_t *tiled_create(int w, int h, int bpp, int layout)
+{
+	/* variables */
+	tiled_t *ret;
+	int tile, pw, ph, lw, lh, shared;
+
+	/* sanity checks */
+	if (w < 1 || h < 1 || w > 0xFFFF || h > 0xFFFF) return NULL;
+	if (bpp != 8 && bpp != 16 && bpp != 32) return NULL;
+
+	/* log2 of the dimensions */
+	lw = tiled_log2(w);
+	lh = tiled_log2(h);
+
+	/* padded size */
+	switch (layout)
+	{
+		case TILE_LINEAR:
+			tile = 1;
+			break;
+
+		case TILE_4X4:
+			tile = 4;
+			break;
+
+		case TILE_8X8:
+			tile = 8;
+			break;
+
+		case TILE_MORTON:
+			if (lw < 0 || lh < 0) return NULL;
+			tile = 1;
+			break;
+
+		default:
+			return NULL;
+	}
+
+	pw = (w + tile - 1) / tile * tile;
+	ph = (h + tile - 1) / tile * tile;
+	shared = MIN(lw, lh);
+
+	/* alloc */
+	ret = (tiled_t *)LIBREX_CALLOC(1, sizeof(tiled_t));
+	if (!ret) return NULL;
+
+	/* assign values */
+	ret->w = w;
+	ret->h = h;
+	ret->bpp = bpp;
+	ret->layout = layout;
+	ret->umask = lw >= 0 ? w - 1 : -1;
+	ret->vmask = lh >= 0 ? h - 1 : -1;
+
+	/* buffers */
+	ret->xoffs = (uint32_t *)LIBREX_MALLOC(w * sizeof(uint32_t));
+	ret->yoffs = (uint32_t *)LIBREX_MALLOC(h * sizeof(uint32_t));
+	ret->pixels = LIBREX_CALLOC((size_t)pw * ph, bpp / 8);
+
+	if (!ret->xoffs || !ret->yoffs || !ret->pixels)
+	{
+		tiled_destroy(ret);
+		return NULL;
+	}
+
+	/* offset tables */
+	tiled_build_axis(ret->xoffs, w, layout, tile, pw / tile, shared, 0, pw);
+	tiled_build_axis(ret->yoffs, h, layout, tile, pw / tile, shared, 1, pw);
+
+	/* return ptr */
+	return ret;
+}
+
+/* destroy tiled surface and free all associated memory */
+void tiled_destroy(tiled_t *t)
+{
+	if (t)
+	{
+		if (t->xoffs)
+			LIBREX_FREE(t->xoffs);
+
+		if (t->yoffs)
+			LIBREX_FREE(t->yoffs);
+
+		if (t->pixels)
+			LIBREX_FREE(t->pixels);
+
+		LIBREX_FREE(t);
+	}
+}
+
+/*
+ * conversion to and from row major surfaces
+ */
+
+/*
+ * copy one row between row major and tiled order. tiles store their rows
+ * contiguously, so tile layouts copy whole tile rows at a time
+ */
+static void tiled_copy_row(tiled_t *t, uint8_t *row, int y, int to_tiled)
+{
+	/* variables */
+	int x, n, bytes;
+	uint8_t *p;
+
+	/* start */
+	bytes = t->bpp / 8;
+	n = t->layout == TILE_4X4 ? 4 : t->layout == TILE_8X8 ? 8 : 1;
+
+	if (t->layout == TILE_LINEAR)
+		n = t->w;
+
+	for (x = 0; x < t->w; x += n)
+	{
+		p = (uint8_t *)t->pixels + TILED_OFFSET(t, x, y) * bytes;
+
+		if (n > 1)
+		{
+			if (to_tiled)
+				memcpy(p, row + x * bytes, MIN(n, t->w - x) * bytes);
+			else
+				memcpy(row + x * bytes, p, MIN(n, t->w - x) * bytes);
+
+			continue;
+		}
+
+		switch (bytes)
+		{
+			case 1:
+				if (to_tiled) *p = row[x];
+				else row[x] = *p;
+				break;
+
+			case 2:
+				if (to_tiled) *(uint16_t *)p = ((uint16_t *)row)[x];
+				else ((uint16_t *)row)[x] = *(uint16_t *)p;
+				break;
+
+			case 4:
+				if (to_tiled) *(uint32_t *)p = ((uint32_t *)row)[x];
+				else ((uint32_t *)row)[x] = *(uint32_t *)p;
+				break;
+		}
+	}
+}
+
+/* copy a row major surface into a tiled surface of the same size */
+void tiled_swizzle(surface_t *src, tiled_t *dst)
+{
+	/* variables */
+	int y;
+
+	/* sanity checks */
+	if (!src || !src->pixels || !dst) return;
+	if (src->w != dst->w || src->h != dst->h || src->bpp != dst->bpp) return;
+
+	for (y = 0; y < src->h; y++)
+		tiled_copy_row(dst, SURFACE_PTR(src, 0, y), y, 1);
+}
+
+/* copy a tiled surface into a row major surface of the same size */
+void tiled_unswizzle(tiled_t *src, surface_t *dst)
+{
+	/* variables */
+	int y;
+
+	/* sanity checks */
+	if (!src || !dst || !dst->pixels) return;
+	if (src->w != dst->w || src->h != dst->h || src->bpp != dst->bpp) return;
+	if (!surface_detach(dst)) return;
+
+	for (y = 0; y < dst->h; y++)
+		tiled_copy_row(src, SURFACE_PTR(dst, 0, y), y, 0);
+}
+
+/*
+ * sampling
+ */
+
+/* nearest sample at 16.16 texel coordinates u, v */
+uint32_t tiled_sample(tiled_t *t, fix32 u, fix32 v)
+{
+	/* variables */
+	int x, y;
+	uint32_t o;
+
+	/* sanity checks */
+	if (!t) return 0;
+
+	x = u >> 16;
+	y = v >> 16;
+	x = TILED_WRAP(x, t->w, t->umask);
+	y = TILED_WRAP(y, t->h, t->vmask);
+	o = TILED_OFFSET(t, x, y);
+
+	switch (t->bpp)
+	{
+		case 8: return ((uint8_t *)t->pixels)[o];
+		case 16: return ((uint16_t *)t->pixels)[o];
+		case 32: return ((uint32_t *)t->pixels)[o];
+		default: return 0;
+	}
+}
+
+/*
+ * n nearest samples along an affine step, written to dst in the bpp of the
+ * tiled surface. used for scaled and rotated blits and texture spans
+ */
+void tiled_sample_span(tiled_t *t, void *dst, int n, fix32 u, fix32 v,
+	fix32 du, fix32 dv)
+{
+	/* variables */
+	int i, x, y;
+
+	/* sanity checks */
+	if (!t || !dst) return;
+
+	/* power of two sizes wrap with masks, in tight loops per bpp */
+	if (t->umask >= 0 && t->vmask >= 0)
+	{
+		switch (t->bpp)
+		{
+			case 8:
+				for (i = 0; i < n; i++, u += du, v += dv)
+					((uint8_t *)dst)[i] = ((uint8_t *)t->pixels)[t->xoffs[(u >> 16) & t->umask] + t->yoffs[(v >> 16) & t->vmask]];
+				return;
+
+			case 16:
+				for (i = 0; i < n; i++, u += du, v += dv)
+					((uint16_t *)dst)[i] = ((uint16_t *)t->pixels)[t->xoffs[(u >> 16) & t->umask] + t->yoffs[(v >> 16) & t->vmask]];
+				return;
+
+			case 32:
+				for (i = 0; i < n; i++, u += du, v += dv)
+					((uint32_t *)dst)[i] = ((uint32_t *)t->pixels)[t->xoffs[(u >> 16) & t->umask] + t->yoffs[(v >> 16) & t->vmask]];
+				return;
+		}
+	}
+
+	/* clamped */
+	for (i = 0; i < n; i++, u += du, v += dv)
+	{
+		x = u >> 16;
+		y = v >> 16;
+		x = TILED_WRAP(x, t->w, t->umask);
+		y = TILED_WRAP(y, t->h, t->vmask);
+
+		switch (t->bpp)
+		{
+			case 8:
+				((uint8_t *)dst)[i] = ((uint8_t *)t->pixels)[TILED_OFFSET(t, x, y)];
+				break;
+
+			case 16:
+				((uint16_t *)dst)[i] = ((uint16_t *)t->pixels)[TILED_OFFSET(t, x, y)];
+				break;
+
+			case 32:
+				((uint32_t *)dst)[i] = ((uint32_t *)t->pixels)[TILED_OFFSET(t, x, y)];
+				break;
+		}
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_TILE_H__ */
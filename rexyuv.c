@@ -0,0 +1,186 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexyuv.c
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: rexyuv.h testapp
+ *
+ * ********************************** */
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* rex */
+#include "rexyuv.h"
+
+/* fill a surface with a smooth color field */
+static void fill_test_image(surface_t *s)
+{
+	/* variables */
+	int x, y;
+
+	for (y = 0; y < s->h; y++)
+	{
+		for (x = 0; x < s->w; x++)
+		{
+			((uint32_t *)s->pixels)[y * s->w + x] =
+				pack_argb8888(x * 255 / (s->w - 1), y * 255 / (s->h - 1),
+					255 - (x + y) * 255 / (s->w + s->h - 2), 255);
+		}
+	}
+}
+
+/* largest per channel difference between two argb8888 surfaces */
+static int max_error(surface_t *a, surface_t *b)
+{
+	/* variables */
+	int i, k, d, ret;
+	uint32_t pa, pb;
+
+	ret = 0;
+
+	for (i = 0; i < a->w * a->h; i++)
+	{
+		pa = ((uint32_t *)a->pixels)[i];
+		pb = ((uint32_t *)b->pixels)[i];
+
+		for (k = 0; k < 24; k += 8)
+		{
+			d = (int)((pa >> k) & 0xFF) - (int)((pb >> k) & 0xFF);
+			if (d < 0) d = -d;
+			if (d > ret) ret = d;
+		}
+	}
+
+	return ret;
+}
+
+int main(int argc, char **argv)
+{
+	/* variables */
+	static const char *layouts[3] = {"4:4:4", "4:2:2", "4:2:0"};
+	static const char *matrices[4] = {"bt.601 full", "bt.601 limited",
+		"bt.709 full", "bt.709 limited"};
+	surface_t *src, *dst, *gray;
+	uint8_t *frame;
+	uint16_t h[4];
+	uint8_t s[4], v[4];
+	uint32_t px[4];
+	int cw, ch, l, m, mode, i, err;
+
+	/* create surfaces */
+	src = surface_create(67, 35, 32, NULL);
+	dst = surface_create(67, 35, 32, NULL);
+	gray = surface_create(16, 4, 32, NULL);
+	fill_test_image(src);
+
+	/* print header */
+	printf("librex: rexyuv.h test\n");
+	printf("\n");
+
+	/* round trips through every matrix and layout */
+	for (m = 0; m < 4; m++)
+	{
+		for (l = 0; l < 3; l++)
+		{
+			mode = l | (m & 2 ? YUV_BT709 : 0) | (m & 1 ? YUV_LIMITED : 0);
+			yuv_chroma_size(src->w, src->h, mode, &cw, &ch);
+
+			frame = (uint8_t *)malloc(yuv_frame_size(src->w, src->h, mode));
+			yuv_from_argb8888(src, frame, frame + src->w * src->h,
+				frame + src->w * src->h + cw * ch, mode);
+			yuv_to_argb8888(frame, frame + src->w * src->h,
+				frame + src->w * src->h + cw * ch, dst, mode);
+
+			printf("%-14s %s: y=%3u cb=%3u cr=%3u max error %d\n",
+				matrices[m], layouts[l], frame[0], frame[src->w * src->h],
+				frame[src->w * src->h + cw * ch], max_error(src, dst));
+
+			free(frame);
+		}
+	}
+
+	printf("\n");
+
+	/* grays carry no chroma in any mode */
+	for (i = 0; i < gray->w * gray->h; i++)
+		((uint32_t *)gray->pixels)[i] = pack_argb8888(i * 4, i * 4, i * 4, 255);
+
+	err = 0;
+	frame = (uint8_t *)malloc(yuv_frame_size(gray->w, gray->h, YUV_444));
+	for (m = 0; m < 16; m += 4)
+	{
+		mode = YUV_444 | m;
+		yuv_from_argb8888(gray, frame, frame + 64, frame + 128, mode);
+		for (i = 0; i < 64; i++)
+		{
+			if (frame[64 + i] != 128 || frame[128 + i] != 128) err++;
+		}
+	}
+	free(frame);
+	printf("gray chroma mismatches: %d\n", err);
+
+	/* hsv */
+	px[0] = pack_argb8888(255, 0, 0, 255);
+	px[1] = pack_argb8888(0, 255, 0, 128);
+	px[2] = pack_argb8888(40, 80, 200, 255);
+	px[3] = pack_argb8888(90, 90, 90, 0);
+
+	hsv_from_argb8888(px, h, s, v, 4);
+	for (i = 0; i < 4; i++)
+		printf("hsv %08x: h=%4u s=%3u v=%3u\n", (unsigned)px[i], h[i], s[i], v[i]);
+
+	hsv_to_argb8888(h, s, v, px, 4);
+	for (i = 0; i < 4; i++)
+		printf("rgb %08x\n", (unsigned)px[i]);
+
+	/* hsv round trip of the test image */
+	surface_copy(src, dst);
+	hsv_adjust(dst, 0, 256, 256);
+	printf("hsv round trip max error %d\n", max_error(src, dst));
+
+	/* shift hue by a third and desaturate */
+	hsv_adjust(dst, HSV_HUE_MAX / 3, 192, 256);
+	printf("graded: %08x\n", (unsigned)((uint32_t *)dst->pixels)[0]);
+	surface_dump_buffer(dst, "graded.data");
+
+	/* destroy surfaces */
+	surface_destroy(src);
+	surface_destroy(dst);
+	surface_destroy(gray);
+
+	/* exit gracefully */
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,707 @@
+/* ****************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 erysdren
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * ************************************************************************* */
+
+/* *************************************
+ *
+ * project: librex
+ *
+ * file: rexyuv.h
+ *
+ * authors: erysdren
+ *
+ * last modified: october 19 2026
+ *
+ * description: ycbcr and hsv color space conversion
+ *
+ * ********************************** */
+
+/* header guard */
+#pragma once
+#ifndef __LIBREX_YUV_H__
+#define __LIBREX_YUV_H__
+
+/* cpp guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* *************************************
+ *
+ * the headers
+ *
+ * ********************************** */
+
+/* if we're included outside of rex.h */
+#ifndef __LIBREX_H__
+
+/* std */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* stdint */
+#ifdef __DJGPP__
+#include "rexint.h"
+#else
+#include <stdint.h>
+#endif
+
+/* rex */
+#include "rexstd.h"
+#include "rexmath.h"
+#include "rexsurface.h"
+
+#endif
+
+/* simd */
+#ifdef LIBREX_SSE2
+#include <emmintrin.h>
+#endif
+
+/* *************************************
+ *
+ * the types
+ *
+ * ********************************** */
+
+/*
+ * conversion modes. one chroma layout, optionally or'd with a matrix and a
+ * range. the default is full range bt.601, as used by jpeg and y4m capture
+ */
+enum yuv_mode
+{
+	YUV_444 = 0,			/* chroma at full resolution */
+	YUV_422 = 1,			/* chroma halved horizontally */
+	YUV_420 = 2,			/* chroma halved in both directions */
+	YUV_LAYOUT_MASK = 3,
+	YUV_BT709 = 4,			/* hdtv matrix instead of bt.601 */
+	YUV_LIMITED = 8			/* luma 16..235, chroma 16..240 */
+};
+
+/* hue is 0..HSV_HUE_MAX - 1, six sectors of 256 steps */
+#define HSV_HUE_MAX 1536
+
+/* *************************************
+ *
+ * the forward declarations
+ *
+ * ********************************** */
+
+/* plane sizes */
+void yuv_chroma_size(int w, int h, int mode, int *cw, int *ch);
+int yuv_frame_size(int w, int h, int mode);
+
+/* surface conversion */
+void yuv_from_argb8888(surface_t *src, uint8_t *y, uint8_t *cb, uint8_t *cr,
+	int mode);
+void yuv_to_argb8888(uint8_t *y, uint8_t *cb, uint8_t *cr, surface_t *dst,
+	int mode);
+
+/* hsv */
+void hsv_from_argb8888(uint32_t *src, uint16_t *h, uint8_t *s, uint8_t *v,
+	int n);
+void hsv_to_argb8888(uint16_t *h, uint8_t *s, uint8_t *v, uint32_t *dst,
+	int n);
+void hsv_adjust(surface_t *dst, int hue, int sat, int val);
+
+/* *************************************
+ *
+ * the functions
+ *
+ * ********************************** */
+
+/*
+ * coefficients
+ */
+
+/*
+ * per mode coefficients. the forward rows are 2.14 fixed point and each
+ * chroma row sums to zero so grays land exactly on 128. the inverse terms
+ * are 3.13 so the largest of them still fits a signed 16-bit lane
+ */
+typedef struct yuv_coef_t
+{
+	int yoff;
+	int yr, yg, yb;
+	int ur, ug, ub;
+	int vr, vg, vb;
+	int iy, rv, gu, gv, bu;
+} yuv_coef_t;
+
+static const yuv_coef_t yuv_coefs[4] = {
+	/* bt.601 full */
+	{0, 4899, 9617, 1868, -2765, -5427, 8192, 8192, -6860, -1332,
+		8192, 11485, 2819, 5850, 14516},
+	/* bt.601 limited */
+	{16, 4207, 8260, 1604, -2428, -4768, 7196, 7196, -6026, -1170,
+		9539, 13075, 3209, 6660, 16525},
+	/* bt.709 full */
+	{0, 3483, 11718, 1183, -1877, -6315, 8192, 8192, -7441, -751,
+		8192, 12901, 1535, 3835, 15201},
+	/* bt.709 limited */
+	{16, 2991, 10064, 1016, -1649, -5547, 7196, 7196, -6536, -660,
+		9539, 14686, 1747, 4366, 17305}
+};
+
+/* coefficients for a mode */
+#define YUV_COEF(mode) (&yuv_coefs[(((mode) & YUV_BT709) ? 2 : 0) + \
+	(((mode) & YUV_LIMITED) ? 1 : 0)])
+
+/*
+ * plane sizes
+ */
+
+/* chroma plane dimensions for a w by h image */
+void yuv_chroma_size(int w, int h, int mode, int *cw, int *ch)
+{
+	/* variables */
+	int layout;
+
+	layout = mode & YUV_LAYOUT_MASK;
+
+	if (cw) *cw = layout == YUV_444 ? w : (w + 1) / 2;
+	if (ch) *ch = layout == YUV_420 ? (h + 1) / 2 : h;
+}
+
+/* bytes needed for the three planes of a w by h image */
+int yuv_frame_size(int w, int h, int mode)
+{
+	/* variables */
+	int cw, ch;
+
+	yuv_chroma_size(w, h, mode, &cw, &ch);
+
+	return w * h + cw * ch * 2;
+}
+
+/*
+ * row kernels
+ */
+
+/*
+ * one row of 8-bit samples from argb8888 pixels as a weighted sum of r, g
+ * and b. bias holds the offset and rounding, and is large enough that the
+ * sum is never negative
+ */
+static void yuv_row_dot(uint32_t *src, uint8_t *dst, int w, int cr, int cg,
+	int cb, int bias)
+{
+	/* variables */
+	int x, v;
+	uint32_t p;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	{
+		/* variables */
+		__m128i z, coef, add, lo, hi, a, b;
+
+		z = _mm_setzero_si128();
+		coef = _mm_set_epi16(0, (short)cr, (short)cg, (short)cb,
+			0, (short)cr, (short)cg, (short)cb);
+		add = _mm_set1_epi32(bias);
+
+		for (; x + 8 <= w; x += 8)
+		{
+			a = _mm_loadu_si128((__m128i *)(src + x));
+			b = _mm_loadu_si128((__m128i *)(src + x + 4));
+
+			/* b*cb + g*cg and r*cr + a*0 per pixel */
+			lo = _mm_madd_epi16(_mm_unpacklo_epi8(a, z), coef);
+			hi = _mm_madd_epi16(_mm_unpackhi_epi8(a, z), coef);
+
+			/* sum the pairs: shuffle the odd dwords down and add */
+			a = _mm_add_epi32(
+				_mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), 0x88)),
+				_mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), 0xDD)));
+			a = _mm_srai_epi32(_mm_add_epi32(a, add), 14);
+
+			lo = _mm_madd_epi16(_mm_unpacklo_epi8(b, z), coef);
+			hi = _mm_madd_epi16(_mm_unpackhi_epi8(b, z), coef);
+
+			b = _mm_add_epi32(
+				_mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), 0x88)),
+				_mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), 0xDD)));
+			b = _mm_srai_epi32(_mm_add_epi32(b, add), 14);
+
+			/* eight bytes */
+			a = _mm_packs_epi32(a, b);
+			_mm_storel_epi64((__m128i *)(dst + x), _mm_packus_epi16(a, a));
+		}
+	}
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < w; x++)
+	{
+		p = src[x];
+		v = (cr * (int)((p >> 16) & 0xFF) + cg * (int)((p >> 8) & 0xFF) +
+			cb * (int)(p & 0xFF) + bias) >> 14;
+		dst[x] = (uint8_t)CLAMP(v, 0, 255);
+	}
+}
+
+/*
+ * average argb8888 pixels down to chroma resolution. r1 is the second row
+ * for 4:2:0 and the same as r0 otherwise. the last column and row repeat
+ * for odd sizes
+ */
+static void yuv_row_average(uint32_t *r0, uint32_t *r1, uint32_t *dst, int w,
+	int cw, int layout)
+{
+	/* variables */
+	int i, x0, x1, k;
+	uint32_t p[4];
+	uint32_t r, g, b;
+
+	/* 4:4:4 needs no averaging and never gets here */
+	for (i = 0; i < cw; i++)
+	{
+		x0 = i * 2;
+		x1 = MIN(x0 + 1, w - 1);
+
+		p[0] = r0[x0];
+		p[1] = r0[x1];
+
+		if (layout == YUV_420)
+		{
+			p[2] = r1[x0];
+			p[3] = r1[x1];
+
+			r = g = b = 2;
+			for (k = 0; k < 4; k++)
+			{
+				r += (p[k] >> 16) & 0xFF;
+				g += (p[k] >> 8) & 0xFF;
+				b += p[k] & 0xFF;
+			}
+
+			dst[i] = ((r >> 2) << 16) | ((g >> 2) << 8) | (b >> 2);
+		}
+		else
+		{
+			r = ((p[0] >> 16) & 0xFF) + ((p[1] >> 16) & 0xFF) + 1;
+			g = ((p[0] >> 8) & 0xFF) + ((p[1] >> 8) & 0xFF) + 1;
+			b = (p[0] & 0xFF) + (p[1] & 0xFF) + 1;
+
+			dst[i] = ((r >> 1) << 16) | ((g >> 1) << 8) | (b >> 1);
+		}
+	}
+}
+
+/*
+ * one row of argb8888 pixels from full width y, cb and cr samples. alpha
+ * is set opaque. results are floored with an arithmetic shift on both
+ * paths so they match bit for bit
+ */
+static void yuv_row_rgb(uint8_t *y, uint8_t *cb, uint8_t *cr, uint32_t *dst,
+	int w, const yuv_coef_t *c)
+{
+	/* variables */
+	int x, yy, u, v, r, g, b;
+
+	/* start */
+	x = 0;
+
+#ifdef LIBREX_SSE2
+	{
+		/* variables */
+		__m128i z, ff, yoff, c128, round;
+		__m128i kr, kgu, kgv, kb;
+		__m128i y16, u16, v16, yu, yv, vz;
+		__m128i r32[2], g32[2], b32[2], r8, g8, b8, bg, ra;
+		int k;
+
+		z = _mm_setzero_si128();
+		ff = _mm_set1_epi8((char)0xFF);
+		yoff = _mm_set1_epi16((short)c->yoff);
+		c128 = _mm_set1_epi16(128);
+		round = _mm_set1_epi32(1 << 12);
+
+		/* coefficient pairs, low lane first */
+		kr = _mm_set1_epi32((int)(((uint32_t)c->rv << 16) | (uint32_t)c->iy));
+		kb = _mm_set1_epi32((int)(((uint32_t)c->bu << 16) | (uint32_t)c->iy));
+		kgu = _mm_set1_epi32((int)(((uint32_t)(-c->gu) << 16) | (uint32_t)c->iy));
+		kgv = _mm_set1_epi32(-c->gv & 0xFFFF);
+
+		for (; x + 8 <= w; x += 8)
+		{
+			y16 = _mm_sub_epi16(_mm_unpacklo_epi8(
+				_mm_loadl_epi64((__m128i *)(y + x)), z), yoff);
+			u16 = _mm_sub_epi16(_mm_unpacklo_epi8(
+				_mm_loadl_epi64((__m128i *)(cb + x)), z), c128);
+			v16 = _mm_sub_epi16(_mm_unpacklo_epi8(
+				_mm_loadl_epi64((__m128i *)(cr + x)), z), c128);
+
+			/* four pixels at a time into 32-bit lanes */
+			for (k = 0; k < 2; k++)
+			{
+				if (k == 0)
+				{
+					yu = _mm_unpacklo_epi16(y16, u16);
+					yv = _mm_unpacklo_epi16(y16, v16);
+					vz = _mm_unpacklo_epi16(v16, z);
+				}
+				else
+				{
+					yu = _mm_unpackhi_epi16(y16, u16);
+					yv = _mm_unpackhi_epi16(y16, v16);
+					vz = _mm_unpackhi_epi16(v16, z);
+				}
+
+				r32[k] = _mm_srai_epi32(_mm_add_epi32(
+					_mm_madd_epi16(yv, kr), round), 13);
+				g32[k] = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(
+					_mm_madd_epi16(yu, kgu), _mm_madd_epi16(vz, kgv)), round), 13);
+				b32[k] = _mm_srai_epi32(_mm_add_epi32(
+					_mm_madd_epi16(yu, kb), round), 13);
+			}
+
+			/* saturate down to bytes */
+			r8 = _mm_packs_epi32(r32[0], r32[1]);
+			g8 = _mm_packs_epi32(g32[0], g32[1]);
+			b8 = _mm_packs_epi32(b32[0], b32[1]);
+			r8 = _mm_packus_epi16(r8, r8);
+			g8 = _mm_packus_epi16(g8, g8);
+			b8 = _mm_packus_epi16(b8, b8);
+
+			/* interleave to b, g, r, a in memory */
+			bg = _mm_unpacklo_epi8(b8, g8);
+			ra = _mm_unpacklo_epi8(r8, ff);
+			_mm_storeu_si128((__m128i *)(dst + x), _mm_unpacklo_epi16(bg, ra));
+			_mm_storeu_si128((__m128i *)(dst + x + 4), _mm_unpackhi_epi16(bg, ra));
+		}
+	}
+#endif
+
+	/* scalar path and leftovers */
+	for (; x < w; x++)
+	{
+		yy = ((int)y[x] - c->yoff) * c->iy + (1 << 12) + (512 << 13);
+		u = (int)cb[x] - 128;
+		v = (int)cr[x] - 128;
+
+		r = ((yy + c->rv * v) >> 13) - 512;
+		g = ((yy - c->gu * u - c->gv * v) >> 13) - 512;
+		b = ((yy + c->bu * u) >> 13) - 512;
+
+		dst[x] = 0xFF000000UL | ((uint32_t)CLAMP(r, 0, 255) << 16) |
+			((uint32_t)CLAMP(g, 0, 255) << 8) | (uint32_t)CLAMP(b, 0, 255);
+	}
+}
+
+/*
+ * surface conversion
+ */
+
+/*
+ * convert an argb8888 surface to y, cb and cr planes. the planes are
+ * tightly packed, luma is w by h and chroma is sized by yuv_chroma_size.
+ * subsampled chroma is the box average of the pixels it covers
+ */
+void yuv_from_argb8888(surface_t *src, uint8_t *y, uint8_t *cb, uint8_t *cr,
+	int mode)
+{
+	/* variables */
+	const yuv_coef_t *c;
+	int j, cw, ch, layout, ybias, cbias;
+	uint32_t *r0, *r1, *avg;
+
+	/* sanity checks */
+	if (!src || !src->pixels || src->bpp != 32 || !y || !cb || !cr) return;
+
+	c = YUV_COEF(mode);
+	layout = mode & YUV_LAYOUT_MASK;
+	yuv_chroma_size(src->w, src->h, mode, &cw, &ch);
+
+	ybias = (c->yoff << 14) + (1 << 13);
+	cbias = (128 << 14) + (1 << 13);
+
+	/* luma */
+	for (j = 0; j < src->h; j++)
+	{
+		yuv_row_dot((uint32_t *)SURFACE_PTR(src, 0, j), y + j * src->w,
+			src->w, c->yr, c->yg, c->yb, ybias);
+	}
+
+	/* full resolution chroma reads the surface directly */
+	if (layout == YUV_444)
+	{
+		for (j = 0; j < src->h; j++)
+		{
+			r0 = (uint32_t *)SURFACE_PTR(src, 0, j);
+			yuv_row_dot(r0, cb + j * cw, cw, c->ur, c->ug, c->ub, cbias);
+			yuv_row_dot(r0, cr + j * cw, cw, c->vr, c->vg, c->vb, cbias);
+		}
+
+		return;
+	}
+
+	/* subsampled chroma goes through one averaged row */
+	avg = (uint32_t *)LIBREX_MALLOC(cw * sizeof(uint32_t));
+	if (!avg) return;
+
+	for (j = 0; j < ch; j++)
+	{
+		if (layout == YUV_420)
+		{
+			r0 = (uint32_t *)SURFACE_PTR(src, 0, j * 2);
+			r1 = (uint32_t *)SURFACE_PTR(src, 0, MIN(j * 2 + 1, src->h - 1));
+		}
+		else
+		{
+			r0 = r1 = (uint32_t *)SURFACE_PTR(src, 0, j);
+		}
+
+		yuv_row_average(r0, r1, avg, src->w, cw, layout);
+		yuv_row_dot(avg, cb + j * cw, cw, c->ur, c->ug, c->ub, cbias);
+		yuv_row_dot(avg, cr + j * cw, cw, c->vr, c->vg, c->vb, cbias);
+	}
+
+	LIBREX_FREE(avg);
+}
+
+/*
+ * convert y, cb and cr planes laid out as for yuv_from_argb8888 back into
+ * an argb8888 surface of the same size. subsampled chroma is replicated
+ */
+void yuv_to_argb8888(uint8_t *y, uint8_t *cb, uint8_t *cr, surface_t *dst,
+	int mode)
+{
+	/* variables */
+	const yuv_coef_t *c;
+	int i, j, cw, layout;
+	uint8_t *row, *ucb, *ucr, *scb, *scr;
+
+	/* sanity checks */
+	if (!dst || !dst->pixels || dst->bpp != 32 || !y || !cb || !cr) return;
+	if (!surface_detach(dst)) return;
+
+	c = YUV_COEF(mode);
+	layout = mode & YUV_LAYOUT_MASK;
+	yuv_chroma_size(dst->w, dst->h, mode, &cw, NULL);
+
+	/* 4:4:4 rows are used in place */
+	if (layout == YUV_444)
+	{
+		for (j = 0; j < dst->h; j++)
+		{
+			yuv_row_rgb(y + j * dst->w, cb + j * cw, cr + j * cw,
+				(uint32_t *)SURFACE_PTR(dst, 0, j), dst->w, c);
+		}
+
+		return;
+	}
+
+	/* widen subsampled chroma rows first */
+	row = (uint8_t *)LIBREX_MALLOC(dst->w * 2);
+	if (!row) return;
+
+	ucb = row;
+	ucr = row + dst->w;
+
+	for (j = 0; j < dst->h; j++)
+	{
+		scb = cb + (layout == YUV_420 ? j / 2 : j) * cw;
+		scr = cr + (layout == YUV_420 ? j / 2 : j) * cw;
+
+		/* the second row of a 4:2:0 pair reuses the widened chroma */
+		if (layout != YUV_420 || !(j & 1))
+		{
+			for (i = 0; i < dst->w; i++)
+			{
+				ucb[i] = scb[i >> 1];
+				ucr[i] = scr[i >> 1];
+			}
+		}
+
+		yuv_row_rgb(y + j * dst->w, ucb, ucr,
+			(uint32_t *)SURFACE_PTR(dst, 0, j), dst->w, c);
+	}
+
+	LIBREX_FREE(row);
+}
+
+/*
+ * hsv
+ */
+
+/*
+ * convert n argb8888 pixels to hue, saturation and value. hue has six
+ * sectors of 256 steps starting at red, saturation and value are 0..255.
+ * grays get a hue of 0
+ */
+void hsv_from_argb8888(uint32_t *src, uint16_t *h, uint8_t *s, uint8_t *v,
+	int n)
+{
+	/* variables */
+	int i, r, g, b, max, min, d, hue;
+
+	/* sanity checks */
+	if (!src || !h || !s || !v) return;
+
+	for (i = 0; i < n; i++)
+	{
+		r = (int)((src[i] >> 16) & 0xFF);
+		g = (int)((src[i] >> 8) & 0xFF);
+		b = (int)(src[i] & 0xFF);
+
+		max = MAX(r, MAX(g, b));
+		min = MIN(r, MIN(g, b));
+		d = max - min;
+
+		v[i] = (uint8_t)max;
+
+		if (d == 0)
+		{
+			s[i] = 0;
+			h[i] = 0;
+			continue;
+		}
+
+		s[i] = (uint8_t)((d * 255 + max / 2) / max);
+
+		/* position within the sector, rounded towards the nearest step */
+		if (max == r)
+		{
+			hue = g >= b ? ((g - b) * 256 + d / 2) / d :
+				HSV_HUE_MAX - ((b - g) * 256 + d / 2) / d;
+		}
+		else if (max == g)
+		{
+			hue = b >= r ? 512 + ((b - r) * 256 + d / 2) / d :
+				512 - ((r - b) * 256 + d / 2) / d;
+		}
+		else
+		{
+			hue = r >= g ? 1024 + ((r - g) * 256 + d / 2) / d :
+				1024 - ((g - r) * 256 + d / 2) / d;
+		}
+
+		h[i] = (uint16_t)(hue % HSV_HUE_MAX);
+	}
+}
+
+/*
+ * convert n hue, saturation and value triplets to argb8888. the alpha byte
+ * already in dst is kept, so a surface can be converted and written back
+ * in place
+ */
+void hsv_to_argb8888(uint16_t *h, uint8_t *s, uint8_t *v, uint32_t *dst,
+	int n)
+{
+	/* variables */
+	int i, hue, f, sat, val, p, q, t, r, g, b;
+
+	/* sanity checks */
+	if (!h || !s || !v || !dst) return;
+
+	for (i = 0; i < n; i++)
+	{
+		hue = h[i] % HSV_HUE_MAX;
+		sat = s[i];
+		val = v[i];
+		f = hue & 0xFF;
+
+		/* (x + 128) * 257 >> 16 is x / 255 rounded for 0..65025 */
+		p = ((val * (255 - sat) + 128) * 257) >> 16;
+		q = ((val * (255 - ((sat * f + 128) * 257 >> 16)) + 128) * 257) >> 16;
+		t = ((val * (255 - ((sat * (255 - f) + 128) * 257 >> 16)) + 128) * 257) >> 16;
+
+		switch (hue >> 8)
+		{
+			case 0: r = val; g = t; b = p; break;
+			case 1: r = q; g = val; b = p; break;
+			case 2: r = p; g = val; b = t; break;
+			case 3: r = p; g = q; b = val; break;
+			case 4: r = t; g = p; b = val; break;
+			default: r = val; g = p; b = q; break;
+		}
+
+		dst[i] = (dst[i] & 0xFF000000UL) | ((uint32_t)r << 16) |
+			((uint32_t)g << 8) | (uint32_t)b;
+	}
+}
+
+/* pixels converted per pass by hsv_adjust */
+#define HSV_CHUNK 256
+
+/*
+ * color grade the clip rectangle of an argb8888 surface in hsv space. hue
+ * is added in HSV_HUE_MAX units, sat and val are 8.8 fixed point scales
+ * where 256 leaves the channel unchanged
+ */
+void hsv_adjust(surface_t *dst, int hue, int sat, int val)
+{
+	/* variables */
+	uint16_t h[HSV_CHUNK];
+	uint8_t s[HSV_CHUNK], v[HSV_CHUNK];
+	uint32_t *row;
+	int x, y, i, n, k;
+
+	/* sanity checks */
+	if (!dst || !dst->pixels || dst->bpp != 32) return;
+	if (sat < 0 || val < 0) return;
+	if (!surface_detach(dst)) return;
+
+	/* bring the shift into range once */
+	hue %= HSV_HUE_MAX;
+	if (hue < 0) hue += HSV_HUE_MAX;
+
+	for (y = dst->clip.y1; y < dst->clip.y2; y++)
+	{
+		row = (uint32_t *)SURFACE_PTR(dst, 0, y);
+
+		for (x = dst->clip.x1; x < dst->clip.x2; x += n)
+		{
+			n = MIN(HSV_CHUNK, dst->clip.x2 - x);
+
+			hsv_from_argb8888(row + x, h, s, v, n);
+
+			for (i = 0; i < n; i++)
+			{
+				k = h[i] + hue;
+				h[i] = (uint16_t)(k >= HSV_HUE_MAX ? k - HSV_HUE_MAX : k);
+
+				k = (s[i] * sat + 128) >> 8;
+				s[i] = (uint8_t)MIN(k, 255);
+
+				k = (v[i] * val + 128) >> 8;
+				v[i] = (uint8_t)MIN(k, 255);
+			}
+
+			hsv_to_argb8888(h, s, v, row + x, n);
+		}
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LIBREX_YUV_H__ */